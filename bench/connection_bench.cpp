@@ -0,0 +1,42 @@
+#include <benchmark/benchmark.h>
+#include <spire/net/connection.hpp>
+
+using namespace spire;
+
+// Ping round trips between two connections over the loopback interface
+static void connection_round_trip(benchmark::State& state) {
+    boost::asio::io_context io_context {1};
+
+    boost::asio::ip::tcp::acceptor acceptor {io_context, {boost::asio::ip::address_v4::loopback(), 0}};
+    net::TcpSocket client_socket {io_context};
+    client_socket.connect(acceptor.local_endpoint());
+    net::TcpSocket server_socket {acceptor.accept()};
+    client_socket.set_option(boost::asio::ip::tcp::no_delay(true));
+    server_socket.set_option(boost::asio::ip::tcp::no_delay(true));
+
+    net::Connection<net::TcpSocket> client {std::move(client_socket)};
+    net::Connection<net::TcpSocket> server {std::move(server_socket)};
+
+    msg::BaseMessage base {};
+    base.set_allocated_ping(new msg::Ping);
+    const auto ping {std::make_shared<net::OutMessage>(base)};
+
+    bool received {false};
+    client.init([](auto) {}, [&](std::vector<std::byte>&&) { received = true; });
+    server.init([](auto) {}, [&](std::vector<std::byte>&&) { server.send(ping); });
+    client.open();
+    server.open();
+
+    for (auto _ : state) {
+        received = false;
+        client.send(ping);
+
+        while (!received)
+            io_context.run_one();
+    }
+
+    client.close(net::Connection<net::TcpSocket>::CloseCode::Normal);
+    server.close(net::Connection<net::TcpSocket>::CloseCode::Normal);
+    io_context.poll();
+}
+BENCHMARK(connection_round_trip)->UseRealTime();
@@ -0,0 +1,45 @@
+#include <benchmark/benchmark.h>
+#include <spire/container/concurrent_queue.hpp>
+#include <spire/core/types.hpp>
+
+#include <memory>
+
+using namespace spire;
+
+static void concurrent_queue_push(benchmark::State& state) {
+    ConcurrentQueue<u64> queue;
+    std::queue<u64> drained;
+
+    for (auto _ : state) {
+        queue.push(u64 {1});
+
+        if (queue.size() >= 1024) {
+            queue.swap(drained);
+            drained = {};
+        }
+    }
+}
+BENCHMARK(concurrent_queue_push);
+
+// Producers push while thread 0 drains by swapping, as room updates do with `Room::_messages`
+static void concurrent_queue_contended(benchmark::State& state) {
+    static ConcurrentQueue<std::unique_ptr<u64>> queue;
+    std::queue<std::unique_ptr<u64>> drained;
+    u64 drained_count {0};
+
+    for (auto _ : state) {
+        if (state.thread_index() == 0) {
+            queue.swap(drained);
+            drained_count += drained.size();
+            drained = {};
+        } else {
+            queue.push(std::make_unique<u64>(1));
+        }
+    }
+
+    if (state.thread_index() == 0) {
+        state.counters["drained"] = benchmark::Counter(static_cast<f64>(drained_count), benchmark::Counter::kIsRate);
+        queue.clear();
+    }
+}
+BENCHMARK(concurrent_queue_contended)->ThreadRange(2, 16)->UseRealTime();
@@ -0,0 +1,109 @@
+#include <benchmark/benchmark.h>
+#include <spire/net/udp_transport.hpp>
+
+#include <random>
+
+using namespace spire;
+
+static void datagram_header_serialize(benchmark::State& state) {
+    std::array<std::byte, net::DatagramHeader::SIZE> buffer {};
+    net::DatagramHeader header {
+        .session_token = 0x0123'4567'89AB'CDEF,
+        .channel = net::DatagramChannel::Movement,
+        .sequence = 0,
+    };
+
+    for (auto _ : state) {
+        ++header.sequence;
+        net::DatagramHeader::serialize(header, buffer);
+        benchmark::DoNotOptimize(buffer);
+    }
+}
+BENCHMARK(datagram_header_serialize);
+
+// Sends movement updates to a transport over loopback, dropping `state.range(0)` percent and swapping neighbours
+// of another `state.range(1)` percent before they leave. Ordering is checked by tests/udp_transport_test.cpp.
+static void udp_transport_lossy_channel(benchmark::State& state) {
+    constexpr u32 UPDATES_PER_ITERATION {256};
+
+    boost::asio::io_context io_context {1};
+    net::UdpTransport transport {io_context.get_executor(), 0};
+    transport.start();
+
+    const auto session {transport.open_session()};
+    u32 last_delivered {0};
+    u64 delivered {0};
+    session->init([&](std::vector<std::byte>&& data) {
+        msg::BaseMessage base {};
+        base.ParseFromArray(data.data(), static_cast<int>(data.size()));
+
+        last_delivered = base.move().tick();
+        ++delivered;
+    });
+
+    boost::asio::ip::udp::socket socket {io_context, {boost::asio::ip::udp::v4(), 0}};
+    const boost::asio::ip::udp::endpoint endpoint {boost::asio::ip::address_v4::loopback(), transport.port()};
+
+    u32 sequence {0};
+    const auto make_datagram {[&](const u32 tick) {
+        msg::BaseMessage base {};
+        base.mutable_move()->set_tick(tick);
+
+        std::vector<std::byte> datagram(net::DatagramHeader::SIZE + base.ByteSizeLong() + net::DATAGRAM_TAG_SIZE);
+        net::DatagramHeader::serialize(
+            net::DatagramHeader {
+                .session_token = session->token(),
+                .channel = net::DatagramChannel::Movement,
+                .sequence = ++sequence,
+            },
+            std::span<std::byte, net::DatagramHeader::SIZE> {datagram.data(), net::DatagramHeader::SIZE});
+        base.SerializeToArray(datagram.data() + net::DatagramHeader::SIZE, static_cast<int>(base.ByteSizeLong()));
+        net::sign_datagram(datagram, session->key());
+        return datagram;
+    }};
+
+    std::minstd_rand random {42};
+    std::uniform_int_distribution percent {0, 99};
+    u32 tick {0};
+    u64 sent {0};
+
+    for (auto _ : state) {
+        std::vector<std::vector<std::byte>> datagrams;
+        for (u32 i {0}; i < UPDATES_PER_ITERATION; ++i) {
+            auto datagram {make_datagram(++tick)};
+            if (percent(random) < state.range(0)) continue;
+
+            datagrams.push_back(std::move(datagram));
+            if (datagrams.size() >= 2 && percent(random) < state.range(1)) {
+                std::swap(datagrams[datagrams.size() - 1], datagrams[datagrams.size() - 2]);
+            }
+        }
+        // The final update is never lost, so the iteration knows when everything has been received
+        datagrams.push_back(make_datagram(++tick));
+
+        // Received in between, a whole iteration at once overflows the default receive buffer of the transport
+        for (size_t i {0}; i < datagrams.size(); ++i) {
+            socket.send_to(boost::asio::buffer(datagrams[i]), endpoint);
+            if (i % 32 == 31) io_context.poll();
+        }
+        sent += datagrams.size();
+
+        // The kernel may still drop under load, which would otherwise wait forever
+        const auto deadline {steady_clock::now() + 1s};
+        while (last_delivered != tick && steady_clock::now() < deadline)
+            io_context.run_one_until(deadline);
+
+        if (last_delivered != tick) {
+            state.SkipWithError("Final update of an iteration was not delivered within 1 s");
+            break;
+        }
+    }
+
+    state.counters["delivered_ratio"] = static_cast<f64>(delivered) / static_cast<f64>(sent);
+    state.SetItemsProcessed(static_cast<i64>(delivered));
+
+    session->close();
+    transport.stop();
+    io_context.poll();
+}
+BENCHMARK(udp_transport_lossy_channel)->Args({0, 0})->Args({5, 5})->Args({20, 20})->UseRealTime();
@@ -0,0 +1,82 @@
+#include <benchmark/benchmark.h>
+#include <spire/net/connection.hpp>
+#include <spire/net/io_backend.hpp>
+
+#include <sys/resource.h>
+
+#include <format>
+
+using namespace spire;
+
+using TcpConnection = net::Connection<net::TcpSocket>;
+
+// Every pair holds two sockets, lift the soft descriptor limit as far as allowed. 10k connections need a hard limit
+// above 20k descriptors, runs below it report the failed size as an error.
+static void raise_descriptor_limit() {
+    rlimit limit {};
+    if (getrlimit(RLIMIT_NOFILE, &limit) != 0) return;
+
+    limit.rlim_cur = limit.rlim_max;
+    setrlimit(RLIMIT_NOFILE, &limit);
+}
+
+// Broadcasts a state update from the server end of `state.range(0)` loopback TCP connections
+// and waits until every client end received it. Compare with spire_bench_io_uring of a `SPIRE_USE_IO_URING` build.
+static void connection_fan_out(benchmark::State& state) {
+    raise_descriptor_limit();
+
+    const auto connection_count {static_cast<size_t>(state.range(0))};
+    boost::asio::io_context io_context {1};
+    boost::asio::ip::tcp::acceptor acceptor {io_context, {boost::asio::ip::address_v4::loopback(), 0}};
+    acceptor.listen(boost::asio::socket_base::max_listen_connections);
+
+    std::vector<std::unique_ptr<TcpConnection>> servers;
+    std::vector<std::unique_ptr<TcpConnection>> clients;
+    servers.reserve(connection_count);
+    clients.reserve(connection_count);
+
+    size_t received {0};
+    try {
+        for (size_t i {0}; i < connection_count; ++i) {
+            net::TcpSocket client_socket {io_context};
+            client_socket.connect(acceptor.local_endpoint());
+            net::TcpSocket server_socket {acceptor.accept()};
+            client_socket.set_option(boost::asio::ip::tcp::no_delay(true));
+            server_socket.set_option(boost::asio::ip::tcp::no_delay(true));
+
+            auto& server {servers.emplace_back(std::make_unique<TcpConnection>(std::move(server_socket)))};
+            auto& client {clients.emplace_back(std::make_unique<TcpConnection>(std::move(client_socket)))};
+            server->init([](auto) {}, [](std::vector<std::byte>&&) {});
+            client->init([](auto) {}, [&](std::vector<std::byte>&&) { ++received; });
+            server->open();
+            client->open();
+        }
+    } catch (const boost::system::system_error& e) {
+        state.SkipWithError(std::format("Could not open {} connections: {}", connection_count, e.what()));
+        return;
+    }
+
+    msg::BaseMessage base {};
+    base.mutable_move()->set_tick(1);
+    base.mutable_move()->set_direction_x(1.0f);
+    const auto message {std::make_shared<net::OutMessage>(base)};
+
+    for (auto _ : state) {
+        received = 0;
+        for (const auto& server : servers)
+            server->send(message);
+
+        while (received != connection_count)
+            io_context.run_one();
+    }
+
+    state.SetLabel(std::string {net::io_backend_name()});
+    state.SetItemsProcessed(static_cast<i64>(state.iterations() * connection_count));
+
+    for (const auto& client : clients)
+        client->close(TcpConnection::CloseCode::Normal);
+    for (const auto& server : servers)
+        server->close(TcpConnection::CloseCode::Normal);
+    io_context.poll();
+}
+BENCHMARK(connection_fan_out)->Arg(1'000)->Arg(10'000)->Arg(20'000)->Unit(benchmark::kMillisecond)->UseRealTime();
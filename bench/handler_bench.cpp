@@ -0,0 +1,78 @@
+#include <benchmark/benchmark.h>
+#include <spire/handler/handler_controller.hpp>
+
+#include <optional>
+
+using namespace spire;
+
+struct BenchClient {
+    enum class StopCode : u8 {
+        Normal,
+        InvalidInMessage
+    };
+
+    void stop(StopCode) {}
+};
+
+static std::vector<std::byte> serialize(const msg::BaseMessage& base) {
+    std::vector<std::byte> data(base.ByteSizeLong());
+    base.SerializeToArray(data.data(), static_cast<int>(data.size()));
+    return data;
+}
+
+// Dispatch through `state.range(0)` handlers where only the last one handles the message
+static void handler_controller_handle(benchmark::State& state) {
+    HandlerController<BenchClient> controller;
+    for (i64 i {1}; i < state.range(0); ++i) {
+        controller.add_handler([](const std::shared_ptr<BenchClient>&, const msg::BaseMessage& base) {
+            return base.has_login() ? HandlerResult::Break : HandlerResult::Continue;
+        });
+    }
+    controller.add_handler([](const std::shared_ptr<BenchClient>&, const msg::BaseMessage& base) {
+        benchmark::DoNotOptimize(base.has_ping());
+        return HandlerResult::Break;
+    });
+
+    msg::BaseMessage base {};
+    base.set_allocated_ping(new msg::Ping);
+    const auto data {serialize(base)};
+    const auto client {std::make_shared<BenchClient>()};
+
+    for (auto _ : state) {
+        auto message {std::make_unique<net::InMessage>(std::vector {data})};
+        benchmark::DoNotOptimize(controller.handle(client, std::move(message)));
+    }
+}
+BENCHMARK(handler_controller_handle)->RangeMultiplier(2)->Range(1, 16);
+
+// Parses a message with strings, arg 0 on the global allocator as outside a room, arg 1 into a `TickArena`
+// reset every 64 messages as a room tick would
+static void handler_controller_parse(benchmark::State& state) {
+    HandlerController<BenchClient> controller;
+    controller.add_handler([](const std::shared_ptr<BenchClient>&, const msg::BaseMessage& base) {
+        benchmark::DoNotOptimize(base.admin_command().arguments_size());
+        return HandlerResult::Break;
+    });
+
+    msg::BaseMessage base {};
+    auto* command {base.mutable_admin_command()};
+    command->set_command("clients");
+    for (const auto* argument : {"waiting:0", "a longer argument than fits inline in a string"})
+        command->add_arguments(argument);
+    const auto data {serialize(base)};
+    const auto client {std::make_shared<BenchClient>()};
+
+    TickArena arena {64 * 1024, 64 * 1024};
+    std::optional<TickArena::Scope> scope {};
+    u64 count {0};
+    for (auto _ : state) {
+        if (state.range(0) == 1 && count++ % 64 == 0) {
+            scope.reset();
+            scope.emplace(arena);
+        }
+
+        auto message {std::make_unique<net::InMessage>(std::vector {data})};
+        benchmark::DoNotOptimize(controller.handle(client, std::move(message)));
+    }
+}
+BENCHMARK(handler_controller_parse)->Arg(0)->Arg(1);
@@ -0,0 +1,144 @@
+#include <benchmark/benchmark.h>
+#include <spire/net/connection.hpp>
+#include <spire/net/loopback_stream.hpp>
+#include <spire/server/room.hpp>
+
+using namespace spire;
+
+using LoopbackConnection = net::Connection<net::LoopbackStream>;
+
+static std::shared_ptr<net::OutMessage> make_ping() {
+    msg::BaseMessage base {};
+    base.set_allocated_ping(new msg::Ping);
+    return std::make_shared<net::OutMessage>(base);
+}
+
+// Ping round trips between two connections over an in-memory link, `connection_round_trip` without the kernel
+static void loopback_round_trip(benchmark::State& state) {
+    boost::asio::io_context io_context {1};
+    auto [client_stream, server_stream] {net::LoopbackStream::make_pair(io_context.get_executor())};
+
+    LoopbackConnection client {std::move(client_stream)};
+    LoopbackConnection server {std::move(server_stream)};
+    const auto ping {make_ping()};
+
+    bool received {false};
+    client.init([](auto) {}, [&](std::vector<std::byte>&&) { received = true; });
+    server.init([](auto) {}, [&](std::vector<std::byte>&&) { server.send(ping); });
+    client.open();
+    server.open();
+
+    for (auto _ : state) {
+        received = false;
+        client.send(ping);
+
+        while (!received)
+            io_context.run_one();
+    }
+
+    client.close(LoopbackConnection::CloseCode::Normal);
+    server.close(LoopbackConnection::CloseCode::Normal);
+}
+BENCHMARK(loopback_round_trip);
+
+// Round trips over a link with injected latency and bandwidth under virtual time.
+// Reports the simulated round trip, which is deterministic, next to the real cost of simulating it.
+static void loopback_virtual_link(benchmark::State& state) {
+    Clock::use_virtual_time();
+
+    boost::asio::io_context io_context {1};
+    auto [client_stream, server_stream] {net::LoopbackStream::make_pair(
+        io_context.get_executor(),
+        net::LoopbackLink {.latency = milliseconds {state.range(0)}, .bandwidth = 128 * 1024})};
+
+    LoopbackConnection client {std::move(client_stream)};
+    LoopbackConnection server {std::move(server_stream)};
+    const auto ping {make_ping()};
+
+    bool received {false};
+    client.init([](auto) {}, [&](std::vector<std::byte>&&) { received = true; });
+    server.init([](auto) {}, [&](std::vector<std::byte>&&) { server.send(ping); });
+    client.open();
+    server.open();
+
+    Clock::duration virtual_total {};
+    for (auto _ : state) {
+        received = false;
+        const auto start {Clock::now()};
+        client.send(ping);
+
+        while (!received) {
+            if (io_context.run_one_for(VIRTUAL_TIME_POLL_INTERVAL) == 0) {
+                Clock::advance(VIRTUAL_TIME_POLL_INTERVAL);
+            }
+        }
+        virtual_total += Clock::now() - start;
+    }
+
+    state.counters["virtual_rtt_ms"] = duration<f64, std::milli> {virtual_total}.count()
+        / static_cast<f64>(state.iterations());
+
+    client.close(LoopbackConnection::CloseCode::Normal);
+    server.close(LoopbackConnection::CloseCode::Normal);
+    Clock::use_real_time();
+}
+BENCHMARK(loopback_virtual_link)->Arg(20)->Arg(100)->Iterations(10)->Unit(benchmark::kMillisecond);
+
+
+// Broadcasts a message from its update whenever requested, remembering when the update issued it
+class TickToWireRoom final : public LoopbackRoom {
+public:
+    explicit TickToWireRoom(boost::asio::any_io_executor& io_executor)
+        : LoopbackRoom {0, "bench", io_executor} {}
+
+    std::atomic<bool> is_requested {false};
+    steady_clock::time_point tick_time {};
+
+private:
+    void update_internal(time_point<steady_clock> /*now*/, f32 /*dt*/) override {
+        if (!is_requested.exchange(false)) return;
+
+        tick_time = steady_clock::now();
+        broadcast_message_deferred(_message);
+    }
+
+    const std::shared_ptr<net::OutMessage> _message {make_ping()};
+};
+
+// Time from the room update issuing a broadcast until its bytes are received by the remote end
+static void loopback_tick_to_wire(benchmark::State& state) {
+    boost::asio::io_context io_context {1};
+    boost::asio::any_io_executor executor {io_context.get_executor()};
+    auto [server_stream, client_stream] {net::LoopbackStream::make_pair(executor)};
+
+    const auto room {std::make_shared<TickToWireRoom>(executor)};
+    const auto client {net::LoopbackClient::make(std::move(server_stream))};
+    LoopbackConnection remote {std::move(client_stream)};
+
+    bool received {false};
+    steady_clock::time_point receive_time {};
+    remote.init([](auto) {}, [&](std::vector<std::byte>&&) {
+        receive_time = steady_clock::now();
+        received = true;
+    });
+    remote.open();
+
+    client->start();
+    room->add_client_deferred(client);
+
+    for (auto _ : state) {
+        received = false;
+        room->is_requested = true;
+
+        while (!received)
+            io_context.run_one();
+
+        state.SetIterationTime(duration<f64> {receive_time - room->tick_time}.count());
+    }
+
+    client->stop(net::LoopbackClient::StopCode::Normal);
+    room->terminate();
+    remote.close(LoopbackConnection::CloseCode::Normal);
+    io_context.poll();
+}
+BENCHMARK(loopback_tick_to_wire)->UseManualTime();
@@ -0,0 +1,110 @@
+#include <benchmark/benchmark.h>
+#include <spire/core/compression.hpp>
+#include <spire/net/message.hpp>
+
+#include <format>
+#include <memory>
+#include <utility>
+#include <vector>
+
+using namespace spire;
+
+static void message_header_serialize(benchmark::State& state) {
+    std::array<std::byte, net::MessageHeader::SIZE> buffer {};
+    u16 body_size {0};
+
+    for (auto _ : state) {
+        net::MessageHeader::serialize(net::MessageHeader {.body_size = body_size++}, buffer);
+        benchmark::DoNotOptimize(buffer);
+    }
+}
+BENCHMARK(message_header_serialize);
+
+static void message_header_deserialize(benchmark::State& state) {
+    std::array<std::byte, net::MessageHeader::SIZE> buffer {};
+    net::MessageHeader::serialize(net::MessageHeader {.body_size = 1234}, buffer);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(buffer);
+        auto [body_size] {net::MessageHeader::deserialize(buffer)};
+        benchmark::DoNotOptimize(body_size);
+    }
+}
+BENCHMARK(message_header_deserialize);
+
+static void out_message_ping(benchmark::State& state) {
+    msg::BaseMessage base {};
+    base.set_allocated_ping(new msg::Ping);
+
+    for (auto _ : state) {
+        net::OutMessage message {base};
+        benchmark::DoNotOptimize(message.span().data());
+    }
+}
+BENCHMARK(out_message_ping);
+
+static void out_message_login(benchmark::State& state) {
+    auto* login {new msg::Login};
+    login->set_token(std::string(state.range(0), 'x'));
+    login->set_account_id(1);
+    login->set_character_id(1);
+
+    msg::BaseMessage base {};
+    base.set_allocated_login(login);
+
+    for (auto _ : state) {
+        net::OutMessage message {base};
+        benchmark::DoNotOptimize(message.span().data());
+    }
+    state.SetBytesProcessed(static_cast<i64>(state.iterations() * base.ByteSizeLong()));
+}
+BENCHMARK(out_message_login)->Range(64, 32 * 1024);
+
+// Metrics text stands in for the large, repetitive payloads compression is meant for
+static void out_message_compressed(benchmark::State& state) {
+    std::string output;
+    for (size_t i {0}; output.size() < static_cast<size_t>(state.range(1)); ++i) {
+        output += std::format("spire_room_tick_duration_seconds_bucket{{room=\"{}\",le=\"0.005\"}} {}\n", i % 16, i);
+    }
+
+    auto* admin_result {new msg::AdminResult};
+    admin_result->set_success(true);
+    admin_result->set_output(std::move(output));
+
+    msg::BaseMessage base {};
+    base.set_allocated_admin_result(admin_result);
+
+    Compression::configure(static_cast<Codec>(state.range(0)), 3);
+    size_t frame_size {0};
+    for (auto _ : state) {
+        net::OutMessage message {base};
+        frame_size = message.span().size();
+        benchmark::DoNotOptimize(message.span().data());
+    }
+    Compression::configure(Codec::None, 3);
+
+    state.SetBytesProcessed(static_cast<i64>(state.iterations() * base.ByteSizeLong()));
+    state.counters["ratio"] = static_cast<double>(base.ByteSizeLong()) / static_cast<double>(frame_size);
+}
+BENCHMARK(out_message_compressed)
+    ->ArgsProduct({
+        {std::to_underlying(Codec::None), std::to_underlying(Codec::Lz4), std::to_underlying(Codec::Zstd)},
+        {4 * 1024, 256 * 1024},
+    });
+
+static void out_message_batch(benchmark::State& state) {
+    msg::BaseMessage base {};
+    base.set_allocated_ping(new msg::Ping);
+
+    std::vector<std::shared_ptr<net::OutMessage>> messages;
+    for (i64 i {0}; i < state.range(0); ++i) {
+        messages.push_back(std::make_shared<net::OutMessage>(base));
+    }
+
+    for (auto _ : state) {
+        net::OutMessage message {messages, state.range(1) != 0};
+        benchmark::DoNotOptimize(message.span().data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(out_message_batch)->ArgsProduct({{2, 16, 64}, {0, 1}});
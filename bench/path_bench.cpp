@@ -0,0 +1,65 @@
+#include <benchmark/benchmark.h>
+#include <spire/system/path_service.hpp>
+
+#include <latch>
+#include <random>
+
+using namespace spire;
+
+static constexpr u32 GRID_SIZE {256};
+
+// Open terrain with a fifth of the cells blocked, like scattered rocks and trees
+static std::shared_ptr<const nav::NavGrid> make_grid() {
+    std::minstd_rand random {42};
+    std::bernoulli_distribution is_blocked {0.2};
+
+    std::vector<u8> walkable(GRID_SIZE * GRID_SIZE);
+    for (auto& cell : walkable)
+        cell = is_blocked(random) ? 0 : 1;
+
+    return std::make_shared<const nav::NavGrid>(GRID_SIZE, GRID_SIZE, glm::vec3 {}, 1.0f, std::move(walkable));
+}
+
+// A tick worth of monsters asking for a path towards one of a few players at once.
+// Arg 0 is the number of queries, arg 1 the number of distinct goals they share.
+static void path_service_batch(benchmark::State& state) {
+    const auto grid {make_grid()};
+    tf::Executor executor {1};
+    const auto query_count {static_cast<size_t>(state.range(0))};
+    const auto goal_count {static_cast<size_t>(state.range(1))};
+
+    std::minstd_rand random {7};
+    std::uniform_real_distribution position {0.0f, static_cast<f32>(GRID_SIZE)};
+    std::vector<glm::vec3> goals(goal_count);
+    std::vector<glm::vec3> starts(query_count);
+
+    size_t found {0};
+    for (auto _ : state) {
+        // Players move between ticks, which leaves the cache of the previous tick useless
+        state.PauseTiming();
+        for (auto& goal : goals)
+            goal = glm::vec3 {position(random), 0.0f, position(random)};
+        for (auto& start : starts)
+            start = glm::vec3 {position(random), 0.0f, position(random)};
+        auto service {std::make_shared<nav::PathService>(grid, executor, [](Task&& task) { task(); }, "bench")};
+        state.ResumeTiming();
+
+        std::latch done {static_cast<std::ptrdiff_t>(query_count)};
+        for (size_t i {0}; i < query_count; ++i) {
+            service->find_path(starts[i], goals[i % goal_count], [&found, &done](std::optional<nav::Path>&& path) {
+                found += path.has_value();
+                done.count_down();
+            });
+        }
+        done.wait();
+    }
+
+    state.counters["found"] = static_cast<f64>(found) / static_cast<f64>(state.iterations() * query_count);
+    state.SetItemsProcessed(static_cast<i64>(state.iterations() * query_count));
+}
+BENCHMARK(path_service_batch)
+    ->Args({100, 100})
+    ->Args({100, 4})
+    ->Args({1'000, 4})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
@@ -0,0 +1,26 @@
+#include <benchmark/benchmark.h>
+#include <spire/system/physics_system.hpp>
+
+#include <random>
+
+using namespace spire;
+
+static void physics_system_update(benchmark::State& state) {
+    entt::registry registry;
+    std::minstd_rand random {42};
+    std::uniform_real_distribution distribution {-100.0f, 100.0f};
+
+    for (i64 i {0}; i < state.range(0); ++i) {
+        const auto entity {registry.create()};
+        registry.emplace<Transform>(entity, glm::vec3 {distribution(random), 0.0f, distribution(random)}, 0.0f);
+        registry.emplace<DynamicPhysics>(
+            entity, glm::vec3 {distribution(random), 0.0f, distribution(random)}, Acceleration {0.0f});
+    }
+
+    for (auto _ : state) {
+        physics::PhysicsSystem::update(registry, 1.0f / 60.0f);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(physics_system_update)->RangeMultiplier(10)->Range(100, 100'000);
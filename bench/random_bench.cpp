@@ -0,0 +1,92 @@
+#include <benchmark/benchmark.h>
+#include <spire/core/random.hpp>
+
+#include <random>
+#include <vector>
+
+using namespace spire;
+
+static constexpr u32 LOOT_TABLE_SIZE {1000};
+
+// Raw 64-bit numbers, one at a time
+static void random_mt19937_64(benchmark::State& state) {
+    std::mt19937_64 random {42};
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(random());
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(random_mt19937_64);
+
+static void random_xoshiro(benchmark::State& state) {
+    Random random {42};
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(random());
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(random_xoshiro);
+
+// Rolls into a loot table one at a time, as a critical hit or an AI decision would
+static void random_roll_mt19937(benchmark::State& state) {
+    std::mt19937 random {42};
+    std::uniform_int_distribution<u32> distribution {0, LOOT_TABLE_SIZE - 1};
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(distribution(random));
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(random_roll_mt19937);
+
+static void random_roll_xoshiro(benchmark::State& state) {
+    Random random {42};
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(random.below(LOOT_TABLE_SIZE));
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(random_roll_xoshiro);
+
+// `range(0)` rolls at once, such as every drop of a defeated group
+static void random_roll_bulk_mt19937(benchmark::State& state) {
+    std::mt19937 random {42};
+    std::uniform_int_distribution<u32> distribution {0, LOOT_TABLE_SIZE - 1};
+    std::vector<u32> rolls(static_cast<size_t>(state.range(0)));
+
+    for (auto _ : state) {
+        for (auto& roll : rolls)
+            roll = distribution(random);
+        benchmark::DoNotOptimize(rolls.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(random_roll_bulk_mt19937)->Arg(64)->Arg(4096);
+
+static void random_roll_bulk_xoshiro(benchmark::State& state) {
+    Random random {42};
+    std::vector<u32> rolls(static_cast<size_t>(state.range(0)));
+
+    for (auto _ : state) {
+        for (auto& roll : rolls)
+            roll = random.below(LOOT_TABLE_SIZE);
+        benchmark::DoNotOptimize(rolls.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(random_roll_bulk_xoshiro)->Arg(64)->Arg(4096);
+
+static void random_roll_bulk_batch(benchmark::State& state) {
+    Random seed {42};
+    RandomBatch random {seed};
+    std::vector<u32> rolls(static_cast<size_t>(state.range(0)));
+
+    for (auto _ : state) {
+        random.fill_below(rolls, LOOT_TABLE_SIZE);
+        benchmark::DoNotOptimize(rolls.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(random_roll_bulk_batch)->Arg(64)->Arg(4096);
@@ -0,0 +1,94 @@
+#include <benchmark/benchmark.h>
+#include <spdlog/spdlog.h>
+#include <spire/net/connection.hpp>
+#include <spire/net/socket_tuning.hpp>
+
+using namespace spire;
+
+static SocketTuning make_tuning(const i64 variant) {
+    SocketTuning tuning {};
+    switch (variant) {
+    case 1:
+        tuning.send_buffer_size = 16 * 1024;
+        tuning.receive_buffer_size = 16 * 1024;
+        break;
+    case 2:
+        tuning.quick_ack = true;
+        break;
+    case 3:
+        tuning.not_sent_low_watermark = 16 * 1024;
+        break;
+    case 4:
+        tuning.busy_poll = 50;
+        break;
+    case 5:
+        tuning.user_timeout = 10s;
+        break;
+    case 6:
+        tuning.defer_accept = 5s;
+        break;
+    default:
+        break;
+    }
+
+    return tuning;
+}
+
+static constexpr std::array VARIANT_NAMES {
+    "baseline", "buffers", "quick_ack", "not_sent_lowat", "busy_poll", "user_timeout", "defer_accept"};
+
+// Tuned options only apply to kernel sockets, so round trips go over the loopback interface rather than
+// through `LoopbackStream`. The second argument is the size of the echoed payload.
+static void socket_tuning_round_trip(benchmark::State& state) {
+    spdlog::set_level(spdlog::level::off);
+    state.SetLabel(VARIANT_NAMES[state.range(0)]);
+
+    boost::asio::io_context io_context {1};
+    const auto tuning {make_tuning(state.range(0))};
+
+    boost::asio::ip::tcp::acceptor acceptor {io_context, {boost::asio::ip::address_v4::loopback(), 0}};
+    net::tune_listener(acceptor, tuning, "bench");
+
+    auto* login {new msg::Login};
+    login->set_token(std::string(state.range(1), 'x'));
+    msg::BaseMessage base {};
+    base.set_allocated_login(login);
+    const auto message {std::make_shared<net::OutMessage>(base)};
+
+    // Deferred accepts only complete once the client sent data, so the first round trip starts before accepting
+    net::TcpSocket client_socket {io_context};
+    client_socket.connect(acceptor.local_endpoint());
+    client_socket.set_option(boost::asio::ip::tcp::no_delay(true));
+    boost::asio::write(client_socket, message->span());
+
+    net::TcpSocket server_socket {acceptor.accept()};
+    server_socket.set_option(boost::asio::ip::tcp::no_delay(true));
+    net::tune_socket(server_socket, tuning);
+
+    net::Connection<net::TcpSocket> client {std::move(client_socket)};
+    net::Connection<net::TcpSocket> server {std::move(server_socket)};
+
+    bool received {false};
+    client.init([](auto) {}, [&](std::vector<std::byte>&&) { received = true; });
+    server.init([](auto) {}, [&](std::vector<std::byte>&&) { server.send(message); });
+    client.open();
+    server.open();
+
+    while (!received)
+        io_context.run_one();
+
+    for (auto _ : state) {
+        received = false;
+        client.send(message);
+
+        while (!received)
+            io_context.run_one();
+    }
+
+    client.close(net::Connection<net::TcpSocket>::CloseCode::Normal);
+    server.close(net::Connection<net::TcpSocket>::CloseCode::Normal);
+    io_context.poll();
+}
+BENCHMARK(socket_tuning_round_trip)
+    ->ArgsProduct({benchmark::CreateDenseRange(0, VARIANT_NAMES.size() - 1, 1), {16, 32 * 1024}})
+    ->UseRealTime();
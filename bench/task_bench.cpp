@@ -0,0 +1,72 @@
+#include <benchmark/benchmark.h>
+#include <spire/container/concurrent_queue.hpp>
+#include <spire/container/task.hpp>
+#include <spire/server/room.hpp>
+
+#include <functional>
+#include <memory>
+
+using namespace spire;
+
+static constexpr size_t TASKS_PER_TICK {1024};
+
+// Pushes and runs tasks capturing what deferred room operations usually do, a client and a message
+template <typename TaskType>
+static void task_queue_round_trip(benchmark::State& state) {
+    ConcurrentQueue<TaskType> queue;
+    std::queue<TaskType> drained;
+    const auto client {std::make_shared<u64>(1)};
+    const auto message {std::make_shared<u64>(2)};
+    u64 sum {0};
+
+    for (auto _ : state) {
+        for (size_t i {0}; i < TASKS_PER_TICK; ++i)
+            queue.push([&sum, client, message] { sum += *client + *message; });
+
+        queue.swap(drained);
+        while (!drained.empty()) {
+            drained.front()();
+            drained.pop();
+        }
+    }
+
+    benchmark::DoNotOptimize(sum);
+    state.SetItemsProcessed(state.iterations() * TASKS_PER_TICK);
+}
+BENCHMARK_TEMPLATE(task_queue_round_trip, std::function<void()>);
+BENCHMARK_TEMPLATE(task_queue_round_trip, Task);
+
+// Posts a tick worth of work to an idle room and runs the update that drains it.
+// Arg 0 posts tasks through `post_task`, arg 1 broadcasts through commands that skip the type erasure of `Task`.
+static void room_tasks_per_tick(benchmark::State& state) {
+    boost::asio::io_context io_context {1};
+    boost::asio::any_io_executor executor {io_context.get_executor()};
+    const auto room {std::make_shared<LoopbackRoom>(0, "bench", executor)};
+
+    msg::BaseMessage base {};
+    base.set_allocated_ping(new msg::Ping);
+    const auto message {std::make_shared<net::OutMessage>(base)};
+    const auto payload {std::make_shared<u64>(1)};
+    u64 sum {0};
+
+    for (auto _ : state) {
+        for (size_t i {0}; i < TASKS_PER_TICK; ++i) {
+            if (state.range(0) == 0) {
+                room->post_task([&sum, payload, message] { sum += *payload + message->size(); });
+            }
+            else {
+                room->broadcast_message_deferred(message);
+            }
+        }
+
+        // Without clients the update drains the queues and stops the room again
+        room->start();
+        io_context.restart();
+        io_context.poll();
+    }
+
+    benchmark::DoNotOptimize(sum);
+    state.SetItemsProcessed(state.iterations() * TASKS_PER_TICK);
+    room->terminate();
+}
+BENCHMARK(room_tasks_per_tick)->Arg(0)->Arg(1);
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <glm/vec3.hpp>
+#include <spire/core/units.hpp>
+
+#include <array>
+
+namespace spire {
+struct InputCommand {
+    // Of the client, which counts its own ticks
+    u32 tick;
+    // On the xz plane, no longer than 1
+    glm::vec3 direction;
+    radian rotation;
+};
+
+
+// Commands of a client indexed by tick in a ring, applied in tick order once per room update. Commands arriving out
+// of order are sorted by their slot, duplicates and those older than the last applied tick are dropped. Ticks are
+// compared by serial number arithmetic (RFC 1982), so that counters of clients may start anywhere and wrap around.
+class InputBuffer final {
+public:
+    static constexpr u32 CAPACITY {32};
+
+    // False if dropped
+    bool push(const InputCommand& command);
+    // Calls `on_command` with every pending command in tick order, later commands for applied ticks are dropped
+    template <typename Callback>
+    void apply(Callback&& on_command);
+
+    u32 last_applied_tick() const { return _last_applied; }
+
+private:
+    static constexpr u32 bit(const u32 tick) { return u32 {1} << (tick % CAPACITY); }
+    // Ticks from `_last_applied` to `tick`, beyond 2^31 if `tick` is not after it
+    u32 distance(const u32 tick) const { return tick - _last_applied; }
+
+    std::array<InputCommand, CAPACITY> _commands {};
+    // Bit `tick % CAPACITY` of commands not applied yet
+    u32 _pending {0};
+    u32 _last_applied {0};
+    u32 _newest {0};
+    bool _is_started {false};
+};
+
+
+inline bool InputBuffer::push(const InputCommand& command) {
+    if (!_is_started) {
+        _last_applied = command.tick - 1;
+        _newest = _last_applied;
+        _is_started = true;
+    }
+
+    const u32 ahead {distance(command.tick)};
+    if (ahead == 0 || ahead >= u32 {1} << 31) return false;
+
+    // A client this far ahead lost its connection for a while, what it sent before is of no use anymore
+    if (ahead > CAPACITY) {
+        _pending = 0;
+        _last_applied = command.tick - 1;
+        _newest = _last_applied;
+    }
+
+    if (_pending & bit(command.tick)) return false;
+
+    _commands[command.tick % CAPACITY] = command;
+    _pending |= bit(command.tick);
+    if (distance(command.tick) > distance(_newest)) _newest = command.tick;
+    return true;
+}
+
+template <typename Callback>
+void InputBuffer::apply(Callback&& on_command) {
+    const u32 count {distance(_newest)};
+    for (u32 offset {1}; _pending != 0 && offset <= count; ++offset) {
+        const u32 tick {_last_applied + offset};
+        if (!(_pending & bit(tick))) continue;
+
+        _pending &= ~bit(tick);
+        on_command(_commands[tick % CAPACITY]);
+    }
+
+    _last_applied = _newest;
+}
+}
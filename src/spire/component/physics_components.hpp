@@ -21,4 +21,38 @@ struct DynamicPhysics {
     glm::vec3 velocity;
     Acceleration acceleration;
 };
+
+// Moved by the commands of a client, see `InputBuffer`
+struct Movement {
+    Speed max_speed;
+};
+
+// Shape centered on `Transform::position`. Capsules stand upright and boxes stay axis-aligned regardless of rotation.
+struct Collider {
+    enum class Shape : u8 {
+        Sphere,
+        Capsule,
+        Box
+    };
+
+    Shape shape;
+    // Of spheres and capsules
+    meter radius;
+    // Of capsules, from the position to the center of either cap
+    meter half_height;
+    // Of boxes
+    glm::vec3 half_extents;
+
+    static Collider sphere(const meter radius) {
+        return Collider {.shape = Shape::Sphere, .radius = radius, .half_height = 0.0f, .half_extents = {}};
+    }
+
+    static Collider capsule(const meter radius, const meter half_height) {
+        return Collider {.shape = Shape::Capsule, .radius = radius, .half_height = half_height, .half_extents = {}};
+    }
+
+    static Collider box(const glm::vec3& half_extents) {
+        return Collider {.shape = Shape::Box, .radius = 0.0f, .half_height = 0.0f, .half_extents = half_extents};
+    }
+};
 }
\ No newline at end of file
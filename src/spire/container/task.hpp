@@ -0,0 +1,115 @@
+#pragma once
+
+#include <spire/core/types.hpp>
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace spire {
+// Move-only `void()` callable. Unlike `std::function`, captures need not be copyable and callables of up to
+// `INLINE_SIZE` bytes, such as a couple of `shared_ptr`s, are stored without allocation.
+class Task final {
+public:
+    static constexpr size_t INLINE_SIZE {64};
+
+    Task() = default;
+    template <typename Callable>
+        requires (!std::is_same_v<std::remove_cvref_t<Callable>, Task> &&
+            std::is_invocable_r_v<void, std::decay_t<Callable>&>)
+    Task(Callable&& callable);
+    ~Task() { reset(); }
+    Task(Task&& other) noexcept;
+    Task& operator=(Task&& other) noexcept;
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    void operator()() { _operations->invoke(_storage); }
+    explicit operator bool() const { return _operations != nullptr; }
+
+private:
+    struct Operations {
+        void (*invoke)(void* storage);
+        // Move constructs into `target` and destroys what is left in `source`
+        void (*relocate)(void* source, void* target) noexcept;
+        void (*destroy)(void* storage) noexcept;
+    };
+
+    template <typename Callable>
+    static constexpr bool IS_INLINE {
+        sizeof(Callable) <= INLINE_SIZE &&
+        alignof(Callable) <= alignof(std::max_align_t) &&
+        std::is_nothrow_move_constructible_v<Callable>};
+
+    template <typename Callable>
+    static constexpr Operations INLINE_OPERATIONS {
+        .invoke = [](void* storage) { (*std::launder(static_cast<Callable*>(storage)))(); },
+        .relocate = [](void* source, void* target) noexcept {
+            auto* callable {std::launder(static_cast<Callable*>(source))};
+            ::new (target) Callable {std::move(*callable)};
+            callable->~Callable();
+        },
+        .destroy = [](void* storage) noexcept { std::launder(static_cast<Callable*>(storage))->~Callable(); },
+    };
+
+    // Larger callables live on the heap, with only the pointer stored inline
+    template <typename Callable>
+    static constexpr Operations HEAP_OPERATIONS {
+        .invoke = [](void* storage) { (**static_cast<Callable**>(storage))(); },
+        .relocate = [](void* source, void* target) noexcept {
+            *static_cast<Callable**>(target) = *static_cast<Callable**>(source);
+        },
+        .destroy = [](void* storage) noexcept { delete *static_cast<Callable**>(storage); },
+    };
+
+    void reset() noexcept;
+
+    alignas(std::max_align_t) std::byte _storage[INLINE_SIZE];
+    const Operations* _operations {nullptr};
+};
+
+
+template <typename Callable>
+    requires (!std::is_same_v<std::remove_cvref_t<Callable>, Task> &&
+        std::is_invocable_r_v<void, std::decay_t<Callable>&>)
+Task::Task(Callable&& callable) {
+    using Stored = std::decay_t<Callable>;
+
+    if constexpr (IS_INLINE<Stored>) {
+        ::new (static_cast<void*>(_storage)) Stored {std::forward<Callable>(callable)};
+        _operations = &INLINE_OPERATIONS<Stored>;
+    }
+    else {
+        *reinterpret_cast<Stored**>(_storage) = new Stored {std::forward<Callable>(callable)};
+        _operations = &HEAP_OPERATIONS<Stored>;
+    }
+}
+
+inline Task::Task(Task&& other) noexcept
+    : _operations {other._operations} {
+    if (!_operations) return;
+
+    _operations->relocate(other._storage, _storage);
+    other._operations = nullptr;
+}
+
+inline Task& Task::operator=(Task&& other) noexcept {
+    if (this == &other) return *this;
+
+    reset();
+    if (!other._operations) return *this;
+
+    _operations = other._operations;
+    _operations->relocate(other._storage, _storage);
+    other._operations = nullptr;
+    return *this;
+}
+
+inline void Task::reset() noexcept {
+    if (!_operations) return;
+
+    _operations->destroy(_storage);
+    _operations = nullptr;
+}
+}
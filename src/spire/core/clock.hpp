@@ -0,0 +1,61 @@
+#pragma once
+
+#include <boost/asio/basic_waitable_timer.hpp>
+#include <spire/core/types.hpp>
+
+#include <algorithm>
+#include <atomic>
+
+namespace spire {
+// Monotonic clock of the simulation. Follows `steady_clock` unless switched to virtual time,
+// in which case time only moves through `advance()` and every timer based on it is deterministic.
+class Clock final {
+public:
+    using rep = steady_clock::rep;
+    using period = steady_clock::period;
+    using duration = steady_clock::duration;
+    using time_point = steady_clock::time_point;
+
+    static constexpr bool is_steady {true};
+
+    static time_point now() {
+        if (!_is_virtual.load(std::memory_order_acquire)) return steady_clock::now();
+        return time_point {duration {_virtual_now.load(std::memory_order_acquire)}};
+    }
+
+    // Freezes the clock at `start`, must be called before any timer is armed
+    static void use_virtual_time(const time_point start = steady_clock::now()) {
+        _virtual_now.store(start.time_since_epoch().count(), std::memory_order_release);
+        _is_virtual.store(true, std::memory_order_release);
+    }
+
+    static void use_real_time() { _is_virtual.store(false, std::memory_order_release); }
+
+    static void advance(const duration value) {
+        _virtual_now.fetch_add(value.count(), std::memory_order_acq_rel);
+    }
+
+    static bool is_virtual() { return _is_virtual.load(std::memory_order_acquire); }
+
+private:
+    inline static std::atomic<bool> _is_virtual {false};
+    inline static std::atomic<rep> _virtual_now {0};
+};
+
+
+// The reactor sleeps for at most this long while the clock is virtual,
+// so timers notice `Clock::advance()` without being woken explicitly.
+static constexpr milliseconds VIRTUAL_TIME_POLL_INTERVAL {1};
+
+struct ClockWaitTraits {
+    static Clock::duration to_wait_duration(const Clock::duration& value) {
+        return Clock::is_virtual() ? std::min<Clock::duration>(value, VIRTUAL_TIME_POLL_INTERVAL) : value;
+    }
+
+    static Clock::duration to_wait_duration(const Clock::time_point& time) {
+        return to_wait_duration(time - Clock::now());
+    }
+};
+
+using ClockTimer = boost::asio::basic_waitable_timer<Clock, ClockWaitTraits>;
+}
@@ -0,0 +1,161 @@
+#include <lz4.h>
+#include <spire/core/compression.hpp>
+#include <spire/core/settings.hpp>
+#include <zstd.h>
+
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+
+namespace spire {
+using CompressionContext = std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)>;
+using DecompressionContext = std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)>;
+using CompressionDictionary = std::unique_ptr<ZSTD_CDict, decltype(&ZSTD_freeCDict)>;
+using DecompressionDictionary = std::unique_ptr<ZSTD_DDict, decltype(&ZSTD_freeDDict)>;
+
+static CompressionDictionary compression_dictionary {nullptr, ZSTD_freeCDict};
+static DecompressionDictionary decompression_dictionary {nullptr, ZSTD_freeDDict};
+
+static ZSTD_CCtx* compression_context() {
+    thread_local CompressionContext context {ZSTD_createCCtx(), ZSTD_freeCCtx};
+    return context.get();
+}
+
+static ZSTD_DCtx* decompression_context() {
+    thread_local DecompressionContext context {ZSTD_createDCtx(), ZSTD_freeDCtx};
+    return context.get();
+}
+
+static Codec parse_codec(const std::string_view name) {
+    if (name == "none") return Codec::None;
+    if (name == "lz4") return Codec::Lz4;
+    if (name == "zstd") return Codec::Zstd;
+
+    throw std::invalid_argument("Unknown compression codec");
+}
+
+void Compression::init() {
+    auto dictionary {Settings::compression_dictionary()};
+    // Relative to the settings file, like the rest of the deployment layout
+    if (!dictionary.empty() && dictionary.is_relative()) {
+        dictionary = std::filesystem::path {SPIRE_SETTINGS_FILE}.parent_path() / dictionary;
+    }
+
+    configure(parse_codec(Settings::compression()), Settings::compression_level(), dictionary);
+}
+
+void Compression::configure(const Codec codec, const i32 level, const std::filesystem::path& dictionary) {
+    _codec = codec;
+    _level = level;
+    _has_dictionary = false;
+    compression_dictionary.reset();
+    decompression_dictionary.reset();
+
+    if (dictionary.empty()) return;
+
+    std::ifstream file {dictionary, std::ios::binary};
+    if (!file.is_open())
+        throw std::invalid_argument("Invalid compression dictionary path");
+
+    const std::vector<char> data {std::istreambuf_iterator<char> {file}, std::istreambuf_iterator<char> {}};
+
+    compression_dictionary.reset(ZSTD_createCDict(data.data(), data.size(), level));
+    decompression_dictionary.reset(ZSTD_createDDict(data.data(), data.size()));
+    if (!compression_dictionary || !decompression_dictionary)
+        throw std::invalid_argument("Invalid compression dictionary");
+
+    _has_dictionary = true;
+}
+
+std::optional<size_t> Compression::compress(const std::span<const std::byte> source, std::vector<std::byte>& target) {
+    const size_t offset {target.size()};
+
+    switch (_codec) {
+    case Codec::None:
+        return std::nullopt;
+
+    case Codec::Lz4: {
+        target.resize(offset + LZ4_compressBound(static_cast<int>(source.size())));
+        const int size {LZ4_compress_default(
+            reinterpret_cast<const char*>(source.data()),
+            reinterpret_cast<char*>(target.data() + offset),
+            static_cast<int>(source.size()),
+            static_cast<int>(target.size() - offset))};
+
+        if (size <= 0 || static_cast<size_t>(size) >= source.size()) {
+            target.resize(offset);
+            return std::nullopt;
+        }
+
+        target.resize(offset + size);
+        return size;
+    }
+
+    case Codec::Zstd: {
+        target.resize(offset + ZSTD_compressBound(source.size()));
+        const size_t size {compression_dictionary
+            ? ZSTD_compress_usingCDict(
+                compression_context(),
+                target.data() + offset, target.size() - offset,
+                source.data(), source.size(),
+                compression_dictionary.get())
+            : ZSTD_compressCCtx(
+                compression_context(),
+                target.data() + offset, target.size() - offset,
+                source.data(), source.size(),
+                _level)};
+
+        if (ZSTD_isError(size) || size >= source.size()) {
+            target.resize(offset);
+            return std::nullopt;
+        }
+
+        target.resize(offset + size);
+        return size;
+    }
+    }
+
+    return std::nullopt;
+}
+
+bool Compression::decompress(
+    const Codec codec,
+    const bool use_dictionary,
+    const std::span<const std::byte> source,
+    const std::span<std::byte> target) {
+    switch (codec) {
+    case Codec::None:
+        return false;
+
+    case Codec::Lz4: {
+        const int size {LZ4_decompress_safe(
+            reinterpret_cast<const char*>(source.data()),
+            reinterpret_cast<char*>(target.data()),
+            static_cast<int>(source.size()),
+            static_cast<int>(target.size()))};
+
+        return size >= 0 && static_cast<size_t>(size) == target.size();
+    }
+
+    case Codec::Zstd: {
+        if (use_dictionary && !decompression_dictionary) return false;
+
+        const size_t size {use_dictionary
+            ? ZSTD_decompress_usingDDict(
+                decompression_context(),
+                target.data(), target.size(),
+                source.data(), source.size(),
+                decompression_dictionary.get())
+            : ZSTD_decompressDCtx(
+                decompression_context(),
+                target.data(), target.size(),
+                source.data(), source.size())};
+
+        return !ZSTD_isError(size) && size == target.size();
+    }
+    }
+
+    return false;
+}
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <spire/core/types.hpp>
+
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace spire {
+enum class Codec : u8 {
+    None,
+    Lz4,
+    Zstd
+};
+
+// Process-wide compression of frame bodies. Configuration must happen before any I/O thread runs;
+// compression and decompression are safe from any thread afterwards.
+class Compression final {
+public:
+    // Configures from `Settings`
+    static void init();
+    // `dictionary` is only used by zstd and may be empty
+    static void configure(Codec codec, i32 level, const std::filesystem::path& dictionary = {});
+
+    static Codec codec() { return _codec; }
+    static bool has_dictionary() { return _has_dictionary; }
+
+    // Compresses `source` with the configured codec and dictionary, appending to `target`.
+    // Returns the compressed size, or empty if compression is disabled or would not shrink `source`.
+    static std::optional<size_t> compress(std::span<const std::byte> source, std::vector<std::byte>& target);
+    // `target` must be exactly the size of the uncompressed data
+    static bool decompress(
+        Codec codec,
+        bool use_dictionary,
+        std::span<const std::byte> source,
+        std::span<std::byte> target);
+
+private:
+    inline static Codec _codec {Codec::None};
+    inline static i32 _level {3};
+    inline static bool _has_dictionary {false};
+};
+}
@@ -0,0 +1,84 @@
+#include <fcntl.h>
+#include <spdlog/spdlog.h>
+#include <spire/core/game_data.hpp>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstring>
+
+namespace spire {
+static constexpr std::array<size_t, std::to_underlying(DataTable::Count)> RECORD_SIZES {
+    sizeof(MonsterData),
+    sizeof(WorldPortal),
+    sizeof(RoomPortal),
+};
+
+static constexpr std::array<size_t, std::to_underlying(DataTable::Count)> RECORD_ALIGNMENTS {
+    alignof(MonsterData),
+    alignof(WorldPortal),
+    alignof(RoomPortal),
+};
+
+std::shared_ptr<const GameData> GameData::map(const std::filesystem::path& path) {
+    const int file {::open(path.c_str(), O_RDONLY | O_CLOEXEC)};
+    if (file < 0) return nullptr;
+
+    struct stat status {};
+    if (::fstat(file, &status) != 0 || static_cast<size_t>(status.st_size) < sizeof(GameDataHeader)) {
+        ::close(file);
+        return nullptr;
+    }
+
+    // The mapping outlives the descriptor
+    const auto size {static_cast<size_t>(status.st_size)};
+    void* const address {::mmap(nullptr, size, PROT_READ, MAP_SHARED, file, 0)};
+    ::close(file);
+    if (address == MAP_FAILED) return nullptr;
+
+    const auto* const bytes {static_cast<const std::byte*>(address)};
+    GameDataHeader header;
+    std::memcpy(&header, bytes, sizeof(header));
+
+    std::shared_ptr<GameData> data {new GameData {address, size, header.revision}};
+    if (header.magic != GameDataHeader::MAGIC || header.format_version != GameDataHeader::FORMAT_VERSION) {
+        return nullptr;
+    }
+    if (sizeof(GameDataHeader) + header.table_count * sizeof(GameDataTable) > size) return nullptr;
+
+    // Only the header and the directory are read, records are paged in by the lookups that need them
+    for (u16 i {0}; i < header.table_count; ++i) {
+        GameDataTable table;
+        std::memcpy(&table, bytes + sizeof(GameDataHeader) + i * sizeof(GameDataTable), sizeof(table));
+
+        const auto index {static_cast<size_t>(std::to_underlying(table.table))};
+        // Tables of a newer converter are skipped, as long as the records known here are unchanged
+        if (index >= data->_tables.size()) continue;
+        if (table.record_size != RECORD_SIZES[index] || table.offset % RECORD_ALIGNMENTS[index] != 0) return nullptr;
+        if (table.offset > size || table.count > (size - table.offset) / table.record_size) return nullptr;
+
+        data->_tables[index] = std::span {bytes + table.offset, table.count * table.record_size};
+    }
+
+    return data;
+}
+
+GameData::GameData(void* const address, const size_t size, const u32 revision)
+    : _address {address}, _size {size}, _revision {revision} {}
+
+GameData::~GameData() {
+    ::munmap(_address, _size);
+}
+
+bool GameData::load(const std::filesystem::path& path) {
+    auto data {map(path)};
+    if (!data) {
+        spdlog::warn("Could not map game data {}", path.string());
+        return false;
+    }
+
+    spdlog::info("Game data {} revision {} loaded", path.string(), data->revision());
+    _current.store(std::move(data));
+    return true;
+}
+}
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <boost/core/noncopyable.hpp>
+#include <spire/component/character_components.hpp>
+#include <spire/component/world_components.hpp>
+#include <spire/core/types.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <utility>
+
+namespace spire {
+// Design data of a kind of monster, `Monster::id` refers to it
+struct MonsterData {
+    u64 id;
+    CoreStats stats;
+    u32 health;
+    u32 mana;
+    u32 stamina;
+    // Meters per second
+    f32 speed;
+    u32 experience;
+};
+
+enum class DataTable : u32 {
+    Monsters,
+    WorldPortals,
+    RoomPortals,
+    Count
+};
+
+template <typename Record>
+struct DataTableOf;
+
+template <>
+struct DataTableOf<MonsterData> {
+    static constexpr DataTable value {DataTable::Monsters};
+};
+
+template <>
+struct DataTableOf<WorldPortal> {
+    static constexpr DataTable value {DataTable::WorldPortals};
+};
+
+template <>
+struct DataTableOf<RoomPortal> {
+    static constexpr DataTable value {DataTable::RoomPortals};
+};
+
+// Records are stored as they are laid out in memory, `FORMAT_VERSION` must change with any of them
+static_assert(sizeof(MonsterData) == 48);
+static_assert(sizeof(WorldPortal) == 12);
+static_assert(sizeof(RoomPortal) == 8);
+
+
+// Layout of a data file written by `tools/pack_data`: a header, a `GameDataTable` per table and the tables, each an
+// array of records sorted by id and aligned to `TABLE_ALIGNMENT`. Native byte order, files are built per platform.
+struct GameDataHeader {
+    static constexpr std::array<char, 4> MAGIC {'S', 'P', 'D', 'T'};
+    static constexpr u16 FORMAT_VERSION {1};
+    static constexpr size_t TABLE_ALIGNMENT {64};
+
+    std::array<char, 4> magic;
+    u16 format_version;
+    u16 table_count;
+    // Of the content, set when packing
+    u32 revision;
+    u32 reserved;
+};
+
+struct GameDataTable {
+    DataTable table;
+    u32 record_size;
+    u64 count;
+    // From the start of the file
+    u64 offset;
+};
+
+
+// Static design data mapped read-only from a file packed by `tools/pack_data`. Every room and thread shares the one
+// mapping, lookups search the records in place and nothing is parsed or copied when loading.
+class GameData final : boost::noncopyable {
+public:
+    // Empty if `path` could not be mapped or is not a data file of `GameDataHeader::FORMAT_VERSION`
+    static std::shared_ptr<const GameData> map(const std::filesystem::path& path);
+    ~GameData();
+
+    // Safe to call from any thread. The data is unmapped once the last holder of a replaced one releases it, so
+    // rooms hold it for a whole update.
+    static std::shared_ptr<const GameData> current() { return _current.load(); }
+    // Maps `path` and replaces the current data, which is kept if `path` could not be mapped. A mapped file must not
+    // be written to, a new one is renamed over it as `tools/pack_data` does.
+    static bool load(const std::filesystem::path& path);
+
+    template <typename Record>
+    std::span<const Record> table() const;
+    // Null if there is no record with `id`
+    template <typename Record>
+    const Record* find(u64 id) const;
+
+    u32 revision() const { return _revision; }
+
+private:
+    GameData(void* address, size_t size, u32 revision);
+
+    void* const _address;
+    const size_t _size;
+    const u32 _revision;
+    // Empty for tables missing from the file
+    std::array<std::span<const std::byte>, std::to_underlying(DataTable::Count)> _tables {};
+
+    inline static std::atomic<std::shared_ptr<const GameData>> _current {};
+};
+
+
+template <typename Record>
+std::span<const Record> GameData::table() const {
+    const auto bytes {_tables[std::to_underlying(DataTableOf<Record>::value)]};
+    return std::span {reinterpret_cast<const Record*>(bytes.data()), bytes.size() / sizeof(Record)};
+}
+
+template <typename Record>
+const Record* GameData::find(const u64 id) const {
+    const auto records {table<Record>()};
+    const auto it {std::ranges::lower_bound(records, id, {}, [](const Record& record) { return u64 {record.id}; })};
+    if (it == records.end() || it->id != id) return nullptr;
+
+    return &*it;
+}
+}
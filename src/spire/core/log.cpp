@@ -0,0 +1,65 @@
+#include <spdlog/async.h>
+#include <spire/core/log.hpp>
+#include <spire/core/settings.hpp>
+
+#include <memory>
+
+namespace spire {
+void Log::init() {
+    if (!Settings::log_async()) return;
+
+    spdlog::init_thread_pool(Settings::log_queue_size(), 1);
+    const auto thread_pool {spdlog::thread_pool()};
+
+    // Keeps the sinks and level of the default logger, only where the writing happens changes
+    const auto previous {spdlog::default_logger()};
+    const auto logger {std::make_shared<spdlog::async_logger>(
+        previous->name(),
+        previous->sinks().begin(),
+        previous->sinks().end(),
+        thread_pool,
+        spdlog::async_overflow_policy::overrun_oldest)};
+    logger->set_level(previous->level());
+    // Errors are usually followed by a crash or an exit
+    logger->flush_on(spdlog::level::err);
+    spdlog::set_default_logger(logger);
+
+    metrics::Metrics::counter_callback(
+        "spire_log_dropped_messages_total",
+        "Log messages dropped by a full queue since startup",
+        [thread_pool = std::weak_ptr {thread_pool}] {
+            const auto pool {thread_pool.lock()};
+            return pool ? static_cast<f64>(pool->overrun_counter()) : 0.0;
+        });
+}
+
+void Log::shutdown() {
+    spdlog::shutdown();
+}
+
+
+LogLimiter::LogLimiter(const u32 per_second)
+    : _per_second {per_second},
+    _dropped_total {metrics::Metrics::counter(
+        "spire_log_rate_limited_total", "Log messages dropped by the rate limits of their sites")} {}
+
+std::optional<u64> LogLimiter::acquire() {
+    const i64 now {steady_clock::now().time_since_epoch().count()};
+    const i64 window {duration_cast<steady_clock::duration>(seconds {1}).count()};
+
+    // One thread opens the next window, the others count into it. A message racing the reset may count into either.
+    auto window_start {_window_start.load(std::memory_order_relaxed)};
+    if (now - window_start >= window
+        && _window_start.compare_exchange_strong(window_start, now, std::memory_order_relaxed)) {
+        _window_count.store(0, std::memory_order_relaxed);
+    }
+
+    if (_window_count.fetch_add(1, std::memory_order_relaxed) < _per_second) {
+        return _dropped.exchange(0, std::memory_order_relaxed);
+    }
+
+    _dropped.fetch_add(1, std::memory_order_relaxed);
+    _dropped_total.add();
+    return std::nullopt;
+}
+}
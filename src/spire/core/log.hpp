@@ -0,0 +1,61 @@
+#pragma once
+
+#include <boost/core/noncopyable.hpp>
+#include <spdlog/spdlog.h>
+#include <spire/core/metrics.hpp>
+#include <spire/core/types.hpp>
+
+#include <atomic>
+#include <optional>
+#include <utility>
+
+namespace spire {
+class Log final {
+public:
+    // Routes the default logger through spdlog's thread pool if `Settings::log_async()`. Threads format a message
+    // into a ring of `Settings::log_queue_size()` preallocated slots and go on, the pool writes it. A full ring drops
+    // its oldest message instead of waiting, drops are exported as `spire_log_dropped_messages_total`.
+    static void init();
+    // Writes the messages still queued, logging afterwards is lost
+    static void shutdown();
+};
+
+
+// Lets `per_second` messages of one log site through per second and drops the rest, for warnings that clients can
+// cause at will, such as failed logins or accepts. Shared by the threads logging at the site, usually a static local.
+class LogLimiter final : boost::noncopyable {
+public:
+    explicit LogLimiter(u32 per_second);
+
+    // Messages dropped since the last one let through, empty if this one is dropped as well
+    std::optional<u64> acquire();
+
+    // Followed by the number of messages dropped before it, if any
+    template <typename... Args>
+    void log(spdlog::level::level_enum level, spdlog::format_string_t<Args...> format, Args&&... args);
+
+private:
+    const u32 _per_second;
+    // Of `steady_clock`
+    std::atomic<i64> _window_start {0};
+    std::atomic<u32> _window_count {0};
+    std::atomic<u64> _dropped {0};
+
+    metrics::Counter& _dropped_total;
+};
+
+
+template <typename... Args>
+void LogLimiter::log(
+    const spdlog::level::level_enum level,
+    spdlog::format_string_t<Args...> format,
+    Args&&... args) {
+    if (!spdlog::should_log(level)) return;
+
+    const auto dropped {acquire()};
+    if (!dropped) return;
+
+    spdlog::log(level, format, std::forward<Args>(args)...);
+    if (*dropped > 0) spdlog::log(level, "{} similar messages were dropped", *dropped);
+}
+}
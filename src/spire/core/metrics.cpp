@@ -0,0 +1,193 @@
+#include <spire/core/metrics.hpp>
+
+#include <format>
+#include <stdexcept>
+#include <utility>
+
+namespace spire::metrics {
+size_t shard_index() {
+    static std::atomic<size_t> next_index {0};
+    thread_local const size_t index {next_index.fetch_add(1, std::memory_order_relaxed) % SHARD_COUNT};
+
+    return index;
+}
+
+u64 Counter::value() const {
+    u64 value {0};
+    for (const auto& shard : _shards)
+        value += shard.value.load(std::memory_order_relaxed);
+
+    return value;
+}
+
+u64 Histogram::Snapshot::quantile(const f64 q) const {
+    if (count == 0) return 0;
+
+    const auto rank {static_cast<u64>(std::clamp(q, 0.0, 1.0) * static_cast<f64>(count - 1)) + 1};
+    u64 seen {0};
+    for (size_t i {0}; i < BUCKET_COUNT; ++i) {
+        seen += buckets[i];
+        if (seen >= rank) return bucket_upper_bound(i);
+    }
+
+    return bucket_upper_bound(BUCKET_COUNT - 1);
+}
+
+void Histogram::Snapshot::merge(const Snapshot& other) {
+    for (size_t i {0}; i < BUCKET_COUNT; ++i)
+        buckets[i] += other.buckets[i];
+
+    count += other.count;
+    sum += other.sum;
+}
+
+Histogram::Histogram()
+    : _shards {std::make_unique<std::array<Shard, SHARD_COUNT>>()} {}
+
+Histogram::Snapshot Histogram::snapshot() const {
+    Snapshot snapshot {};
+    for (const auto& shard : *_shards) {
+        for (size_t i {0}; i < BUCKET_COUNT; ++i)
+            snapshot.buckets[i] += shard.buckets[i].load(std::memory_order_relaxed);
+
+        snapshot.count += shard.count.load(std::memory_order_relaxed);
+        snapshot.sum += shard.sum.load(std::memory_order_relaxed);
+    }
+
+    return snapshot;
+}
+
+static std::string format_labels(const Labels& labels) {
+    std::string result;
+    for (const auto& [key, value] : labels) {
+        result += result.empty() ? "{" : ",";
+        result += std::format("{}=\"", key);
+
+        for (const char c : value) {
+            switch (c) {
+            case '\\': result += "\\\\"; break;
+            case '"': result += "\\\""; break;
+            case '\n': result += "\\n"; break;
+            default: result += c; break;
+            }
+        }
+        result += '"';
+    }
+
+    if (!result.empty()) result += '}';
+    return result;
+}
+
+// Inserts `label` into an already formatted label set
+static std::string append_label(const std::string_view labels, const std::string_view label) {
+    if (labels.empty()) return std::format("{{{}}}", label);
+
+    return std::format("{},{}}}", labels.substr(0, labels.size() - 1), label);
+}
+
+Metrics::Family& Metrics::family(const std::string_view name, const std::string_view help, const Type type) {
+    auto it {_families.find(name)};
+    if (it == _families.end()) {
+        it = _families.emplace(std::string {name}, Family {.type = type, .help = std::string {help}}).first;
+    }
+
+    if (it->second.type != type)
+        throw std::invalid_argument(std::format("Metric {} registered with a different type", name));
+
+    return it->second;
+}
+
+Counter& Metrics::counter(const std::string_view name, const std::string_view help, const Labels& labels) {
+    std::lock_guard lock {_mutex};
+
+    auto& metric {family(name, help, Type::Counter).counters[format_labels(labels)]};
+    if (!metric) metric = std::make_unique<Counter>();
+
+    return *metric;
+}
+
+Gauge& Metrics::gauge(const std::string_view name, const std::string_view help, const Labels& labels) {
+    std::lock_guard lock {_mutex};
+
+    auto& metric {family(name, help, Type::Gauge).gauges[format_labels(labels)]};
+    if (!metric) metric = std::make_unique<Gauge>();
+
+    return *metric;
+}
+
+Histogram& Metrics::histogram(
+    const std::string_view name,
+    const std::string_view help,
+    const Labels& labels,
+    const f64 scale) {
+    std::lock_guard lock {_mutex};
+
+    auto& family {Metrics::family(name, help, Type::Summary)};
+    family.scale = scale;
+
+    auto& metric {family.histograms[format_labels(labels)]};
+    if (!metric) metric = std::make_unique<Histogram>();
+
+    return *metric;
+}
+
+void Metrics::gauge_callback(
+    const std::string_view name,
+    const std::string_view help,
+    std::function<f64()>&& callback,
+    const Labels& labels) {
+    std::lock_guard lock {_mutex};
+
+    family(name, help, Type::Gauge).callbacks[format_labels(labels)] = std::move(callback);
+}
+
+void Metrics::counter_callback(
+    const std::string_view name,
+    const std::string_view help,
+    std::function<f64()>&& callback,
+    const Labels& labels) {
+    std::lock_guard lock {_mutex};
+
+    family(name, help, Type::Counter).callbacks[format_labels(labels)] = std::move(callback);
+}
+
+std::string Metrics::export_prometheus() {
+    static constexpr std::array quantiles {0.5, 0.9, 0.99, 0.999};
+
+    std::lock_guard lock {_mutex};
+
+    std::string out;
+    out.reserve(16 * 1024);
+
+    for (const auto& [name, family] : _families) {
+        static constexpr std::array type_names {"counter"sv, "gauge"sv, "summary"sv};
+
+        out += std::format("# HELP {} {}\n", name, family.help);
+        out += std::format("# TYPE {} {}\n", name, type_names[std::to_underlying(family.type)]);
+
+        for (const auto& [labels, counter] : family.counters)
+            out += std::format("{}{} {}\n", name, labels, counter->value());
+
+        for (const auto& [labels, gauge] : family.gauges)
+            out += std::format("{}{} {}\n", name, labels, gauge->value());
+
+        for (const auto& [labels, callback] : family.callbacks)
+            out += std::format("{}{} {}\n", name, labels, callback());
+
+        for (const auto& [labels, histogram] : family.histograms) {
+            const auto snapshot {histogram->snapshot()};
+
+            for (const auto q : quantiles) {
+                out += std::format("{}{} {}\n",
+                    name,
+                    append_label(labels, std::format("quantile=\"{}\"", q)),
+                    static_cast<f64>(snapshot.quantile(q)) * family.scale);
+            }
+            out += std::format("{}_sum{} {}\n", name, labels, static_cast<f64>(snapshot.sum) * family.scale);
+            out += std::format("{}_count{} {}\n", name, labels, snapshot.count);
+        }
+    }
+
+    return out;
+}
+}
@@ -0,0 +1,174 @@
+#pragma once
+
+#include <boost/core/noncopyable.hpp>
+#include <spire/core/types.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace spire::metrics {
+static constexpr size_t SHARD_COUNT {16};
+static constexpr size_t CACHE_LINE_SIZE {64};
+
+// Index of the shard owned by the calling thread
+size_t shard_index();
+
+using Labels = std::vector<std::pair<std::string, std::string>>;
+
+
+class Counter final : boost::noncopyable {
+public:
+    void add(const u64 value = 1) {
+        _shards[shard_index()].value.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    u64 value() const;
+
+private:
+    struct alignas(CACHE_LINE_SIZE) Shard {
+        std::atomic<u64> value {0};
+    };
+
+    std::array<Shard, SHARD_COUNT> _shards {};
+};
+
+
+class Gauge final : boost::noncopyable {
+public:
+    void set(const i64 value) { _value.store(value, std::memory_order_relaxed); }
+    void add(const i64 value) { _value.fetch_add(value, std::memory_order_relaxed); }
+    void sub(const i64 value) { _value.fetch_sub(value, std::memory_order_relaxed); }
+
+    i64 value() const { return _value.load(std::memory_order_relaxed); }
+
+private:
+    alignas(CACHE_LINE_SIZE) std::atomic<i64> _value {0};
+};
+
+
+// Log-linear buckets in the manner of HDR histograms: every power of two is split into
+// `SUB_BUCKET_COUNT` linear buckets, which bounds the relative error to 1 / SUB_BUCKET_COUNT.
+class Histogram final : boost::noncopyable {
+public:
+    static constexpr size_t SUB_BUCKET_BITS {3};
+    static constexpr size_t SUB_BUCKET_COUNT {1 << SUB_BUCKET_BITS};
+    static constexpr size_t BUCKET_COUNT {(64 - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT};
+
+    struct Snapshot {
+        std::array<u64, BUCKET_COUNT> buckets {};
+        u64 count {0};
+        u64 sum {0};
+
+        // Upper bound of the bucket containing the `q` quantile
+        u64 quantile(f64 q) const;
+        f64 mean() const { return count == 0 ? 0.0 : static_cast<f64>(sum) / static_cast<f64>(count); }
+
+        void merge(const Snapshot& other);
+    };
+
+    Histogram();
+
+    void record(const u64 value) {
+        auto& shard {(*_shards)[shard_index()]};
+        shard.buckets[bucket_index(value)].fetch_add(1, std::memory_order_relaxed);
+        shard.count.fetch_add(1, std::memory_order_relaxed);
+        shard.sum.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    void record(const steady_clock::duration duration) {
+        record(static_cast<u64>(std::max(duration_cast<nanoseconds>(duration).count(), nanoseconds::rep {0})));
+    }
+
+    Snapshot snapshot() const;
+
+    static constexpr size_t bucket_index(const u64 value) {
+        if (value < SUB_BUCKET_COUNT) return value;
+
+        const size_t shift {static_cast<size_t>(std::bit_width(value)) - 1 - SUB_BUCKET_BITS};
+        const size_t sub {static_cast<size_t>(value >> shift) - SUB_BUCKET_COUNT};
+        return (shift + 1) * SUB_BUCKET_COUNT + sub;
+    }
+
+    static constexpr u64 bucket_upper_bound(const size_t index) {
+        if (index < SUB_BUCKET_COUNT) return index;
+
+        const size_t shift {index / SUB_BUCKET_COUNT - 1};
+        const u64 lower {static_cast<u64>(SUB_BUCKET_COUNT + index % SUB_BUCKET_COUNT) << shift};
+        return lower + ((u64 {1} << shift) - 1);
+    }
+
+private:
+    struct alignas(CACHE_LINE_SIZE) Shard {
+        std::array<std::atomic<u64>, BUCKET_COUNT> buckets {};
+        std::atomic<u64> count {0};
+        std::atomic<u64> sum {0};
+    };
+
+    std::unique_ptr<std::array<Shard, SHARD_COUNT>> _shards;
+};
+
+
+// Records the elapsed time of a scope into a histogram
+class ScopedTimer final : boost::noncopyable {
+public:
+    explicit ScopedTimer(Histogram& histogram)
+        : _histogram {histogram}, _start {steady_clock::now()} {}
+
+    ~ScopedTimer() { _histogram.record(steady_clock::now() - _start); }
+
+private:
+    Histogram& _histogram;
+    const steady_clock::time_point _start;
+};
+
+
+class Metrics final {
+public:
+    // Metrics live until the end of the process, so returned references never dangle.
+    // Registration takes a lock; callers should keep the reference instead of looking it up per use.
+    static Counter& counter(std::string_view name, std::string_view help, const Labels& labels = {});
+    static Gauge& gauge(std::string_view name, std::string_view help, const Labels& labels = {});
+    // `scale` converts recorded values into the exported unit (e.g. 1e-9 for nanoseconds to seconds)
+    static Histogram& histogram(
+        std::string_view name, std::string_view help, const Labels& labels = {}, f64 scale = 1e-9);
+    // Evaluated on every export
+    static void gauge_callback(
+        std::string_view name, std::string_view help, std::function<f64()>&& callback, const Labels& labels = {});
+    // Evaluated on every export, for totals counted elsewhere that never decrease
+    static void counter_callback(
+        std::string_view name, std::string_view help, std::function<f64()>&& callback, const Labels& labels = {});
+
+    // Prometheus text exposition format 0.0.4
+    static std::string export_prometheus();
+
+private:
+    enum class Type : u8 {
+        Counter,
+        Gauge,
+        Summary
+    };
+
+    struct Family {
+        Type type;
+        std::string help;
+        f64 scale {1.0};
+
+        std::map<std::string, std::unique_ptr<Counter>> counters {};
+        std::map<std::string, std::unique_ptr<Gauge>> gauges {};
+        std::map<std::string, std::unique_ptr<Histogram>> histograms {};
+        std::map<std::string, std::function<f64()>> callbacks {};
+    };
+
+    static Family& family(std::string_view name, std::string_view help, Type type);
+
+    inline static std::mutex _mutex {};
+    inline static std::map<std::string, Family, std::less<>> _families {};
+};
+}
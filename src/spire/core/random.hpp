@@ -1,5 +1,221 @@
 #pragma once
 
+#include <spire/core/types.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <limits>
+#include <random>
+#include <span>
+
 namespace spire {
+// Expands a seed into well mixed values, for the state of `Random` and for seeds derived from a seed and an id
+class SplitMix64 final {
+public:
+    explicit constexpr SplitMix64(const u64 seed)
+        : _state {seed} {}
+
+    constexpr u64 next();
+
+private:
+    u64 _state;
+};
+
+
+// xoshiro256++ by Blackman and Vigna, 32 bytes of state and a few cycles per number. Not thread-safe: every room owns
+// one, so that rooms on different threads never contend for an engine and a room seeded the same draws the same.
+// Works with the distributions of <random>, though the members below are faster for the common cases.
+class Random final {
+public:
+    using result_type = u64;
+
+    explicit constexpr Random(u64 seed);
+    // Sequences for different `stream`s of one seed are unrelated, such as one per room
+    constexpr Random(u64 seed, u64 stream);
+
+    // Seeded by `std::random_device`, for work of the calling thread that is never replayed
+    static Random& for_thread();
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+    constexpr result_type operator()();
+
+    // Uniform in [0, `bound`) without bias, `bound` must not be 0
+    constexpr u32 below(u32 bound);
+    // Uniform in [0, 1)
+    constexpr f32 uniform();
+    constexpr bool chance(f32 probability) { return uniform() < probability; }
+
+private:
+    std::array<u64, 4> _state {};
+};
+
+
+// `LANES` xoshiro128++ generators stepped together for bulk draws, such as rolling a whole loot table at once. Lanes
+// are 32-bit and stored component-wise, so that the compiler vectorizes a step even with the SSE2 of any x86-64.
+// Each lane starts 2^64 numbers after the previous one within the same sequence, so that lanes never overlap.
+class RandomBatch final {
+public:
+    static constexpr size_t LANES {16};
+
+    // Seeded by two numbers drawn from `random`
+    explicit constexpr RandomBatch(Random& random);
+
+    void fill(std::span<u32> values);
+    // Uniform in [0, `bound`) by a multiply and a shift. Biased by less than `bound` / 2^32, which no roll notices.
+    void fill_below(std::span<u32> values, u32 bound);
+    // Uniform in [0, 1)
+    void fill_uniform(std::span<f32> values);
+
+private:
+    using State = std::array<u32, 4>;
+
+    static constexpr u32 next(State& state);
+    // Advances `state` by 2^64 numbers
+    static constexpr void jump(State& state);
+
+    template <typename T, typename Transform>
+    void generate(std::span<T> values, Transform transform);
+
+    // Word by lane
+    std::array<std::array<u32, LANES>, 4> _state {};
+};
+
+
+constexpr u64 SplitMix64::next() {
+    u64 value {_state += 0x9E3779B97F4A7C15};
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EB;
+    return value ^ (value >> 31);
+}
+
+constexpr Random::Random(const u64 seed) {
+    SplitMix64 mix {seed};
+    for (auto& word : _state)
+        word = mix.next();
+}
+
+constexpr Random::Random(const u64 seed, const u64 stream)
+    : Random {seed ^ SplitMix64 {stream}.next()} {}
+
+inline Random& Random::for_thread() {
+    thread_local Random random {(u64 {std::random_device {}()} << 32) | std::random_device {}()};
+    return random;
+}
+
+constexpr Random::result_type Random::operator()() {
+    auto& [s0, s1, s2, s3] = _state;
+    const u64 result {std::rotl(s0 + s3, 23) + s0};
+    const u64 t {s1 << 17};
+
+    s2 ^= s0;
+    s3 ^= s1;
+    s1 ^= s2;
+    s0 ^= s3;
+    s2 ^= t;
+    s3 = std::rotl(s3, 45);
+
+    return result;
+}
+
+constexpr u32 Random::below(const u32 bound) {
+    // Lemire's multiply and shift, drawing again only for the few values that would bias the result
+    u64 product {(operator()() >> 32) * bound};
+    if (static_cast<u32>(product) < bound) {
+        const u32 threshold {-bound % bound};
+        while (static_cast<u32>(product) < threshold)
+            product = (operator()() >> 32) * bound;
+    }
+
+    return static_cast<u32>(product >> 32);
+}
+
+constexpr f32 Random::uniform() {
+    // As many random bits as a float has mantissa
+    return static_cast<f32>(operator()() >> 40) * 0x1.0p-24f;
+}
+
+constexpr RandomBatch::RandomBatch(Random& random) {
+    const u64 low {random()};
+    const u64 high {random()};
+    State state {
+        static_cast<u32>(low),
+        static_cast<u32>(low >> 32),
+        static_cast<u32>(high),
+        static_cast<u32>(high >> 32)};
+
+    for (size_t lane {0}; lane < LANES; ++lane) {
+        for (size_t word {0}; word < state.size(); ++word)
+            _state[word][lane] = state[word];
+        jump(state);
+    }
+}
+
+constexpr u32 RandomBatch::next(State& state) {
+    auto& [s0, s1, s2, s3] = state;
+    const u32 result {std::rotl(s0 + s3, 7) + s0};
+    const u32 t {s1 << 9};
+
+    s2 ^= s0;
+    s3 ^= s1;
+    s1 ^= s2;
+    s0 ^= s3;
+    s2 ^= t;
+    s3 = std::rotl(s3, 11);
+
+    return result;
+}
+
+constexpr void RandomBatch::jump(State& state) {
+    constexpr State JUMP {0x8764000B, 0xF542D2D3, 0x6FA035C3, 0x77F2DB5B};
+
+    State jumped {};
+    for (const u32 word : JUMP) {
+        for (u32 bit {0}; bit < 32; ++bit) {
+            if (word & (u32 {1} << bit)) {
+                for (size_t i {0}; i < jumped.size(); ++i)
+                    jumped[i] ^= state[i];
+            }
+            next(state);
+        }
+    }
+    state = jumped;
+}
+
+template <typename T, typename Transform>
+void RandomBatch::generate(const std::span<T> values, Transform transform) {
+    auto& [s0, s1, s2, s3] = _state;
+    for (size_t offset {0}; offset < values.size(); offset += LANES) {
+        // `next()` of every lane, written out so that it is vectorized across lanes
+        std::array<u32, LANES> block;
+        for (size_t i {0}; i < LANES; ++i) {
+            block[i] = std::rotl(s0[i] + s3[i], 7) + s0[i];
+            const u32 t {s1[i] << 9};
+
+            s2[i] ^= s0[i];
+            s3[i] ^= s1[i];
+            s1[i] ^= s2[i];
+            s0[i] ^= s3[i];
+            s2[i] ^= t;
+            s3[i] = std::rotl(s3[i], 11);
+        }
+
+        const size_t count {std::min(LANES, values.size() - offset)};
+        for (size_t i {0}; i < count; ++i)
+            values[offset + i] = transform(block[i]);
+    }
+}
+
+inline void RandomBatch::fill(const std::span<u32> values) {
+    generate(values, [](const u32 value) { return value; });
+}
+
+inline void RandomBatch::fill_below(const std::span<u32> values, const u32 bound) {
+    generate(values, [bound](const u32 value) { return static_cast<u32>((u64 {value} * bound) >> 32); });
+}
 
-}
\ No newline at end of file
+inline void RandomBatch::fill_uniform(const std::span<f32> values) {
+    generate(values, [](const u32 value) { return static_cast<f32>(value >> 8) * 0x1.0p-24f; });
+}
+}
@@ -3,7 +3,9 @@
 #include <yaml-cpp/yaml.h>
 
 #include <cstdlib>
+#include <format>
 #include <fstream>
+#include <random>
 #include <stdexcept>
 
 namespace spire {
@@ -17,18 +19,59 @@ std::string read_file_line(std::string_view path) {
     return value;
 }
 
+static SocketTuning parse_socket_tuning(const YAML::Node& node) {
+    SocketTuning tuning {};
+    if (!node) return tuning;
+
+    const auto parse_size = [&](const char* key) -> std::optional<i32> {
+        if (!node[key]) return std::nullopt;
+
+        const auto value {node[key].as<i32>()};
+        if (value < 0)
+            throw std::invalid_argument(std::format("socket_tuning {} is negative", key));
+        return value;
+    };
+
+    tuning.send_buffer_size = parse_size("send_buffer_size");
+    tuning.receive_buffer_size = parse_size("receive_buffer_size");
+    if (node["quick_ack"])
+        tuning.quick_ack = node["quick_ack"].as<bool>();
+    tuning.not_sent_low_watermark = parse_size("not_sent_low_watermark");
+    tuning.busy_poll = parse_size("busy_poll");
+    if (const auto user_timeout {parse_size("user_timeout")})
+        tuning.user_timeout = milliseconds {*user_timeout};
+    if (const auto defer_accept {parse_size("defer_accept")})
+        tuning.defer_accept = seconds {*defer_accept};
+
+    return tuning;
+}
+
 void Settings::init() {
     YAML::Node settings {YAML::LoadFile(SPIRE_SETTINGS_FILE)};
 
     _game_listen_port = std::stoi(std::getenv("SPIRE_GAME_LISTEN_PORT"));
     _admin_listen_port = std::stoi(std::getenv("SPIRE_ADMIN_LISTEN_PORT"));
+    const char* metrics_listen_port {std::getenv("SPIRE_METRICS_LISTEN_PORT")};
+    _metrics_listen_port = metrics_listen_port ? std::stoi(metrics_listen_port) : 0;
+    const char* udp_listen_port {std::getenv("SPIRE_UDP_LISTEN_PORT")};
+    _udp_listen_port = udp_listen_port ? std::stoi(udp_listen_port) : 0;
     _listen_backlog = settings["listen_backlog"]
         ? settings["listen_backlog"].as<u16>()
         : boost::asio::socket_base::max_listen_connections;
     _tcp_no_delay = settings["tcp_no_delay"].as<bool>();
+    _game_socket_tuning = parse_socket_tuning(settings["socket_tuning"]["game"]);
+    _admin_socket_tuning = parse_socket_tuning(settings["socket_tuning"]["admin"]);
+
+    if (settings["handoff_socket"])
+        _handoff_socket = settings["handoff_socket"].as<std::string>();
+    if (settings["drain_timeout"])
+        _drain_timeout = milliseconds {settings["drain_timeout"].as<u32>()};
+    if (settings["drain_reconnect_window"])
+        _drain_reconnect_window = milliseconds {settings["drain_reconnect_window"].as<u32>()};
 
     _certificate_file = std::getenv("SPIRE_GAME_CERTIFICATE_FILE");
     _private_key_file = std::getenv("SPIRE_GAME_PRIVATE_KEY_FILE");
+    _admin_ca_file = std::getenv("SPIRE_ADMIN_CA_FILE");
 
     _auth_key = read_file_line(std::getenv("SPIRE_AUTH_KEY_FILE"));
 
@@ -40,5 +83,92 @@ void Settings::init() {
 
     _heartbeat_interval = milliseconds {settings["heartbeat_interval"].as<u32>()};
     _heartbeat_retries = settings["heartbeat_retries"].as<u8>();
+    if (settings["session_resume_grace"])
+        _session_resume_grace = milliseconds {settings["session_resume_grace"].as<u32>()};
+
+    if (settings["send_queue_low_watermark"])
+        _send_queue_low_watermark = settings["send_queue_low_watermark"].as<u32>();
+    if (settings["send_queue_high_watermark"])
+        _send_queue_high_watermark = settings["send_queue_high_watermark"].as<u32>();
+    if (settings["send_queue_limit"])
+        _send_queue_limit = settings["send_queue_limit"].as<u32>();
+    if (_send_queue_low_watermark > _send_queue_high_watermark)
+        throw std::invalid_argument("send_queue_low_watermark is greater than send_queue_high_watermark");
+    if (settings["send_batching"])
+        _send_batching = settings["send_batching"].as<bool>();
+    if (settings["send_batch_container"])
+        _send_batch_container = settings["send_batch_container"].as<bool>();
+
+    if (settings["max_frame_size"])
+        _max_frame_size = settings["max_frame_size"].as<u32>();
+    if (settings["compression"])
+        _compression = settings["compression"].as<std::string>();
+    if (settings["compression_threshold"])
+        _compression_threshold = settings["compression_threshold"].as<u32>();
+    if (settings["compression_level"])
+        _compression_level = settings["compression_level"].as<i32>();
+    if (settings["compression_dictionary"])
+        _compression_dictionary = settings["compression_dictionary"].as<std::string>();
+
+    if (settings["game_data_file"])
+        _game_data_file = settings["game_data_file"].as<std::string>();
+
+    if (settings["warmup_buffers"])
+        _warmup_buffers = settings["warmup_buffers"].as<u32>();
+    if (settings["warmup_buffer_size"])
+        _warmup_buffer_size = settings["warmup_buffer_size"].as<u32>();
+    if (settings["warmup_rooms_per_district"])
+        _warmup_rooms_per_district = settings["warmup_rooms_per_district"].as<u32>();
+    if (settings["warmup_room_clients"])
+        _warmup_room_clients = settings["warmup_room_clients"].as<u32>();
+    if (settings["warmup_room_entities"])
+        _warmup_room_entities = settings["warmup_room_entities"].as<u32>();
+
+    if (settings["tick_arena_size"])
+        _tick_arena_size = settings["tick_arena_size"].as<u32>();
+    if (settings["tick_message_arena_size"])
+        _tick_message_arena_size = settings["tick_message_arena_size"].as<u32>();
+
+    if (settings["path_search_limit"])
+        _path_search_limit = settings["path_search_limit"].as<u32>();
+    if (settings["path_cached_goals"])
+        _path_cached_goals = settings["path_cached_goals"].as<u32>();
+
+    if (settings["character_speed"])
+        _character_speed = settings["character_speed"].as<f32>();
+    if (settings["transform_history_size"])
+        _transform_history_size = settings["transform_history_size"].as<u32>();
+    if (settings["transform_history_interval"])
+        _transform_history_interval = milliseconds {settings["transform_history_interval"].as<u32>()};
+    if (settings["lag_compensation_delay"])
+        _lag_compensation_delay = milliseconds {settings["lag_compensation_delay"].as<u32>()};
+    if (settings["lag_compensation_limit"])
+        _lag_compensation_limit = milliseconds {settings["lag_compensation_limit"].as<u32>()};
+
+    if (settings["random_seed"])
+        _random_seed = settings["random_seed"].as<u64>();
+    if (_random_seed == 0)
+        _random_seed = (u64 {std::random_device {}()} << 32) | std::random_device {}();
+
+    if (settings["replay_directory"])
+        _replay_directory = settings["replay_directory"].as<std::string>();
+    if (settings["replay_pending_limit"])
+        _replay_pending_limit = settings["replay_pending_limit"].as<u32>();
+
+    if (settings["tick_profiler_enabled"])
+        _tick_profiler_enabled = settings["tick_profiler_enabled"].as<bool>();
+    if (settings["tick_profiler_capacity"])
+        _tick_profiler_capacity = settings["tick_profiler_capacity"].as<u32>();
+    if (settings["slow_tick_threshold"])
+        _slow_tick_threshold = milliseconds {settings["slow_tick_threshold"].as<u32>()};
+    if (settings["room_snapshot_interval"])
+        _room_snapshot_interval = milliseconds {settings["room_snapshot_interval"].as<u32>()};
+
+    if (settings["log_async"])
+        _log_async = settings["log_async"].as<bool>();
+    if (settings["log_queue_size"])
+        _log_queue_size = settings["log_queue_size"].as<u32>();
+    if (settings["log_rate_limit"])
+        _log_rate_limit = settings["log_rate_limit"].as<u32>();
 }
 }
@@ -3,19 +3,52 @@
 #include <spire/core/types.hpp>
 
 #include <filesystem>
+#include <optional>
 
 namespace spire {
+// Kernel options of the sockets of a listener, unset options keep the system defaults
+struct SocketTuning {
+    // SO_SNDBUF and SO_RCVBUF in bytes
+    std::optional<i32> send_buffer_size {};
+    std::optional<i32> receive_buffer_size {};
+    // TCP_QUICKACK, set again by `Connection` after every received frame as the kernel leaves quick ack mode on its own
+    bool quick_ack {false};
+    // TCP_NOTSENT_LOWAT in bytes, keeps unsent data in the send queue of `Connection` where it is batched and collapsed
+    std::optional<i32> not_sent_low_watermark {};
+    // SO_BUSY_POLL in microseconds
+    std::optional<i32> busy_poll {};
+    // TCP_USER_TIMEOUT
+    std::optional<milliseconds> user_timeout {};
+    // TCP_DEFER_ACCEPT, accepts once the client sent data, listener only
+    std::optional<seconds> defer_accept {};
+};
+
 class Settings final {
 public:
     static void init();
 
     static u16 game_listen_port() { return _game_listen_port; }
     static u16 admin_listen_port() { return _admin_listen_port; }
+    // 0 if the metrics exporter is disabled
+    static u16 metrics_listen_port() { return _metrics_listen_port; }
+    // 0 if the UDP transport is disabled
+    static u16 udp_listen_port() { return _udp_listen_port; }
     static u16 listen_backlog() { return _listen_backlog; }
     static bool tcp_no_delay() { return _tcp_no_delay; }
+    static const SocketTuning& game_socket_tuning() { return _game_socket_tuning; }
+    static const SocketTuning& admin_socket_tuning() { return _admin_socket_tuning; }
+
+    // Unix domain socket a restarting server hands its listeners and sessions over, empty to disable handoff
+    static std::filesystem::path handoff_socket() { return _handoff_socket; }
+    // Longest wait for clients to leave a draining server
+    static milliseconds drain_timeout() { return _drain_timeout; }
+    // Clients of a draining room are told to reconnect spread over this window
+    static milliseconds drain_reconnect_window() { return _drain_reconnect_window; }
 
     static std::filesystem::path certificate_file() { return _certificate_file; }
     static std::filesystem::path private_key_file() { return _private_key_file; }
+    // Certificates of admin clients must be signed by one of these CAs, the admin listener accepts no other clients
+    static std::filesystem::path admin_ca_file() { return _admin_ca_file; }
 
     static std::string_view auth_key() { return _auth_key; }
 
@@ -27,15 +60,92 @@ public:
 
     static milliseconds heartbeat_interval() { return _heartbeat_interval; }
     static u8 heartbeat_retries() { return _heartbeat_retries; }
+    // How long the session of a dropped connection can be resumed, 0 to disable resumption
+    static milliseconds session_resume_grace() { return _session_resume_grace; }
+
+    static u32 send_queue_low_watermark() { return _send_queue_low_watermark; }
+    static u32 send_queue_high_watermark() { return _send_queue_high_watermark; }
+    static u32 send_queue_limit() { return _send_queue_limit; }
+    // Merge reliable messages sent to a client during a room tick into one write
+    static bool send_batching() { return _send_batching; }
+    // Pack merged messages into a single container frame, compressed as a whole
+    static bool send_batch_container() { return _send_batch_container; }
+
+    static u32 max_frame_size() { return _max_frame_size; }
+    // One of `none`, `lz4` or `zstd`. Anything but `none` sends extended frames that older clients cannot decode.
+    static std::string_view compression() { return _compression; }
+    static u32 compression_threshold() { return _compression_threshold; }
+    static i32 compression_level() { return _compression_level; }
+    // Empty if frames are compressed without a dictionary
+    static std::filesystem::path compression_dictionary() { return _compression_dictionary; }
+
+    // Packed by `tools/pack_data`, empty to run without game data
+    static std::filesystem::path game_data_file() { return _game_data_file; }
+
+    // Message buffers preallocated at startup, 0 to allocate on demand
+    static u32 warmup_buffers() { return _warmup_buffers; }
+    static u32 warmup_buffer_size() { return _warmup_buffer_size; }
+    // Rooms created idle at startup in every district
+    static u32 warmup_rooms_per_district() { return _warmup_rooms_per_district; }
+    static u32 warmup_room_clients() { return _warmup_room_clients; }
+    static u32 warmup_room_entities() { return _warmup_room_entities; }
+
+    // Per room, memory allocated during a tick beyond these comes from the global allocator
+    static u32 tick_arena_size() { return _tick_arena_size; }
+    static u32 tick_message_arena_size() { return _tick_message_arena_size; }
+
+    // Cells a path search may expand before giving up
+    static u32 path_search_limit() { return _path_search_limit; }
+    // Goals whose searches are kept per room for the paths of later queries, each takes 10 bytes per grid cell
+    static u32 path_cached_goals() { return _path_cached_goals; }
+
+    // Meters per second a character moved by the commands of its client covers at most
+    static f32 character_speed() { return _character_speed; }
+    // Past transforms kept per moving entity, one sample per interval
+    static u32 transform_history_size() { return _transform_history_size; }
+    static milliseconds transform_history_interval() { return _transform_history_interval; }
+    // Added to the ping of a client when rewinding, how far behind its client renders other entities
+    static milliseconds lag_compensation_delay() { return _lag_compensation_delay; }
+    static milliseconds lag_compensation_limit() { return _lag_compensation_limit; }
+
+    // Rooms draw their random numbers from this seed and their id, so that a run can be repeated. Never 0 after
+    // `init()`, which picks one if not set.
+    static u64 random_seed() { return _random_seed; }
+
+    // Logs of the input of district rooms for `tools/replay` are written here, empty to disable recording
+    static std::filesystem::path replay_directory() { return _replay_directory; }
+    // Bytes of replay logs waiting to be written, rooms stop recording beyond it
+    static u32 replay_pending_limit() { return _replay_pending_limit; }
+
+    static bool tick_profiler_enabled() { return _tick_profiler_enabled; }
+    static u32 tick_profiler_capacity() { return _tick_profiler_capacity; }
+    static milliseconds slow_tick_threshold() { return _slow_tick_threshold; }
+    static milliseconds room_snapshot_interval() { return _room_snapshot_interval; }
+
+    // Writes logs on a background thread, so that a slow disk or terminal never stalls IO and room threads
+    static bool log_async() { return _log_async; }
+    // Messages waiting to be written, preallocated. The oldest is dropped when it is full.
+    static u32 log_queue_size() { return _log_queue_size; }
+    // Messages per second let through by each rate limited log site
+    static u32 log_rate_limit() { return _log_rate_limit; }
 
 private:
     inline static u16 _game_listen_port;
     inline static u16 _admin_listen_port;
+    inline static u16 _metrics_listen_port;
+    inline static u16 _udp_listen_port;
     inline static u16 _listen_backlog;
     inline static bool _tcp_no_delay;
+    inline static SocketTuning _game_socket_tuning {};
+    inline static SocketTuning _admin_socket_tuning {};
+
+    inline static std::filesystem::path _handoff_socket {};
+    inline static milliseconds _drain_timeout {10000};
+    inline static milliseconds _drain_reconnect_window {5000};
 
     inline static std::filesystem::path _certificate_file;
     inline static std::filesystem::path _private_key_file;
+    inline static std::filesystem::path _admin_ca_file;
 
     inline static std::string _auth_key;
 
@@ -45,7 +155,54 @@ private:
     inline static std::string _db_user;
     inline static std::string _db_password;
 
-    inline static milliseconds _heartbeat_interval;
-    inline static u8 _heartbeat_retries;
+    inline static milliseconds _heartbeat_interval {5000};
+    inline static u8 _heartbeat_retries {3};
+    inline static milliseconds _session_resume_grace {30000};
+
+    inline static u32 _send_queue_low_watermark {64 * 1024};
+    inline static u32 _send_queue_high_watermark {256 * 1024};
+    inline static u32 _send_queue_limit {1024 * 1024};
+    inline static bool _send_batching {true};
+    inline static bool _send_batch_container {false};
+
+    inline static u32 _max_frame_size {16 * 1024 * 1024};
+    inline static std::string _compression {"none"};
+    inline static u32 _compression_threshold {1024};
+    inline static i32 _compression_level {3};
+    inline static std::filesystem::path _compression_dictionary {};
+
+    inline static std::filesystem::path _game_data_file {};
+
+    inline static u32 _warmup_buffers {0};
+    inline static u32 _warmup_buffer_size {1024};
+    inline static u32 _warmup_rooms_per_district {0};
+    inline static u32 _warmup_room_clients {0};
+    inline static u32 _warmup_room_entities {0};
+
+    inline static u32 _tick_arena_size {256 * 1024};
+    inline static u32 _tick_message_arena_size {64 * 1024};
+
+    inline static u32 _path_search_limit {16384};
+    inline static u32 _path_cached_goals {16};
+
+    inline static f32 _character_speed {6.0f};
+    inline static u32 _transform_history_size {64};
+    inline static milliseconds _transform_history_interval {16};
+    inline static milliseconds _lag_compensation_delay {100};
+    inline static milliseconds _lag_compensation_limit {500};
+
+    inline static u64 _random_seed {0};
+
+    inline static std::filesystem::path _replay_directory {};
+    inline static u32 _replay_pending_limit {64 * 1024 * 1024};
+
+    inline static bool _tick_profiler_enabled {true};
+    inline static u32 _tick_profiler_capacity {256};
+    inline static milliseconds _slow_tick_threshold {50};
+    inline static milliseconds _room_snapshot_interval {1000};
+
+    inline static bool _log_async {true};
+    inline static u32 _log_queue_size {8192};
+    inline static u32 _log_rate_limit {10};
 };
 }
\ No newline at end of file
@@ -0,0 +1,61 @@
+#include <spire/core/tick_arena.hpp>
+
+#include <algorithm>
+
+namespace spire {
+static google::protobuf::ArenaOptions message_arena_options(std::vector<std::byte>& buffer) {
+    google::protobuf::ArenaOptions options {};
+    if (!buffer.empty()) {
+        options.initial_block = reinterpret_cast<char*>(buffer.data());
+        options.initial_block_size = buffer.size();
+    }
+
+    return options;
+}
+
+TickArena::Scope::Scope(TickArena& arena)
+    : _arena {arena}, _previous {_current} {
+    _current = &_arena;
+}
+
+TickArena::Scope::~Scope() {
+    _current = _previous;
+    _arena.reset();
+}
+
+TickArena::TickArena(const size_t size, const size_t message_size)
+    : _buffer(size),
+    _message_buffer(message_size),
+    _monotonic {_buffer.data(), _buffer.size(), &_overflow},
+    _messages {message_arena_options(_message_buffer)} {}
+
+std::pmr::memory_resource* TickArena::current_resource() {
+    return _current ? _current->resource() : std::pmr::get_default_resource();
+}
+
+TickArena::Stats TickArena::take_stats() {
+    return std::exchange(_stats, {});
+}
+
+void TickArena::reset() {
+    const size_t message_bytes {static_cast<size_t>(_messages.SpaceUsed())};
+    // Blocks beyond the initial one are allocated by protobuf from the global allocator
+    const size_t message_blocks {static_cast<size_t>(_messages.Reset())};
+    _stats.peak_bytes = std::max(_stats.peak_bytes, _tick.bytes() + message_bytes);
+    _stats.overflow_bytes += _overflow.bytes()
+        + (message_blocks > _message_buffer.size() ? message_blocks - _message_buffer.size() : 0);
+
+    _monotonic.release();
+    _tick.clear();
+    _overflow.clear();
+}
+
+void* TickArena::CountingResource::do_allocate(const size_t bytes, const size_t alignment) {
+    _bytes += bytes;
+    return _upstream->allocate(bytes, alignment);
+}
+
+void TickArena::CountingResource::do_deallocate(void* pointer, const size_t bytes, const size_t alignment) {
+    _upstream->deallocate(pointer, bytes, alignment);
+}
+}
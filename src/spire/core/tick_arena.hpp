@@ -0,0 +1,108 @@
+#pragma once
+
+#include <boost/core/noncopyable.hpp>
+#include <google/protobuf/arena.h>
+#include <google/protobuf/message_lite.h>
+#include <spire/core/types.hpp>
+
+#include <concepts>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+namespace spire {
+// Monotonic memory for data that lives no longer than a room tick. Allocation bumps a pointer into blocks owned by
+// the room and everything is freed at once when the tick ends, so rooms on different threads do not contend in
+// malloc. Once the owned blocks are exhausted, allocations overflow to the global allocator until the tick ends.
+//
+// Anything kept past the tick must be copied to memory of the global allocator with `promote`.
+class TickArena final : boost::noncopyable {
+public:
+    struct Stats {
+        // Largest amount allocated during a single tick, parsed messages included
+        size_t peak_bytes {0};
+        // Allocated beyond the owned blocks, summed over ticks
+        size_t overflow_bytes {0};
+    };
+
+    // Makes `arena` current on the calling thread, resetting it once the scope ends
+    class Scope final : boost::noncopyable {
+    public:
+        explicit Scope(TickArena& arena);
+        ~Scope();
+
+    private:
+        TickArena& _arena;
+        TickArena* const _previous;
+    };
+
+    // `size` bytes for `std::pmr` containers, `message_size` bytes for parsed protobuf messages
+    TickArena(size_t size, size_t message_size);
+    ~TickArena() = default;
+
+    // Arena of the innermost scope on the calling thread, null outside of a room tick
+    static TickArena* current() { return _current; }
+    // Resource of the current tick, or the global allocator outside of one so that callers need no special case
+    static std::pmr::memory_resource* current_resource();
+
+    std::pmr::memory_resource* resource() { return &_tick; }
+    google::protobuf::Arena& messages() { return _messages; }
+
+    // Stats since the previous call
+    Stats take_stats();
+
+    // Copy of `container` on the global allocator, nested `std::pmr` containers included, to keep past the tick
+    template <typename T>
+        requires std::same_as<typename T::allocator_type, std::pmr::polymorphic_allocator<typename T::value_type>>
+    static T promote(const T& container);
+    // Copy of `message` on the global allocator, to keep a message parsed during the tick past it
+    template <std::derived_from<google::protobuf::MessageLite> T>
+    static std::unique_ptr<T> promote(const T& message);
+
+private:
+    // Counts what passes through to `upstream`
+    class CountingResource final : public std::pmr::memory_resource {
+    public:
+        explicit CountingResource(std::pmr::memory_resource* upstream) : _upstream {upstream} {}
+
+        size_t bytes() const { return _bytes; }
+        void clear() { _bytes = 0; }
+
+    private:
+        void* do_allocate(size_t bytes, size_t alignment) override;
+        void do_deallocate(void* pointer, size_t bytes, size_t alignment) override;
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+        std::pmr::memory_resource* const _upstream;
+        size_t _bytes {0};
+    };
+
+    void reset();
+
+    inline static thread_local TickArena* _current {nullptr};
+
+    std::vector<std::byte> _buffer;
+    std::vector<std::byte> _message_buffer;
+
+    CountingResource _overflow {std::pmr::new_delete_resource()};
+    std::pmr::monotonic_buffer_resource _monotonic;
+    CountingResource _tick {&_monotonic};
+    google::protobuf::Arena _messages;
+
+    Stats _stats {};
+};
+
+
+template <typename T>
+    requires std::same_as<typename T::allocator_type, std::pmr::polymorphic_allocator<typename T::value_type>>
+T TickArena::promote(const T& container) {
+    return T(container, std::pmr::new_delete_resource());
+}
+
+template <std::derived_from<google::protobuf::MessageLite> T>
+std::unique_ptr<T> TickArena::promote(const T& message) {
+    auto promoted {std::make_unique<T>()};
+    promoted->CopyFrom(message);
+    return promoted;
+}
+}
@@ -2,6 +2,7 @@
 
 #include <boost/asio.hpp>
 #include <boost/signals2.hpp>
+#include <spire/core/clock.hpp>
 
 #include <chrono>
 
@@ -25,10 +26,10 @@ private:
     const milliseconds _duration;
     const bool _one_shot;
 
-    boost::asio::steady_timer _timer;
+    ClockTimer _timer;
     boost::signals2::signal<void()> _timeout {};
 
-    const boost::asio::any_io_executor& _executor;
+    const boost::asio::any_io_executor _executor;
     boost::asio::cancellation_signal _cancelled {};
     std::atomic<bool> _is_running {false};
 };
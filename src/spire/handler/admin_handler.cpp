@@ -0,0 +1,209 @@
+#include <spdlog/spdlog.h>
+#include <spire/core/game_data.hpp>
+#include <spire/core/metrics.hpp>
+#include <spire/core/settings.hpp>
+#include <spire/handler/admin_handler.hpp>
+
+#include <charconv>
+#include <format>
+#include <optional>
+
+namespace spire {
+static constexpr size_t MAX_OUTPUT_SIZE {4 * 1024 * 1024};
+static constexpr size_t DEFAULT_TRACE_TICKS {256};
+
+template <typename T>
+static std::optional<T> parse_number(const std::string_view text) {
+    T value {};
+    const auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (ec != std::errc {} || end != text.data() + text.size()) return std::nullopt;
+
+    return value;
+}
+
+static f64 to_milliseconds(const nanoseconds value) {
+    return duration_cast<duration<f64, std::milli>>(value).count();
+}
+
+HandlerFunction<net::SslClient> AdminHandler::make(RoomDirectory& room_directory) {
+    return [&room_directory](const std::shared_ptr<net::SslClient>& client, const msg::BaseMessage& base) {
+        return handle(room_directory, client, base);
+    };
+}
+
+HandlerResult AdminHandler::handle(
+    RoomDirectory& room_directory,
+    const std::shared_ptr<net::SslClient>& client,
+    const msg::BaseMessage& base) {
+    switch (base.message_case()) {
+    case msg::BaseMessage::kAdminCommand:
+        return handle_command(room_directory, client, base.admin_command());
+
+    default:
+        return HandlerResult::Continue;
+    }
+}
+
+HandlerResult AdminHandler::handle_command(
+    RoomDirectory& room_directory,
+    const std::shared_ptr<net::SslClient>& client,
+    const msg::AdminCommand& command) {
+    const std::vector<std::string> arguments {command.arguments().begin(), command.arguments().end()};
+    const std::string_view name {command.command()};
+
+    std::string command_line {name};
+    for (const auto& argument : arguments)
+        command_line += std::format(" {}", argument);
+    spdlog::info("Admin client {}: {}", client->id(), command_line);
+
+    CommandResult result;
+    if (name == "rooms") result = list_rooms(room_directory);
+    else if (name == "clients") result = list_clients(room_directory, arguments);
+    else if (name == "metrics") result = dump_metrics();
+    else if (name == "log_level") result = set_log_level(arguments);
+    else if (name == "profile") result = set_profiling(room_directory, arguments);
+    else if (name == "trace") result = dump_trace(room_directory, arguments);
+    else if (name == "drain") result = drain_rooms(room_directory, arguments);
+    else if (name == "kick") result = kick_client(room_directory, arguments);
+    else if (name == "reload_data") result = reload_data(arguments);
+    else result = std::unexpected {std::format("Unknown command: {}", name)};
+
+    auto* admin_result {new msg::AdminResult};
+    admin_result->set_success(result.has_value());
+    auto output {result.has_value() ? std::move(*result) : std::move(result.error())};
+    if (output.size() > MAX_OUTPUT_SIZE) {
+        output.resize(MAX_OUTPUT_SIZE);
+        output += "\n(truncated)";
+    }
+    admin_result->set_output(std::move(output));
+
+    msg::BaseMessage base {};
+    base.set_allocated_admin_result(admin_result);
+    client->send(std::make_unique<net::OutMessage>(base));
+
+    return HandlerResult::Break;
+}
+
+AdminHandler::CommandResult AdminHandler::list_rooms(RoomDirectory& room_directory) {
+    std::string output {std::format("{:<20} {:>8} {:>8} {:>10} {:>10} {:>9} {:>7} {:>10} {:>11} {:>9}\n",
+        "room", "clients", "ticks/s", "mean_ms", "max_ms", "messages", "tasks", "arena_kb", "overflow_kb", "draining")};
+
+    for (const auto& room : room_directory.rooms()) {
+        const auto snapshot {room->snapshot()};
+        const auto selector {std::format("{}:{}", room->name(), room->id())};
+        if (!snapshot) {
+            output += std::format("{:<20} (not started)\n", selector);
+            continue;
+        }
+
+        output += std::format("{:<20} {:>8} {:>8.1f} {:>10.3f} {:>10.3f} {:>9} {:>7} {:>10} {:>11} {:>9}\n",
+            selector,
+            snapshot->clients.size(),
+            snapshot->ticks_per_second,
+            to_milliseconds(snapshot->mean_tick),
+            to_milliseconds(snapshot->max_tick),
+            snapshot->pending_messages,
+            snapshot->pending_tasks,
+            snapshot->arena_peak_bytes / 1024,
+            snapshot->arena_overflow_bytes / 1024,
+            snapshot->is_draining ? "yes" : "no");
+    }
+
+    return output;
+}
+
+AdminHandler::CommandResult AdminHandler::list_clients(RoomDirectory& room_directory, const Arguments arguments) {
+    if (arguments.size() != 1) return std::unexpected {"Usage: clients <room>"};
+
+    std::string output {std::format("{:<20} {:>12} {:>8} {:>12}\n", "room", "client", "ping_ms", "queued_bytes")};
+    for (const auto& room : room_directory.find(arguments[0])) {
+        const auto snapshot {room->snapshot()};
+        if (!snapshot) continue;
+
+        for (const auto& client : snapshot->clients) {
+            output += std::format("{:<20} {:>12} {:>8} {:>12}\n",
+                std::format("{}:{}", snapshot->name, snapshot->id),
+                client.id,
+                client.ping.count(),
+                client.queued_bytes);
+        }
+    }
+
+    return output;
+}
+
+AdminHandler::CommandResult AdminHandler::dump_metrics() {
+    return metrics::Metrics::export_prometheus();
+}
+
+AdminHandler::CommandResult AdminHandler::set_log_level(const Arguments arguments) {
+    if (arguments.size() != 1) return std::unexpected {"Usage: log_level <trace|debug|info|warning|error|critical|off>"};
+
+    const auto level {spdlog::level::from_str(arguments[0])};
+    if (level == spdlog::level::off && arguments[0] != "off")
+        return std::unexpected {std::format("Unknown log level: {}", arguments[0])};
+
+    spdlog::set_level(level);
+    return std::format("Log level set to {}", to_string_view(level));
+}
+
+AdminHandler::CommandResult AdminHandler::set_profiling(RoomDirectory& room_directory, const Arguments arguments) {
+    if (arguments.empty() || arguments.size() > 2 || (arguments[0] != "on" && arguments[0] != "off"))
+        return std::unexpected {"Usage: profile <on|off> [room]"};
+
+    const bool enabled {arguments[0] == "on"};
+    const auto rooms {arguments.size() == 2 ? room_directory.find(arguments[1]) : room_directory.rooms()};
+    for (const auto& room : rooms)
+        room->profiler().set_enabled(enabled);
+
+    return std::format("Profiling {} for {} room(s)", enabled ? "enabled" : "disabled", rooms.size());
+}
+
+AdminHandler::CommandResult AdminHandler::dump_trace(RoomDirectory& room_directory, const Arguments arguments) {
+    if (arguments.empty() || arguments.size() > 2) return std::unexpected {"Usage: trace <name:id> [ticks]"};
+
+    const auto rooms {room_directory.find(arguments[0])};
+    if (rooms.size() != 1) return std::unexpected {std::format("Expected one room, found {}", rooms.size())};
+
+    const auto ticks {arguments.size() == 2 ? parse_number<size_t>(arguments[1]) : DEFAULT_TRACE_TICKS};
+    if (!ticks) return std::unexpected {std::format("Invalid tick count: {}", arguments[1])};
+
+    return rooms.front()->profiler().trace_json(*ticks);
+}
+
+AdminHandler::CommandResult AdminHandler::drain_rooms(RoomDirectory& room_directory, const Arguments arguments) {
+    if (arguments.size() != 1) return std::unexpected {"Usage: drain <room>"};
+
+    const auto rooms {room_directory.find(arguments[0])};
+    for (const auto& room : rooms)
+        room->drain_deferred();
+
+    return std::format("Draining {} room(s)", rooms.size());
+}
+
+AdminHandler::CommandResult AdminHandler::kick_client(RoomDirectory& room_directory, const Arguments arguments) {
+    if (arguments.size() != 1) return std::unexpected {"Usage: kick <client>"};
+
+    const auto client_id {parse_number<u64>(arguments[0])};
+    if (!client_id) return std::unexpected {std::format("Invalid client id: {}", arguments[0])};
+
+    // Client ids are unique process-wide, so only the room holding the client acts on it
+    for (const auto& room : room_directory.rooms())
+        room->kick_client_deferred(*client_id);
+
+    return std::format("Kicking client {}", *client_id);
+}
+
+AdminHandler::CommandResult AdminHandler::reload_data(const Arguments arguments) {
+    if (!arguments.empty()) return std::unexpected {"Usage: reload_data"};
+
+    // Never a path sent by the client, new data is renamed over the configured file as `tools/pack_data` does
+    const auto path {Settings::game_data_file()};
+    if (path.empty()) return std::unexpected {"No game data file configured"};
+
+    // Rooms move to the new data with their next update
+    if (!GameData::load(path)) return std::unexpected {std::format("Could not map game data {}", path.string())};
+
+    return std::format("Game data {} revision {} loaded", path.string(), GameData::current()->revision());
+}
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <spire/handler/types.hpp>
+#include <spire/server/room_directory.hpp>
+
+#include <expected>
+
+namespace spire {
+class AdminHandler final {
+public:
+    static HandlerFunction<net::SslClient> make(RoomDirectory& room_directory);
+
+private:
+    using CommandResult = std::expected<std::string, std::string>;
+    using Arguments = std::span<const std::string>;
+
+    static HandlerResult handle(
+        RoomDirectory& room_directory,
+        const std::shared_ptr<net::SslClient>& client,
+        const msg::BaseMessage& base);
+    static HandlerResult handle_command(
+        RoomDirectory& room_directory,
+        const std::shared_ptr<net::SslClient>& client,
+        const msg::AdminCommand& command);
+
+    static CommandResult list_rooms(RoomDirectory& room_directory);
+    static CommandResult list_clients(RoomDirectory& room_directory, Arguments arguments);
+    static CommandResult dump_metrics();
+    static CommandResult set_log_level(Arguments arguments);
+    static CommandResult set_profiling(RoomDirectory& room_directory, Arguments arguments);
+    static CommandResult dump_trace(RoomDirectory& room_directory, Arguments arguments);
+    static CommandResult drain_rooms(RoomDirectory& room_directory, Arguments arguments);
+    static CommandResult kick_client(RoomDirectory& room_directory, Arguments arguments);
+    static CommandResult reload_data(Arguments arguments);
+};
+}
@@ -1,26 +1,40 @@
 #include <jwt-cpp/jwt.h>
 #include <spdlog/spdlog.h>
+#include <spire/core/log.hpp>
 #include <spire/core/settings.hpp>
 #include <spire/handler/auth_handler.hpp>
 
 namespace spire {
-HandlerFunction<net::TcpClient> AuthHandler::make() {
-    return [](const std::shared_ptr<net::TcpClient>& client, const msg::BaseMessage& base) {
-        return handle(client, base);
+HandlerFunction<net::TcpClient> AuthHandler::make(net::UdpTransport* udp_transport, SessionTable* session_table) {
+    return [udp_transport, session_table](
+        const std::shared_ptr<net::TcpClient>& client,
+        const msg::BaseMessage& base) {
+        return handle(udp_transport, session_table, client, base);
     };
 }
 
-HandlerResult AuthHandler::handle(const std::shared_ptr<net::TcpClient>& client, const msg::BaseMessage& base) {
+HandlerResult AuthHandler::handle(
+    net::UdpTransport* udp_transport,
+    SessionTable* session_table,
+    const std::shared_ptr<net::TcpClient>& client,
+    const msg::BaseMessage& base) {
     switch (base.message_case()) {
     case msg::BaseMessage::kLogin:
-        return handle_login(client, base.login());
+        return handle_login(udp_transport, session_table, client, base.login());
+
+    case msg::BaseMessage::kResume:
+        return handle_resume(udp_transport, session_table, client, base.resume());
 
     default:
         return HandlerResult::Continue;
     }
 }
 
-HandlerResult AuthHandler::handle_login(const std::shared_ptr<net::TcpClient>& client, const msg::Login& login) {
+HandlerResult AuthHandler::handle_login(
+    net::UdpTransport* udp_transport,
+    SessionTable* session_table,
+    const std::shared_ptr<net::TcpClient>& client,
+    const msg::Login& login) {
     try {
         const auto decoded_token {jwt::decode(login.token())};
         const auto verifier {jwt::verify()
@@ -30,13 +44,23 @@ HandlerResult AuthHandler::handle_login(const std::shared_ptr<net::TcpClient>& c
 
         verifier.verify(decoded_token);
     } catch (const std::exception&) {
-        spdlog::warn("Client(TODO): Invalid token");
+        // A login storm must not flood the log
+        static LogLimiter invalid_token_log {Settings::log_rate_limit()};
+        invalid_token_log.log(spdlog::level::warn, "Client {}: Invalid token", client->id());
         client->stop(net::TcpClient::StopCode::AuthenticationError);
         return HandlerResult::Error;
     }
 
-    spdlog::debug("Client(TODO): Authenticated");
-    client->authenticate();
+    spdlog::debug("Client {}: Authenticated account {}", client->id(), login.account_id());
+    admit(udp_transport, client);
+
+    if (session_table) {
+        send_session_token(
+            client,
+            session_table->open(
+                client->id(),
+                SessionIdentity {.account_id = login.account_id(), .character_id = login.character_id()}));
+    }
 
     //TODO: Async read player from DB and callback
     {
@@ -45,4 +69,69 @@ HandlerResult AuthHandler::handle_login(const std::shared_ptr<net::TcpClient>& c
 
     return HandlerResult::Break;
 }
+
+HandlerResult AuthHandler::handle_resume(
+    net::UdpTransport* udp_transport,
+    SessionTable* session_table,
+    const std::shared_ptr<net::TcpClient>& client,
+    const msg::Resume& resume) {
+    // A logged in client would otherwise hold the identities of two sessions
+    auto resumed {session_table && !client->is_authenticated()
+        ? session_table->resume(resume.token(), client->id())
+        : std::nullopt};
+
+    auto* resume_result {new msg::ResumeResult};
+    resume_result->set_success(resumed.has_value());
+
+    msg::BaseMessage base {};
+    base.set_allocated_resume_result(resume_result);
+    client->send(std::make_unique<net::OutMessage>(base));
+
+    // The client falls back to a full login
+    if (!resumed) {
+        spdlog::debug("Client {}: Rejected resume", client->id());
+        return HandlerResult::Break;
+    }
+
+    spdlog::debug("Client {}: Resumed session of character {}", client->id(), resumed->identity.character_id);
+    admit(udp_transport, client);
+    send_session_token(client, std::move(resumed->token));
+
+    // Sent within the same room tick, so the replay leaves as a single write after the result and token
+    for (auto& message : resumed->unsent) {
+        client->send(std::move(message));
+    }
+
+    return HandlerResult::Break;
+}
+
+void AuthHandler::admit(net::UdpTransport* udp_transport, const std::shared_ptr<net::TcpClient>& client) {
+    client->authenticate();
+
+    if (udp_transport && udp_transport->is_running()) {
+        auto session {udp_transport->open_session()};
+        const auto& key {session->key()};
+
+        // Sent over the authenticated TCP connection, the client signs its datagrams with the key
+        auto* udp_session {new msg::UdpSession};
+        udp_session->set_token(session->token());
+        udp_session->set_key(reinterpret_cast<const char*>(key.data()), key.size());
+        udp_session->set_port(udp_transport->port());
+        client->bind_datagram_session(std::move(session));
+
+        msg::BaseMessage base {};
+        base.set_allocated_udp_session(udp_session);
+        client->send(std::make_unique<net::OutMessage>(base));
+    }
+}
+
+void AuthHandler::send_session_token(const std::shared_ptr<net::TcpClient>& client, std::string&& token) {
+    auto* session_token {new msg::SessionToken};
+    session_token->set_token(std::move(token));
+    session_token->set_grace_period(static_cast<u32>(Settings::session_resume_grace().count()));
+
+    msg::BaseMessage base {};
+    base.set_allocated_session_token(session_token);
+    client->send(std::make_unique<net::OutMessage>(base));
+}
 }
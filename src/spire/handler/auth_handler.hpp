@@ -1,14 +1,33 @@
 #pragma once
 
 #include <spire/handler/types.hpp>
+#include <spire/server/session_table.hpp>
 
 namespace spire {
 class AuthHandler final {
 public:
-    static HandlerFunction<net::TcpClient> make();
+    // Authenticated clients are issued a datagram session if `udp_transport` is running,
+    // and a resume token if `session_table` is not null
+    static HandlerFunction<net::TcpClient> make(net::UdpTransport* udp_transport, SessionTable* session_table);
 
 private:
-    static HandlerResult handle(const std::shared_ptr<net::TcpClient>& client, const msg::BaseMessage& base);
-    static HandlerResult handle_login(const std::shared_ptr<net::TcpClient>& client, const msg::Login& login);
+    static HandlerResult handle(
+        net::UdpTransport* udp_transport,
+        SessionTable* session_table,
+        const std::shared_ptr<net::TcpClient>& client,
+        const msg::BaseMessage& base);
+    static HandlerResult handle_login(
+        net::UdpTransport* udp_transport,
+        SessionTable* session_table,
+        const std::shared_ptr<net::TcpClient>& client,
+        const msg::Login& login);
+    static HandlerResult handle_resume(
+        net::UdpTransport* udp_transport,
+        SessionTable* session_table,
+        const std::shared_ptr<net::TcpClient>& client,
+        const msg::Resume& resume);
+
+    static void admit(net::UdpTransport* udp_transport, const std::shared_ptr<net::TcpClient>& client);
+    static void send_session_token(const std::shared_ptr<net::TcpClient>& client, std::string&& token);
 };
-}
\ No newline at end of file
+}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <spire/core/tick_arena.hpp>
 #include <spire/handler/types.hpp>
 #include <spire/net/message.hpp>
 
@@ -12,7 +13,8 @@ public:
     HandlerController(HandlerController&& other) noexcept;
 
     void add_handler(HandlerFunction<ClientType>&& handler);
-    void handle(
+    // Returns the case of the handled message, or `MESSAGE_NOT_SET` if it could not be parsed
+    msg::BaseMessage::MessageCase handle(
         const std::shared_ptr<ClientType>& client,
         std::unique_ptr<net::InMessage> message) const;
 
@@ -30,17 +32,24 @@ void HandlerController<ClientType>::add_handler(HandlerFunction<ClientType>&& ha
 }
 
 template <typename ClientType>
-void HandlerController<ClientType>::handle(
+msg::BaseMessage::MessageCase HandlerController<ClientType>::handle(
     const std::shared_ptr<ClientType>& client,
     std::unique_ptr<net::InMessage> message) const {
-    msg::BaseMessage base {};
+    // Parsed into the tick arena within a room update, sub-messages and strings included
+    auto* const arena {TickArena::current()};
+    std::unique_ptr<msg::BaseMessage> owned {arena ? nullptr : std::make_unique<msg::BaseMessage>()};
+    auto& base {arena ? *google::protobuf::Arena::Create<msg::BaseMessage>(&arena->messages()) : *owned};
+
     if (!base.ParseFromArray(message->data(), static_cast<int>(message->size()))) {
         client->stop(ClientType::StopCode::InvalidInMessage);
+        return msg::BaseMessage::MESSAGE_NOT_SET;
     }
 
     for (const auto& handler : _handlers) {
         const auto result {handler(client, base)};
         if (result == HandlerResult::Break || result == HandlerResult::Error) break;
     }
+
+    return base.message_case();
 }
 }
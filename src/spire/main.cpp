@@ -1,30 +1,67 @@
 #include <spdlog/spdlog.h>
+#include <spire/core/compression.hpp>
+#include <spire/core/game_data.hpp>
+#include <spire/core/log.hpp>
 #include <spire/core/settings.hpp>
+#include <spire/net/io_backend.hpp>
 #include <spire/server/server.hpp>
 
-int main() {
+#include <functional>
+
+int main(int, [[maybe_unused]] char* argv[]) {
     using namespace spire;
 
     Settings::init();
+#ifdef BOOST_ASIO_HAS_IO_URING
+    // Asio cannot switch reactors at runtime, the epoll server built alongside runs instead. Checked before anything
+    // is loaded or bound, and while logging is still synchronous.
+    if (!net::is_io_uring_supported()) {
+        spdlog::warn("io_uring is unavailable on this kernel, falling back to {}", net::EPOLL_SERVER_NAME);
+        net::exec_epoll_server(argv);
+        return EXIT_FAILURE;
+    }
+#endif
+    Log::init();
+    Compression::init();
+    if (const auto game_data_file {Settings::game_data_file()}; !game_data_file.empty()) {
+        if (!GameData::load(game_data_file)) return EXIT_FAILURE;
+    }
 
 #ifndef NDEBUG
     spdlog::set_level(spdlog::level::debug);
 #endif
     spdlog::info("spdlog log level: {}", to_string_view(spdlog::get_level()));
+    spdlog::info("Random seed: {}", Settings::random_seed());
+    spdlog::info("I/O backend: {}", net::io_backend_name());
 
     boost::asio::thread_pool io_threads {std::thread::hardware_concurrency() - 1};
     boost::asio::signal_set signals {io_threads.get_executor(), SIGINT, SIGTERM};
     Server server {io_threads.get_executor()};
 
-    signals.async_wait([&](boost::system::error_code, int) {
+    // SIGTERM drains first, letting clients reconnect to a successor, SIGINT stops right away. Another signal during a
+    // drain stops right away as well, so that a drain that takes too long can be cut short.
+    bool is_draining {false};
+    std::function<void(const boost::system::error_code&, int)> on_signal;
+    on_signal = [&](const boost::system::error_code& ec, const int signal) {
+        if (ec) return;
+
+        if (signal == SIGTERM && !is_draining) {
+            is_draining = true;
+            server.drain();
+            signals.async_wait(on_signal);
+            return;
+        }
+
         server.stop();
         io_threads.stop();
-    });
+    };
+    signals.async_wait(on_signal);
 
-    server.start();
+    server.start([&] { io_threads.stop(); });
 
     io_threads.attach();
     io_threads.join();
 
+    Log::shutdown();
     return EXIT_SUCCESS;
 }
@@ -0,0 +1,109 @@
+#include <spire/core/metrics.hpp>
+#include <spire/net/buffer_pool.hpp>
+
+#include <algorithm>
+#include <iterator>
+
+namespace spire::net {
+// Relative to the pooled capacity, keeps a single huge frame from pinning its memory
+static constexpr size_t MAX_GROWTH {16};
+// Buffers moved between a thread cache and the shared list at once
+static constexpr size_t BATCH_SIZE {16};
+// A thread caching more spills a batch, so that buffers released on IO threads flow back to room threads
+static constexpr size_t MAX_CACHED {2 * BATCH_SIZE};
+
+struct BufferPool::ThreadCache {
+    Buffers buffers {};
+
+    // Buffers of exiting threads go back to the shared list
+    ~ThreadCache() { spill(buffers, buffers.size()); }
+};
+
+void BufferPool::reserve(const size_t count, const size_t capacity) {
+    if (count == 0 || capacity == 0) return;
+
+    std::lock_guard lock {_mutex};
+
+    _count = count;
+    _capacity = capacity;
+    _buffers.reserve(count);
+    while (_buffers.size() < count) {
+        auto& buffer {_buffers.emplace_back()};
+        // Reserved memory is only mapped once written, resizing zeroes every page
+        buffer.resize(capacity);
+        buffer.clear();
+    }
+
+    _is_enabled = true;
+}
+
+std::vector<std::byte> BufferPool::acquire() {
+    static auto& misses {metrics::Metrics::counter(
+        "spire_net_buffer_pool_misses_total", "Message buffers allocated because the pool was empty")};
+
+    if (!_is_enabled) return {};
+
+    auto& cache {thread_cache().buffers};
+    if (cache.empty()) {
+        refill(cache, BATCH_SIZE);
+    }
+
+    std::vector<std::byte> buffer {};
+    if (!cache.empty()) {
+        buffer = std::move(cache.back());
+        cache.pop_back();
+        return buffer;
+    }
+
+    misses.add();
+    buffer.reserve(_capacity);
+    return buffer;
+}
+
+void BufferPool::release(std::vector<std::byte>&& buffer) {
+    if (!_is_enabled) return;
+    if (buffer.capacity() < _capacity || buffer.capacity() > _capacity * MAX_GROWTH) return;
+
+    buffer.clear();
+
+    auto& cache {thread_cache().buffers};
+    cache.push_back(std::move(buffer));
+    if (cache.size() > MAX_CACHED) {
+        spill(cache, BATCH_SIZE);
+    }
+}
+
+size_t BufferPool::size() {
+    std::lock_guard lock {_mutex};
+
+    return _buffers.size();
+}
+
+BufferPool::ThreadCache& BufferPool::thread_cache() {
+    thread_local ThreadCache cache {};
+    return cache;
+}
+
+void BufferPool::refill(Buffers& cache, const size_t count) {
+    std::lock_guard lock {_mutex};
+
+    const auto taken {std::min(count, _buffers.size())};
+    const auto first {_buffers.end() - static_cast<std::ptrdiff_t>(taken)};
+    cache.insert(cache.end(), std::make_move_iterator(first), std::make_move_iterator(_buffers.end()));
+    _buffers.erase(first, _buffers.end());
+}
+
+void BufferPool::spill(Buffers& cache, const size_t count) {
+    const auto first {cache.end() - static_cast<std::ptrdiff_t>(std::min(count, cache.size()))};
+    {
+        std::lock_guard lock {_mutex};
+
+        const auto free_slots {_count - std::min(_count, _buffers.size())};
+        const auto kept {static_cast<std::ptrdiff_t>(std::min(static_cast<size_t>(cache.end() - first), free_slots))};
+        _buffers.insert(_buffers.end(), std::make_move_iterator(first), std::make_move_iterator(first + kept));
+    }
+
+    // Beyond the reserved count, freed outside of the lock
+    cache.erase(first, cache.end());
+}
+}
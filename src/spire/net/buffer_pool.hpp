@@ -0,0 +1,45 @@
+#pragma once
+
+#include <spire/core/types.hpp>
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+namespace spire::net {
+// Free list of message buffers, filled during warmup so that the first messages after startup do not pay for
+// allocation. Disabled until `reserve()` is called; any thread may acquire and release afterwards. Every thread keeps
+// a small cache of its own and trades with the shared list in batches, so that the lock is taken once per batch rather
+// than once per message, also when buffers are acquired on room threads and released on IO threads.
+class BufferPool final {
+public:
+    // Allocates `count` buffers of `capacity` bytes and touches every page of them
+    static void reserve(size_t count, size_t capacity);
+
+    // Empty buffer of at least the pooled capacity, newly allocated if the pool ran dry
+    static std::vector<std::byte> acquire();
+    // Buffers grown far beyond the pooled capacity are freed, as is everything beyond the reserved count
+    static void release(std::vector<std::byte>&& buffer);
+
+    // Of the shared list, not counting the buffers cached by threads
+    static size_t size();
+
+private:
+    using Buffers = std::vector<std::vector<std::byte>>;
+
+    struct ThreadCache;
+
+    static ThreadCache& thread_cache();
+    // Moves up to `count` buffers from the shared list into `cache`
+    static void refill(Buffers& cache, size_t count);
+    // Moves the last `count` buffers of `cache` into the shared list, freeing those beyond the reserved count
+    static void spill(Buffers& cache, size_t count);
+
+    inline static std::atomic<bool> _is_enabled {false};
+    inline static size_t _count {0};
+    inline static size_t _capacity {0};
+
+    inline static std::mutex _mutex {};
+    inline static Buffers _buffers {};
+};
+}
@@ -4,7 +4,10 @@
 #include <spire/container/concurrent_queue.hpp>
 #include <spire/net/connection.hpp>
 #include <spire/net/heartbeat.hpp>
+#include <spire/net/loopback_stream.hpp>
 #include <spire/net/message.hpp>
+#include <spire/net/send_batch.hpp>
+#include <spire/net/udp_transport.hpp>
 
 namespace spire::net {
 template <typename SocketType>
@@ -12,10 +15,17 @@ class Client;
 
 using TcpClient = Client<TcpSocket>;
 using SslClient = Client<SslSocket>;
+using LoopbackClient = Client<LoopbackStream>;
 
 template <typename ClientType>
 using MessageQueue = ConcurrentQueue<std::pair<std::shared_ptr<ClientType>, std::unique_ptr<InMessage>>>;
 
+// Process-wide unique across all client types
+inline u64 make_client_id() {
+    static std::atomic<u64> next_id {1};
+    return next_id.fetch_add(1, std::memory_order_relaxed);
+}
+
 
 template <typename SocketType>
 class Client final : public std::enable_shared_from_this<Client<SocketType>>, boost::noncopyable {
@@ -31,7 +41,11 @@ public:
         InvalidInMessage,
         ConnectionError,
         HeartbeatDead,
-        AuthenticationError
+        AuthenticationError,
+        SlowConsumer,
+        Kicked,
+        // Asked to reconnect by a draining server
+        Draining
     };
 
     struct Signals {
@@ -45,21 +59,39 @@ public:
 
     void start();
     void stop(StopCode code);
+    // Stops with `StopCode::Draining` once the messages sent so far have been written,
+    // excluding those still held by a `SendBatch` scope
+    void drain();
 
+    // Reliable messages are held back while a `SendBatch::Scope` is alive on the calling thread
     void send(std::unique_ptr<OutMessage> message);
     void send(std::shared_ptr<OutMessage> message);
+    // Newest-wins delivery over UDP once the datagram session is bound,
+    // otherwise an unreliable TCP message superseding the queued one of the same channel
+    void send_unreliable(DatagramChannel channel, const msg::BaseMessage& body);
+    // See `Connection::take_unsent`
+    void take_unsent(std::function<void(std::vector<std::shared_ptr<OutMessage>>&&)>&& on_taken);
 
     void authenticate();
+    // Called by the room with a heartbeat of the client, answering the last one sent measures `ping()`
+    void on_heartbeat();
+    // Datagrams received through `session` are queued like messages received over TCP
+    void bind_datagram_session(std::shared_ptr<DatagramSession> session);
     Signals bind(
         MessageQueue<Client>* message_queue,
         std::function<void(std::shared_ptr<Client>, StopCode)>&& on_stopped);
 
+    u64 id() const { return _id; }
     State state() const { return _state; }
+    bool is_authenticated() const { return _is_authenticated; }
     milliseconds ping() const { return _ping; }
+    size_t queued_bytes() const { return _connection.queued_bytes(); }
 
 private:
+    const u64 _id {make_client_id()};
     std::atomic<State> _state {State::Idle};
-    bool _is_authenticated {false};
+    // Set by the room thread, read by the IO thread receiving messages
+    std::atomic<bool> _is_authenticated {false};
 
     boost::asio::strand<boost::asio::any_io_executor> _strand;
 
@@ -67,6 +99,9 @@ private:
     std::atomic<MessageQueue<Client>*> _message_queue {};
     Heartbeat _heartbeat;
     std::atomic<milliseconds> _ping {};
+    // Of the last heartbeat sent and not answered yet, the epoch if none is
+    std::atomic<steady_clock::time_point> _heartbeat_sent_at {};
+    std::atomic<std::shared_ptr<DatagramSession>> _datagram_session {};
 
     boost::signals2::signal<void(std::shared_ptr<Client>, StopCode)> _stopped {};
 };
@@ -82,6 +117,7 @@ Client<SocketType>::Client(SocketType&& socket)
               msg::BaseMessage base;
               base.set_allocated_heartbeat(new msg::Heartbeat);
 
+              _heartbeat_sent_at = steady_clock::now();
               send(std::make_unique<OutMessage>(base));
           },
           [this] {
@@ -99,7 +135,23 @@ std::shared_ptr<Client<SocketType>> Client<SocketType>::make(SocketType&& socket
 
     client->_connection.init(
         [self = client->shared_from_this()](const typename Connection<SocketType>::CloseCode code) {
-            self->stop(code == Connection<SocketType>::CloseCode::Normal ? StopCode::Normal : StopCode::ConnectionError);
+            switch (code) {
+            case Connection<SocketType>::CloseCode::Normal:
+                self->stop(StopCode::Normal);
+                break;
+
+            case Connection<SocketType>::CloseCode::SlowConsumer:
+                self->stop(StopCode::SlowConsumer);
+                break;
+
+            case Connection<SocketType>::CloseCode::Draining:
+                self->stop(StopCode::Draining);
+                break;
+
+            default:
+                self->stop(StopCode::ConnectionError);
+                break;
+            }
         },
         [self = client->shared_from_this()](std::vector<std::byte>&& data) {
             if (self->_is_authenticated) {
@@ -129,25 +181,98 @@ void Client<SocketType>::stop(const StopCode code) {
 
     _connection.close(Connection<SocketType>::CloseCode::Normal);
     _heartbeat.stop();
+    if (const auto session {_datagram_session.exchange(nullptr)}) {
+        session->close();
+    }
 
     _stopped(this->shared_from_this(), code);
 }
 
+template <typename SocketType>
+void Client<SocketType>::drain() {
+    if (_state == State::Terminating) return;
+
+    _connection.close_after_flush(Connection<SocketType>::CloseCode::Draining);
+}
+
 template <typename SocketType>
 void Client<SocketType>::send(std::unique_ptr<OutMessage> message) {
-    _connection.send(std::move(message));
+    send(std::shared_ptr<OutMessage> {std::move(message)});
 }
 
 template <typename SocketType>
 void Client<SocketType>::send(std::shared_ptr<OutMessage> message) {
+    if (!message || message->empty()) return;
+
+    // Unreliable messages stay separate so that they can still be collapsed or dropped while queued
+    if (auto* batch {SendBatch::current()}; batch && message->delivery() == OutMessage::Delivery::Reliable) {
+        batch->append(this, std::move(message), [this] {
+            return [self = this->shared_from_this()](std::shared_ptr<OutMessage> merged) {
+                self->_connection.send(std::move(merged));
+            };
+        });
+        return;
+    }
+
     _connection.send(std::move(message));
 }
 
+template <typename SocketType>
+void Client<SocketType>::send_unreliable(const DatagramChannel channel, const msg::BaseMessage& body) {
+    if (const auto session {_datagram_session.load()}; session && session->send(channel, body)) return;
+
+    _connection.send(std::make_shared<OutMessage>(body, OutMessage::Delivery::Unreliable, collapse_key(channel)));
+}
+
+template <typename SocketType>
+void Client<SocketType>::take_unsent(std::function<void(std::vector<std::shared_ptr<OutMessage>>&&)>&& on_taken) {
+    // Keeps the connection alive until its strand ran the callback
+    _connection.take_unsent(
+        [self = this->shared_from_this(), on_taken = std::move(on_taken)](
+            std::vector<std::shared_ptr<OutMessage>>&& unsent) {
+            on_taken(std::move(unsent));
+        });
+}
+
 template <typename SocketType>
 void Client<SocketType>::authenticate() {
     _is_authenticated = true;
 }
 
+template <typename SocketType>
+void Client<SocketType>::on_heartbeat() {
+    // Includes the time the heartbeat waited for the update of the room
+    const auto sent_at {_heartbeat_sent_at.exchange({})};
+    if (sent_at == steady_clock::time_point {}) return;
+
+    _ping = duration_cast<milliseconds>(steady_clock::now() - sent_at);
+}
+
+template <typename SocketType>
+void Client<SocketType>::bind_datagram_session(std::shared_ptr<DatagramSession> session) {
+    if (!session) return;
+
+    session->init([weak_self = this->weak_from_this()](std::vector<std::byte>&& data) {
+        const auto self {weak_self.lock()};
+        if (!self) return;
+
+        const auto message_queue {self->_message_queue.load()};
+        if (!message_queue) return;
+        message_queue->push(std::make_pair(self, std::make_unique<InMessage>(std::move(data))));
+    });
+
+    if (const auto previous {_datagram_session.exchange(std::move(session))}) {
+        previous->close();
+    }
+
+    // Stopped concurrently, `stop()` may have missed the session
+    if (_state == State::Terminating) {
+        if (const auto bound {_datagram_session.exchange(nullptr)}) {
+            bound->close();
+        }
+    }
+}
+
 template <typename SocketType>
 typename Client<SocketType>::Signals Client<SocketType>::bind(
     MessageQueue<Client>* message_queue,
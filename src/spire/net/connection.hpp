@@ -3,12 +3,45 @@
 #include <boost/asio.hpp>
 #include <boost/asio/ssl.hpp>
 #include <boost/core/noncopyable.hpp>
+#include <spire/core/metrics.hpp>
+#include <spire/core/settings.hpp>
 #include <spire/net/message.hpp>
+#include <spire/net/socket_tuning.hpp>
+
+#include <concepts>
+#include <deque>
+#include <optional>
+#include <unordered_map>
 
 namespace spire::net {
 using TcpSocket = boost::asio::ip::tcp::socket;
 using SslSocket = boost::asio::ssl::stream<boost::asio::ip::tcp::socket>;
 
+struct ConnectionMetrics {
+    using Metrics = metrics::Metrics;
+
+    metrics::Counter& sent_bytes {Metrics::counter("spire_net_sent_bytes_total", "Bytes written to sockets")};
+    metrics::Counter& received_bytes {Metrics::counter("spire_net_received_bytes_total", "Bytes read from sockets")};
+    metrics::Counter& sent_frames {Metrics::counter("spire_net_sent_frames_total", "Frames written to sockets")};
+    metrics::Counter& received_frames {Metrics::counter("spire_net_received_frames_total", "Frames read from sockets")};
+    metrics::Counter& socket_writes {Metrics::counter("spire_net_socket_writes_total", "Completed socket writes")};
+    metrics::Counter& socket_reads {Metrics::counter("spire_net_socket_reads_total", "Completed socket reads")};
+
+    metrics::Counter& slow_consumers {
+        Metrics::counter("spire_net_slow_consumers_total", "Connections that crossed the send queue high watermark")};
+    metrics::Counter& slow_consumer_disconnects {
+        Metrics::counter("spire_net_slow_consumer_disconnects_total", "Connections closed for exceeding the send queue limit")};
+    metrics::Counter& dropped_messages {
+        Metrics::counter("spire_net_dropped_messages_total", "Unreliable messages dropped by congested connections")};
+    metrics::Counter& collapsed_messages {
+        Metrics::counter("spire_net_collapsed_messages_total", "Queued unreliable messages superseded by newer ones")};
+};
+
+inline ConnectionMetrics& connection_metrics() {
+    static ConnectionMetrics metrics {};
+    return metrics;
+}
+
 
 template <typename SocketType>
 class Connection final : boost::noncopyable {
@@ -16,7 +49,9 @@ public:
     enum class CloseCode : u8 {
         Normal,
         ReceiveError,
-        SendError
+        SendError,
+        SlowConsumer,
+        Draining
     };
 
     explicit Connection(SocketType&& socket);
@@ -27,12 +62,30 @@ public:
         std::function<void(std::vector<std::byte>&&)>&& on_received);
     void open();
     void close(CloseCode code);
+    // Closes once everything queued before and after this call has been written
+    void close_after_flush(CloseCode code);
 
     void send(std::unique_ptr<OutMessage> message);
     void send(std::shared_ptr<OutMessage> message);
+    // Hands the reliable messages that were never written to the socket to `on_taken`, for replaying them
+    // on another connection. Only meaningful once closed, as the send queue keeps draining while open.
+    void take_unsent(std::function<void(std::vector<std::shared_ptr<OutMessage>>&&)>&& on_taken);
+
+    size_t queued_bytes() const { return _queued_bytes; }
 
 private:
+    static constexpr size_t MAX_WRITE_BATCH {64};
+
     boost::asio::awaitable<void> receive();
+    boost::asio::awaitable<void> receive_extended();
+    // Delivers every frame packed in a container body, false if any is malformed
+    bool receive_container(std::span<const std::byte> frames);
+    // Closes the connection on failure
+    boost::asio::awaitable<bool> read(boost::asio::mutable_buffer buffer);
+    // Applies TCP_QUICKACK again if the listener of the socket is tuned with it
+    void rearm_quick_ack();
+    void enqueue(std::shared_ptr<OutMessage> message);
+    boost::asio::awaitable<void> flush();
 
     boost::asio::strand<boost::asio::any_io_executor> _strand;
     SocketType _socket;
@@ -40,6 +93,14 @@ private:
 
     std::atomic<bool> _is_open {false};
 
+    // Only accessed on `_strand`
+    std::deque<std::shared_ptr<OutMessage>> _send_queue {};
+    std::unordered_map<u32, std::shared_ptr<OutMessage>*> _collapsible {};
+    bool _is_sending {false};
+    bool _is_congested {false};
+    std::optional<CloseCode> _close_after_flush {};
+    std::atomic<size_t> _queued_bytes {0};
+
     std::function<void(CloseCode)> _on_closed;
     std::function<void(std::vector<std::byte>&&)> _on_received;
 };
@@ -90,57 +151,267 @@ void Connection<SocketType>::close(const CloseCode code) {
 }
 
 template <typename SocketType>
-void Connection<SocketType>::send(std::unique_ptr<OutMessage> message) {
-    if (!message || message->empty()) return;
+void Connection<SocketType>::close_after_flush(const CloseCode code) {
+    post(_strand, [this, code] {
+        if (_is_sending) {
+            _close_after_flush = code;
+            return;
+        }
 
-    co_spawn(_strand, [this, message = std::move(message)] -> boost::asio::awaitable<void> {
-        if (!_is_open) co_return;
+        close(code);
+    });
+}
 
-        const auto [ec, _] = co_await async_write(
-            _socket, message->span(), boost::asio::as_tuple(boost::asio::use_awaitable));
-        if (ec) close(ec == boost::asio::error::eof ? CloseCode::Normal : CloseCode::SendError);
-    }, boost::asio::detached);
+template <typename SocketType>
+void Connection<SocketType>::send(std::unique_ptr<OutMessage> message) {
+    send(std::shared_ptr<OutMessage> {std::move(message)});
 }
 
 template <typename SocketType>
 void Connection<SocketType>::send(std::shared_ptr<OutMessage> message) {
     if (!message || message->empty()) return;
 
-    co_spawn(_strand, [this, message = std::move(message)] -> boost::asio::awaitable<void> {
-        if (!_is_open) co_return;
+    post(_strand, [this, message = std::move(message)] mutable {
+        enqueue(std::move(message));
+    });
+}
+
+template <typename SocketType>
+void Connection<SocketType>::take_unsent(
+    std::function<void(std::vector<std::shared_ptr<OutMessage>>&&)>&& on_taken) {
+    post(_strand, [this, on_taken = std::move(on_taken)] {
+        std::vector<std::shared_ptr<OutMessage>> unsent;
+        unsent.reserve(_send_queue.size());
+        for (auto& message : _send_queue) {
+            _queued_bytes -= message->size();
+            // Unreliable messages are superseded state by the time they could be replayed
+            if (message->delivery() == OutMessage::Delivery::Reliable) {
+                unsent.push_back(std::move(message));
+            }
+        }
+        _send_queue.clear();
+        _collapsible.clear();
 
-        const auto [ec, _] = co_await async_write(
-            _socket, message->span(), boost::asio::as_tuple(boost::asio::use_awaitable));
-        if (ec) close(ec == boost::asio::error::eof ? CloseCode::Normal : CloseCode::SendError);
-    }, boost::asio::detached);
+        on_taken(std::move(unsent));
+    });
 }
 
 template <typename SocketType>
-boost::asio::awaitable<void> Connection<SocketType>::receive() {
-    std::array<std::byte, sizeof(MessageHeader)> header_buffer {};
-    if (const auto [ec, _] = co_await async_read(
-        _socket,
-        boost::asio::buffer(header_buffer),
-        boost::asio::as_tuple(boost::asio::use_awaitable)); ec) {
-        close(ec == boost::asio::error::eof ? CloseCode::Normal : CloseCode::ReceiveError);
-        co_return;
+void Connection<SocketType>::enqueue(std::shared_ptr<OutMessage> message) {
+    if (!_is_open) return;
+
+    if (message->delivery() == OutMessage::Delivery::Unreliable) {
+        if (const auto it {_collapsible.find(message->collapse_key())}; it != _collapsible.end()) {
+            // Replace the superseded update in place, keeping its position in the queue
+            auto& queued {*it->second};
+            _queued_bytes += message->size();
+            _queued_bytes -= queued->size();
+            queued = std::move(message);
+            connection_metrics().collapsed_messages.add();
+            return;
+        }
+
+        if (_is_congested) {
+            connection_metrics().dropped_messages.add();
+            return;
+        }
+    }
+
+    _queued_bytes += message->size();
+    auto& queued {_send_queue.emplace_back(std::move(message))};
+    if (queued->delivery() == OutMessage::Delivery::Unreliable && queued->collapse_key() != 0) {
+        _collapsible[queued->collapse_key()] = &queued;
+    }
+
+    if (const auto limit {Settings::send_queue_limit()}; limit != 0 && _queued_bytes > limit) {
+        connection_metrics().slow_consumer_disconnects.add();
+        close(CloseCode::SlowConsumer);
+        return;
     }
 
+    if (!_is_congested && _queued_bytes >= Settings::send_queue_high_watermark()) {
+        _is_congested = true;
+        connection_metrics().slow_consumers.add();
+    }
+
+    if (_is_sending) return;
+    _is_sending = true;
+
+    co_spawn(_strand, flush(), boost::asio::detached);
+}
+
+template <typename SocketType>
+boost::asio::awaitable<void> Connection<SocketType>::flush() {
+    std::vector<std::shared_ptr<OutMessage>> batch;
+    std::vector<boost::asio::const_buffer> buffers;
+    batch.reserve(MAX_WRITE_BATCH);
+    buffers.reserve(MAX_WRITE_BATCH);
+
+    while (_is_open && !_send_queue.empty()) {
+        size_t batch_bytes {0};
+
+        // Gather queued messages into a single write
+        while (!_send_queue.empty() && batch.size() < MAX_WRITE_BATCH) {
+            auto& message {_send_queue.front()};
+            if (const auto it {_collapsible.find(message->collapse_key())};
+                it != _collapsible.end() && it->second == &message) {
+                _collapsible.erase(it);
+            }
+
+            buffers.emplace_back(message->span().data(), message->size());
+            batch_bytes += message->size();
+            batch.push_back(std::move(message));
+            _send_queue.pop_front();
+        }
+
+        const auto [ec, _] = co_await async_write(_socket, buffers, boost::asio::as_tuple(boost::asio::use_awaitable));
+        _queued_bytes -= batch_bytes;
+
+        auto& metrics {connection_metrics()};
+        metrics.socket_writes.add();
+        if (!ec) {
+            metrics.sent_frames.add(batch.size());
+            metrics.sent_bytes.add(batch_bytes);
+        }
+
+        batch.clear();
+        buffers.clear();
+
+        if (ec) {
+            _is_sending = false;
+            close(ec == boost::asio::error::eof ? CloseCode::Normal : CloseCode::SendError);
+            co_return;
+        }
+
+        if (_is_congested && _queued_bytes <= Settings::send_queue_low_watermark()) {
+            _is_congested = false;
+        }
+    }
+
+    _is_sending = false;
+
+    if (_close_after_flush) {
+        close(*_close_after_flush);
+    }
+}
+
+template <typename SocketType>
+boost::asio::awaitable<void> Connection<SocketType>::receive() {
+    std::array<std::byte, MessageHeader::SIZE> header_buffer {};
+    if (!co_await read(boost::asio::buffer(header_buffer))) co_return;
+
     auto [body_size] {MessageHeader::deserialize(header_buffer)};
     if (body_size == 0) {
         close(CloseCode::ReceiveError);
         co_return;
     }
 
+    if (body_size == MessageHeader::EXTENDED) {
+        co_await receive_extended();
+        co_return;
+    }
+
     std::vector<std::byte> body_buffer(body_size);
-    if (const auto [ec, _] = co_await async_read(
-        _socket,
-        boost::asio::buffer(body_buffer),
-        boost::asio::as_tuple(boost::asio::use_awaitable)); ec) {
-        close(ec == boost::asio::error::eof ? CloseCode::Normal : CloseCode::ReceiveError);
+    if (!co_await read(boost::asio::buffer(body_buffer))) co_return;
+
+    auto& metrics {connection_metrics()};
+    metrics.socket_reads.add(2);
+    metrics.received_frames.add();
+    metrics.received_bytes.add(header_buffer.size() + body_buffer.size());
+
+    rearm_quick_ack();
+    _on_received(std::move(body_buffer));
+}
+
+template <typename SocketType>
+boost::asio::awaitable<void> Connection<SocketType>::receive_extended() {
+    std::array<std::byte, ExtendedHeader::SIZE> header_buffer {};
+    if (!co_await read(boost::asio::buffer(header_buffer))) co_return;
+
+    const auto header {ExtendedHeader::deserialize(header_buffer)};
+    if (!header.is_valid()) {
+        close(CloseCode::ReceiveError);
+        co_return;
+    }
+
+    std::vector<std::byte> body_buffer(header.body_size);
+    if (!co_await read(boost::asio::buffer(body_buffer))) co_return;
+
+    auto& metrics {connection_metrics()};
+    metrics.socket_reads.add(3);
+    metrics.received_frames.add();
+    metrics.received_bytes.add(MessageHeader::SIZE + header_buffer.size() + body_buffer.size());
+
+    rearm_quick_ack();
+
+    if (!header.decode(body_buffer)) {
+        close(CloseCode::ReceiveError);
+        co_return;
+    }
+
+    if (header.flags & ExtendedHeader::Container) {
+        if (!receive_container(body_buffer)) {
+            close(CloseCode::ReceiveError);
+        }
         co_return;
     }
 
     _on_received(std::move(body_buffer));
 }
+
+template <typename SocketType>
+bool Connection<SocketType>::receive_container(std::span<const std::byte> frames) {
+    while (!frames.empty()) {
+        if (frames.size() < MessageHeader::SIZE) return false;
+
+        const auto [body_size] {MessageHeader::deserialize(frames.template first<MessageHeader::SIZE>())};
+        frames = frames.subspan(MessageHeader::SIZE);
+        if (body_size == 0) return false;
+
+        if (body_size != MessageHeader::EXTENDED) {
+            if (frames.size() < body_size) return false;
+
+            _on_received(std::vector<std::byte> {frames.begin(), frames.begin() + body_size});
+            frames = frames.subspan(body_size);
+            continue;
+        }
+
+        if (frames.size() < ExtendedHeader::SIZE) return false;
+
+        const auto header {ExtendedHeader::deserialize(frames.template first<ExtendedHeader::SIZE>())};
+        frames = frames.subspan(ExtendedHeader::SIZE);
+        if (!header.is_valid() || header.flags & ExtendedHeader::Container || frames.size() < header.body_size)
+            return false;
+
+        std::vector<std::byte> body {frames.begin(), frames.begin() + header.body_size};
+        frames = frames.subspan(header.body_size);
+        if (!header.decode(body)) return false;
+
+        _on_received(std::move(body));
+    }
+
+    return true;
+}
+
+template <typename SocketType>
+boost::asio::awaitable<bool> Connection<SocketType>::read(const boost::asio::mutable_buffer buffer) {
+    const auto [ec, _] = co_await async_read(_socket, buffer, boost::asio::as_tuple(boost::asio::use_awaitable));
+    if (ec) {
+        close(ec == boost::asio::error::eof ? CloseCode::Normal : CloseCode::ReceiveError);
+        co_return false;
+    }
+
+    co_return true;
+}
+
+template <typename SocketType>
+void Connection<SocketType>::rearm_quick_ack() {
+    // Game sockets are plain TCP and admin sockets TLS, loopback streams have no kernel socket
+    if constexpr (std::same_as<SocketType, TcpSocket>) {
+        if (Settings::game_socket_tuning().quick_ack) net::rearm_quick_ack(_socket);
+    }
+    else if constexpr (std::same_as<SocketType, SslSocket>) {
+        if (Settings::admin_socket_tuning().quick_ack) net::rearm_quick_ack(_socket.next_layer());
+    }
+}
 }
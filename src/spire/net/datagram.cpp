@@ -0,0 +1,74 @@
+#include <openssl/crypto.h>
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
+#include <spire/net/datagram.hpp>
+
+#include <bit>
+#include <cstring>
+
+namespace spire::net {
+template <typename T>
+static T to_network_order(T value) {
+    if constexpr (std::endian::native == std::endian::little)
+        value = std::byteswap(value);
+
+    return value;
+}
+
+void DatagramHeader::serialize(const DatagramHeader& source, std::span<std::byte, SIZE> target) {
+    const u64 session_token {to_network_order(source.session_token)};
+    const u32 sequence {to_network_order(source.sequence)};
+
+    std::memcpy(target.data(), &session_token, sizeof(session_token));
+    target[sizeof(session_token)] = static_cast<std::byte>(source.channel);
+    std::memcpy(target.data() + sizeof(session_token) + sizeof(channel), &sequence, sizeof(sequence));
+}
+
+std::optional<DatagramHeader> DatagramHeader::deserialize(const std::span<const std::byte, SIZE> source) {
+    u64 session_token;
+    u32 sequence;
+    std::memcpy(&session_token, source.data(), sizeof(session_token));
+    const auto channel {std::to_integer<u8>(source[sizeof(session_token)])};
+    std::memcpy(&sequence, source.data() + sizeof(session_token) + sizeof(channel), sizeof(sequence));
+
+    if (channel >= DATAGRAM_CHANNEL_COUNT) return std::nullopt;
+
+    return DatagramHeader {
+        .session_token = to_network_order(session_token),
+        .channel = static_cast<DatagramChannel>(channel),
+        .sequence = to_network_order(sequence),
+    };
+}
+
+using Digest = std::array<unsigned char, EVP_MAX_MD_SIZE>;
+
+static void digest_datagram(const std::span<const std::byte> data, const DatagramKey& key, Digest& digest) {
+    unsigned int size {0};
+    HMAC(
+        EVP_sha256(),
+        key.data(),
+        static_cast<int>(key.size()),
+        reinterpret_cast<const unsigned char*>(data.data()),
+        data.size(),
+        digest.data(),
+        &size);
+}
+
+void sign_datagram(const std::span<std::byte> datagram, const DatagramKey& key) {
+    const auto data_size {datagram.size() - DATAGRAM_TAG_SIZE};
+
+    Digest digest;
+    digest_datagram(datagram.first(data_size), key, digest);
+    std::memcpy(datagram.data() + data_size, digest.data(), DATAGRAM_TAG_SIZE);
+}
+
+bool verify_datagram(const std::span<const std::byte> datagram, const DatagramKey& key) {
+    if (datagram.size() < DATAGRAM_TAG_SIZE) return false;
+
+    const auto data_size {datagram.size() - DATAGRAM_TAG_SIZE};
+
+    Digest digest;
+    digest_datagram(datagram.first(data_size), key, digest);
+    return CRYPTO_memcmp(digest.data(), datagram.data() + data_size, DATAGRAM_TAG_SIZE) == 0;
+}
+}
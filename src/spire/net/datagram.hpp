@@ -0,0 +1,55 @@
+#pragma once
+
+#include <spire/core/types.hpp>
+
+#include <array>
+#include <optional>
+#include <span>
+#include <utility>
+
+namespace spire::net {
+enum class DatagramChannel : u8 {
+    Movement,
+    Snapshot,
+    Count
+};
+
+static constexpr size_t DATAGRAM_CHANNEL_COUNT {std::to_underlying(DatagramChannel::Count)};
+
+// Kept below common path MTUs so datagrams are never fragmented
+static constexpr size_t MAX_DATAGRAM_SIZE {1200};
+
+// Ends every datagram, a truncated HMAC-SHA256 of the rest keyed by the session. The token only names the session, so
+// that a sender who learns or guesses it still cannot inject into the session or rebind its endpoint.
+static constexpr size_t DATAGRAM_TAG_SIZE {16};
+static constexpr size_t DATAGRAM_KEY_SIZE {32};
+using DatagramKey = std::array<std::byte, DATAGRAM_KEY_SIZE>;
+
+// Prefixes every datagram. Sequences count per session and channel, receivers keep only the newest.
+struct DatagramHeader {
+    u64 session_token;
+    DatagramChannel channel;
+    u32 sequence;
+
+    static constexpr size_t SIZE {sizeof(session_token) + sizeof(channel) + sizeof(sequence)};
+
+    static void serialize(const DatagramHeader& source, std::span<std::byte, SIZE> target);
+    // Empty if the channel is unknown
+    static std::optional<DatagramHeader> deserialize(std::span<const std::byte, SIZE> source);
+};
+
+// Writes the tag of the bytes before the last `DATAGRAM_TAG_SIZE` of `datagram` into them
+void sign_datagram(std::span<std::byte> datagram, const DatagramKey& key);
+// False if `datagram` is too short to hold a tag or its tag does not match, compared in constant time
+bool verify_datagram(std::span<const std::byte> datagram, const DatagramKey& key);
+
+// Serial number arithmetic (RFC 1982), so ordering holds across wraparound
+constexpr bool is_newer_sequence(const u32 sequence, const u32 last) {
+    return sequence != last && static_cast<u32>(sequence - last) < (u32 {1} << 31);
+}
+
+// Collapse key of the unreliable TCP fallback of a channel, the upper half of the key space is reserved for channels
+constexpr u32 collapse_key(const DatagramChannel channel) {
+    return (u32 {1} << 31) | std::to_underlying(channel);
+}
+}
@@ -1,24 +1,29 @@
+#include <spire/core/metrics.hpp>
 #include <spire/core/settings.hpp>
 #include <spire/net/heartbeat.hpp>
 
 namespace spire::net {
 Heartbeat::Heartbeat(
     const boost::asio::any_io_executor& executor,
-    std::function<void()>&& on_retry,
+    std::function<void()>&& on_beat,
     std::function<void()>&& on_dead)
     : _timer {executor, Settings::heartbeat_interval()},
-    _on_retry {std::move(on_retry)},
+    _on_beat {std::move(on_beat)},
     _on_dead {std::move(on_dead)} {
     _timer.add_timeout_callback([this] {
-        if (steady_clock::now() <= _last_retry + Settings::heartbeat_interval()) return;
+        // Active clients are sent heartbeats as well, so that their ping is measured
+        if (Clock::now() > _last_reset + Settings::heartbeat_interval() &&
+            ++_retries >= Settings::heartbeat_retries()) {
+            static auto& deaths {metrics::Metrics::counter(
+                "spire_net_heartbeat_deaths_total", "Clients stopped for missing heartbeats")};
+            deaths.add();
 
-        if (++_retries >= Settings::heartbeat_retries()) {
             stop();
             _on_dead();
             return;
         }
 
-        _on_retry();
+        _on_beat();
     });
 }
 
@@ -32,7 +37,7 @@ void Heartbeat::stop() {
 }
 
 void Heartbeat::reset() {
-    _last_retry = steady_clock::now();
+    _last_reset = Clock::now();
     _retries = 0;
 }
 }
@@ -5,11 +5,13 @@
 #include <spire/core/types.hpp>
 
 namespace spire::net {
+// Calls `on_beat` every `heartbeat_interval`, whose answer measures the ping, and `on_dead` once nothing reset it
+// for `heartbeat_retries` intervals
 class Heartbeat final : boost::noncopyable {
 public:
     Heartbeat(
         const boost::asio::any_io_executor& executor,
-        std::function<void()>&& on_retry,
+        std::function<void()>&& on_beat,
         std::function<void()>&& on_dead);
 
     void start();
@@ -19,10 +21,10 @@ public:
 
 private:
     Timer _timer;
-    steady_clock::time_point _last_retry {};
+    Clock::time_point _last_reset {};
     u32 _retries {0};
 
-    std::function<void()> _on_retry;
+    std::function<void()> _on_beat;
     std::function<void()> _on_dead;
 };
 }
\ No newline at end of file
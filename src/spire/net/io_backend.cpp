@@ -0,0 +1,45 @@
+#include <spdlog/spdlog.h>
+#include <spire/net/io_backend.hpp>
+#include <unistd.h>
+
+#ifdef BOOST_ASIO_HAS_IO_URING
+#include <liburing.h>
+#endif
+
+#include <cstring>
+#include <filesystem>
+
+namespace spire::net {
+std::string_view io_backend_name() {
+#ifdef BOOST_ASIO_HAS_IO_URING
+    return "io_uring";
+#else
+    return "epoll";
+#endif
+}
+
+bool is_io_uring_supported() {
+#ifdef BOOST_ASIO_HAS_IO_URING
+    io_uring ring {};
+    if (io_uring_queue_init(8, &ring, 0) != 0) return false;
+
+    io_uring_queue_exit(&ring);
+    return true;
+#else
+    return false;
+#endif
+}
+
+void exec_epoll_server(char* argv[]) {
+    std::error_code ec;
+    const auto executable {std::filesystem::read_symlink("/proc/self/exe", ec)};
+    if (ec) {
+        spdlog::error("Could not locate the running executable: {}", ec.message());
+        return;
+    }
+
+    const auto epoll_server {executable.parent_path() / EPOLL_SERVER_NAME};
+    execv(epoll_server.c_str(), argv);
+    spdlog::error("Could not execute {}: {}", epoll_server.string(), std::strerror(errno));
+}
+}
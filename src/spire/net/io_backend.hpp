@@ -0,0 +1,18 @@
+#pragma once
+
+#include <string_view>
+
+namespace spire::net {
+// Of the executable built with the epoll reactor, which io_uring builds ship next to theirs
+static constexpr std::string_view EPOLL_SERVER_NAME {"server"};
+
+// Reactor Asio was built with, `server_io_uring` of a `SPIRE_USE_IO_URING` build uses io_uring
+std::string_view io_backend_name();
+
+// Whether the kernel permits io_uring, which may be disabled by sysctl, seccomp or container runtimes.
+// Always false when built without io_uring.
+bool is_io_uring_supported();
+// Replaces this process with the epoll server in the directory of its executable, passing `argv` on.
+// Returns only if that fails.
+void exec_epoll_server(char* argv[]);
+}
\ No newline at end of file
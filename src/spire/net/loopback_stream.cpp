@@ -0,0 +1,101 @@
+#include <spire/net/loopback_stream.hpp>
+
+namespace spire::net {
+std::pair<LoopbackStream, LoopbackStream> LoopbackStream::make_pair(
+    const executor_type& executor,
+    const LoopbackLink link) {
+    return make_pair(executor, executor, link);
+}
+
+std::pair<LoopbackStream, LoopbackStream> LoopbackStream::make_pair(
+    const executor_type& first_executor,
+    const executor_type& second_executor,
+    const LoopbackLink link) {
+    auto first_to_second {std::make_shared<Pipe>(second_executor, link)};
+    auto second_to_first {std::make_shared<Pipe>(first_executor, link)};
+
+    return std::make_pair(
+        LoopbackStream {first_executor, second_to_first, first_to_second},
+        LoopbackStream {second_executor, first_to_second, second_to_first});
+}
+
+LoopbackStream::LoopbackStream(const executor_type& executor, std::shared_ptr<Pipe> in, std::shared_ptr<Pipe> out)
+    : _executor {executor}, _in {std::move(in)}, _out {std::move(out)} {}
+
+// The executor is copied rather than moved, a moved-from stream still reports it like sockets do
+LoopbackStream::LoopbackStream(LoopbackStream&& other) noexcept
+    : _executor {other._executor}, _in {std::move(other._in)}, _out {std::move(other._out)} {}
+
+LoopbackStream& LoopbackStream::operator=(LoopbackStream&& other) noexcept {
+    if (this == &other) return *this;
+
+    boost::system::error_code ec;
+    close(ec);
+
+    _executor = other._executor;
+    _in = std::move(other._in);
+    _out = std::move(other._out);
+
+    return *this;
+}
+
+LoopbackStream::~LoopbackStream() {
+    boost::system::error_code ec;
+    close(ec);
+}
+
+bool LoopbackStream::is_open() const {
+    if (!_in) return false;
+
+    std::lock_guard lock {_in->mutex};
+    return !_in->is_read_closed;
+}
+
+void LoopbackStream::cancel(boost::system::error_code& ec) {
+    ec = {};
+    if (!_in) return;
+
+    std::lock_guard lock {_in->mutex};
+    if (!_in->is_reading) return;
+
+    _in->is_read_cancelled = true;
+    _in->wake_reader();
+}
+
+void LoopbackStream::shutdown(const boost::asio::socket_base::shutdown_type type, boost::system::error_code& ec) {
+    ec = {};
+    if (!_in || !_out) {
+        ec = boost::asio::error::bad_descriptor;
+        return;
+    }
+
+    if (type != boost::asio::socket_base::shutdown_receive) {
+        std::lock_guard lock {_out->mutex};
+        _out->is_write_closed = true;
+        _out->wake_reader();
+    }
+
+    if (type != boost::asio::socket_base::shutdown_send) {
+        std::lock_guard lock {_in->mutex};
+        _in->is_read_closed = true;
+        _in->chunks.clear();
+        _in->wake_reader();
+    }
+}
+
+void LoopbackStream::close(boost::system::error_code& ec) {
+    ec = {};
+    if (!_in || !_out) return;
+
+    shutdown(boost::asio::socket_base::shutdown_both, ec);
+}
+
+LoopbackStream::Pipe::Pipe(const executor_type& reader_executor, const LoopbackLink link)
+    : link {link}, reader_wakeup {reader_executor} {}
+
+void LoopbackStream::Pipe::wake_reader() {
+    if (!is_reading) return;
+
+    reader_wakeup.cancel();
+}
+}
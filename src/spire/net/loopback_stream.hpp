@@ -0,0 +1,204 @@
+#pragma once
+
+#include <boost/asio.hpp>
+#include <spire/core/clock.hpp>
+#include <spire/core/types.hpp>
+
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace spire::net {
+// Conditions applied to each direction of a loopback link
+struct LoopbackLink {
+    nanoseconds latency {0};
+    // Bytes per second, 0 for unlimited
+    u64 bandwidth {0};
+};
+
+
+// In-memory duplex stream satisfying AsyncReadStream and AsyncWriteStream, so connections, clients and rooms
+// can be driven end-to-end without sockets. Delivery times follow `Clock`, so they are deterministic under virtual time.
+class LoopbackStream final {
+public:
+    using executor_type = boost::asio::any_io_executor;
+    using lowest_layer_type = LoopbackStream;
+
+    static std::pair<LoopbackStream, LoopbackStream> make_pair(const executor_type& executor, LoopbackLink link = {});
+    static std::pair<LoopbackStream, LoopbackStream> make_pair(
+        const executor_type& first_executor,
+        const executor_type& second_executor,
+        LoopbackLink link = {});
+
+    LoopbackStream(LoopbackStream&& other) noexcept;
+    LoopbackStream& operator=(LoopbackStream&& other) noexcept;
+    LoopbackStream(const LoopbackStream&) = delete;
+    LoopbackStream& operator=(const LoopbackStream&) = delete;
+    ~LoopbackStream();
+
+    executor_type get_executor() const { return _executor; }
+    LoopbackStream& lowest_layer() { return *this; }
+
+    bool is_open() const;
+    // Aborts the pending read with `operation_aborted`
+    void cancel(boost::system::error_code& ec);
+    void shutdown(boost::asio::socket_base::shutdown_type type, boost::system::error_code& ec);
+    void close(boost::system::error_code& ec);
+
+    template <typename MutableBufferSequence, typename ReadToken>
+    auto async_read_some(const MutableBufferSequence& buffers, ReadToken&& token);
+    template <typename ConstBufferSequence, typename WriteToken>
+    auto async_write_some(const ConstBufferSequence& buffers, WriteToken&& token);
+
+private:
+    struct Chunk {
+        Clock::time_point deliver_at;
+        std::vector<std::byte> data;
+        size_t offset {0};
+    };
+
+    // One direction of the link, written by one end and read by the other
+    struct Pipe {
+        Pipe(const executor_type& reader_executor, LoopbackLink link);
+
+        // Both require `mutex` to be held
+        template <typename MutableBufferSequence>
+        size_t read(const MutableBufferSequence& buffers, Clock::time_point now);
+        void wake_reader();
+
+        std::mutex mutex {};
+        const LoopbackLink link;
+
+        std::deque<Chunk> chunks {};
+        // When the link finishes transmitting the queued chunks
+        Clock::time_point link_free {};
+
+        bool is_reading {false};
+        bool is_read_cancelled {false};
+        bool is_read_closed {false};
+        // The reader sees end of file once the queued chunks are drained
+        bool is_write_closed {false};
+
+        // Expires at the next delivery, or is cancelled on new data to wake the pending read
+        ClockTimer reader_wakeup;
+    };
+
+    LoopbackStream(const executor_type& executor, std::shared_ptr<Pipe> in, std::shared_ptr<Pipe> out);
+
+    template <typename ConstBufferSequence>
+    static boost::system::error_code write(Pipe& pipe, const ConstBufferSequence& buffers);
+
+    executor_type _executor;
+    std::shared_ptr<Pipe> _in;
+    std::shared_ptr<Pipe> _out;
+};
+
+
+template <typename MutableBufferSequence, typename ReadToken>
+auto LoopbackStream::async_read_some(const MutableBufferSequence& buffers, ReadToken&& token) {
+    return boost::asio::async_compose<ReadToken, void(boost::system::error_code, size_t)>(
+        [pipe = _in, buffers, is_started = false](auto& self, boost::system::error_code = {}) mutable {
+            // Never complete from within the initiating function
+            if (!is_started) {
+                is_started = true;
+                boost::asio::post(std::move(self));
+                return;
+            }
+
+            std::unique_lock lock {pipe->mutex};
+
+            const auto complete {[&](const boost::system::error_code ec, const size_t size) {
+                pipe->is_reading = false;
+                lock.unlock();
+                self.complete(ec, size);
+            }};
+
+            if (pipe->is_read_closed) return complete(boost::asio::error::bad_descriptor, 0);
+            if (std::exchange(pipe->is_read_cancelled, false)) return complete(boost::asio::error::operation_aborted, 0);
+
+            if (const auto size {pipe->read(buffers, Clock::now())}; size != 0 || boost::asio::buffer_size(buffers) == 0) {
+                return complete({}, size);
+            }
+
+            if (pipe->chunks.empty() && pipe->is_write_closed) return complete(boost::asio::error::eof, 0);
+
+            // Wait for the next delivery, a new chunk or cancellation, whichever comes first
+            pipe->is_reading = true;
+            pipe->reader_wakeup.expires_at(
+                pipe->chunks.empty() ? Clock::time_point::max() : pipe->chunks.front().deliver_at);
+            pipe->reader_wakeup.async_wait(std::move(self));
+        },
+        token,
+        _executor);
+}
+
+template <typename ConstBufferSequence, typename WriteToken>
+auto LoopbackStream::async_write_some(const ConstBufferSequence& buffers, WriteToken&& token) {
+    return boost::asio::async_compose<WriteToken, void(boost::system::error_code, size_t)>(
+        [pipe = _out, buffers, result = std::optional<boost::system::error_code> {}](auto& self) mutable {
+            // Writes are buffered at once, their completion is posted like a socket write into a free send buffer
+            if (!result) {
+                result = pipe ? write(*pipe, buffers) : boost::asio::error::bad_descriptor;
+                boost::asio::post(std::move(self));
+                return;
+            }
+
+            self.complete(*result, *result ? 0 : boost::asio::buffer_size(buffers));
+        },
+        token,
+        _executor);
+}
+
+template <typename MutableBufferSequence>
+size_t LoopbackStream::Pipe::read(const MutableBufferSequence& buffers, const Clock::time_point now) {
+    size_t total {0};
+
+    for (auto it {boost::asio::buffer_sequence_begin(buffers)}; it != boost::asio::buffer_sequence_end(buffers); ++it) {
+        boost::asio::mutable_buffer target {*it};
+
+        while (target.size() != 0 && !chunks.empty() && chunks.front().deliver_at <= now) {
+            auto& chunk {chunks.front()};
+            const auto size {boost::asio::buffer_copy(target, boost::asio::buffer(chunk.data) + chunk.offset)};
+            chunk.offset += size;
+            target += size;
+            total += size;
+
+            if (chunk.offset == chunk.data.size()) {
+                chunks.pop_front();
+            }
+        }
+    }
+
+    return total;
+}
+
+template <typename ConstBufferSequence>
+boost::system::error_code LoopbackStream::write(Pipe& pipe, const ConstBufferSequence& buffers) {
+    std::vector<std::byte> data(boost::asio::buffer_size(buffers));
+    boost::asio::buffer_copy(boost::asio::buffer(data), buffers);
+
+    std::lock_guard lock {pipe.mutex};
+
+    if (pipe.is_write_closed) return boost::asio::error::bad_descriptor;
+    if (pipe.is_read_closed) return boost::asio::error::broken_pipe;
+    if (data.empty()) return {};
+
+    // Chunks are serialized onto the link at its bandwidth, then arrive after its latency
+    const auto now {Clock::now()};
+    auto transmit_end {std::max(now, pipe.link_free)};
+    if (pipe.link.bandwidth != 0) {
+        transmit_end += duration_cast<Clock::duration>(
+            duration<f64> {static_cast<f64>(data.size()) / static_cast<f64>(pipe.link.bandwidth)});
+    }
+    pipe.link_free = transmit_end;
+
+    pipe.chunks.push_back(Chunk {
+        .deliver_at = transmit_end + pipe.link.latency,
+        .data = std::move(data),
+    });
+    pipe.wake_reader();
+
+    return {};
+}
+}
@@ -1,12 +1,14 @@
+#include <spire/core/metrics.hpp>
+#include <spire/core/settings.hpp>
 #include <spire/net/message.hpp>
 
 #include <bit>
 #include <cstring>
-#include <limits>
-#include <spanstream>
 #include <stdexcept>
 
 namespace spire::net {
+static constexpr size_t EXTENDED_HEADERS_SIZE {MessageHeader::SIZE + ExtendedHeader::SIZE};
+
 void MessageHeader::serialize(const MessageHeader& source, std::span<std::byte, SIZE> target) {
     u16 body_size {source.body_size};
     if constexpr (std::endian::native == std::endian::little)
@@ -24,6 +26,78 @@ MessageHeader MessageHeader::deserialize(const std::span<const std::byte, SIZE>
     return MessageHeader {.body_size = body_size};
 }
 
+Codec ExtendedHeader::codec() const {
+    if (flags & Lz4) return Codec::Lz4;
+    if (flags & Zstd) return Codec::Zstd;
+
+    return Codec::None;
+}
+
+bool ExtendedHeader::is_valid() const {
+    if (body_size == 0 || body_size > Settings::max_frame_size() || raw_size > Settings::max_frame_size())
+        return false;
+
+    return is_compressed() || body_size == raw_size;
+}
+
+bool ExtendedHeader::decode(std::vector<std::byte>& body) const {
+    if (body.size() != body_size) return false;
+    if (!is_compressed()) return true;
+
+    std::vector<std::byte> raw(raw_size);
+    if (!Compression::decompress(codec(), flags & Dictionary, body, raw)) return false;
+
+    body = std::move(raw);
+    return true;
+}
+
+void ExtendedHeader::serialize(const ExtendedHeader& source, std::span<std::byte, SIZE> target) {
+    u32 body_size {source.body_size};
+    u32 raw_size {source.raw_size};
+    if constexpr (std::endian::native == std::endian::little) {
+        body_size = std::byteswap(body_size);
+        raw_size = std::byteswap(raw_size);
+    }
+
+    target[0] = static_cast<std::byte>(source.flags);
+    std::memcpy(target.data() + sizeof(flags), &body_size, sizeof(body_size));
+    std::memcpy(target.data() + sizeof(flags) + sizeof(body_size), &raw_size, sizeof(raw_size));
+}
+
+ExtendedHeader ExtendedHeader::deserialize(const std::span<const std::byte, SIZE> source) {
+    u32 body_size;
+    u32 raw_size;
+    std::memcpy(&body_size, source.data() + sizeof(flags), sizeof(body_size));
+    std::memcpy(&raw_size, source.data() + sizeof(flags) + sizeof(body_size), sizeof(raw_size));
+    if constexpr (std::endian::native == std::endian::little) {
+        body_size = std::byteswap(body_size);
+        raw_size = std::byteswap(raw_size);
+    }
+
+    return ExtendedHeader {
+        .flags = std::to_integer<u8>(source[0]),
+        .body_size = body_size,
+        .raw_size = raw_size,
+    };
+}
+
+// Writes the `MessageHeader` sentinel followed by the `ExtendedHeader` of a frame
+static void serialize_extended_header(
+    const std::span<std::byte, EXTENDED_HEADERS_SIZE> target,
+    const u8 flags,
+    const size_t body_size,
+    const size_t raw_size) {
+    const MessageHeader header {.body_size = MessageHeader::EXTENDED};
+    MessageHeader::serialize(header, target.first<MessageHeader::SIZE>());
+
+    const ExtendedHeader extended_header {
+        .flags = flags,
+        .body_size = static_cast<u32>(body_size),
+        .raw_size = static_cast<u32>(raw_size),
+    };
+    ExtendedHeader::serialize(extended_header, target.last<ExtendedHeader::SIZE>());
+}
+
 InMessage::InMessage(std::vector<std::byte>&& data)
     : _data {std::move(data)} {}
 
@@ -33,24 +107,115 @@ OutMessage::OutMessage(const MessageHeader header) {
     MessageHeader::serialize(header, std::span<std::byte, sizeof(MessageHeader)> {_data.data(), sizeof(MessageHeader)});
 }
 
-OutMessage::OutMessage(const msg::BaseMessage& body) {
+OutMessage::OutMessage(const msg::BaseMessage& body, const Delivery delivery, const u32 collapse_key)
+    : _delivery {delivery}, _collapse_key {collapse_key} {
     const size_t body_size {body.ByteSizeLong()};
 
-    if (body_size > std::numeric_limits<decltype(MessageHeader::body_size)>::max())
+    if (body_size > Settings::max_frame_size())
         throw std::length_error("OutMessage body size too large");
 
-    _data.resize(sizeof(MessageHeader) + body_size);
+    if (body_size >= Settings::compression_threshold() && Compression::codec() != Codec::None) {
+        thread_local std::vector<std::byte> raw;
+        raw.resize(body_size);
+        body.SerializeToArray(raw.data(), static_cast<int>(body_size));
 
-    const MessageHeader header {.body_size = static_cast<u16>(body_size)};
-    MessageHeader::serialize(header, std::span<std::byte, sizeof(MessageHeader)> {_data.data(), sizeof(MessageHeader)});
+        if (serialize_compressed(raw, 0)) return;
+    }
+
+    serialize(body, body_size);
+}
+
+OutMessage::OutMessage(const std::span<const std::shared_ptr<OutMessage>> messages, const bool as_container) {
+    static auto& batched_messages {metrics::Metrics::counter(
+        "spire_net_batched_messages_total", "Messages merged into per-tick send batches")};
+
+    size_t frames_size {0};
+    size_t uncompressed_size {0};
+    for (const auto& message : messages) {
+        frames_size += message->size();
+        if (!message->is_compressed()) uncompressed_size += message->size();
+    }
+    batched_messages.add(messages.size());
+
+    if (as_container && frames_size <= Settings::max_frame_size()) {
+        thread_local std::vector<std::byte> frames;
+        frames.clear();
+        for (const auto& message : messages) {
+            frames.insert(frames.end(), message->span().begin(), message->span().end());
+        }
+
+        if (uncompressed_size >= Settings::compression_threshold() && Compression::codec() != Codec::None &&
+            serialize_compressed(frames, ExtendedHeader::Container)) {
+            return;
+        }
+
+        _data.resize(EXTENDED_HEADERS_SIZE);
+        serialize_extended_header(
+            std::span<std::byte, EXTENDED_HEADERS_SIZE> {_data.data(), EXTENDED_HEADERS_SIZE},
+            ExtendedHeader::Container,
+            frames_size,
+            frames_size);
+        _data.insert(_data.end(), frames.begin(), frames.end());
+        return;
+    }
 
-    serialize(body);
+    // The frames are already delimited, concatenating them keeps the receiver unaware of batching
+    _data.reserve(frames_size);
+    for (const auto& message : messages) {
+        _data.insert(_data.end(), message->span().begin(), message->span().end());
+    }
 }
 
-void OutMessage::serialize(const msg::BaseMessage& body) {
-    std::ospanstream os {std::span {
-        reinterpret_cast<char*>(_data.data()) + sizeof(MessageHeader), _data.size() - sizeof(MessageHeader)}};
+OutMessage::OutMessage(std::vector<std::byte>&& frames)
+    : _data {std::move(frames)} {}
+
+OutMessage::~OutMessage() {
+    BufferPool::release(std::move(_data));
+}
+
+void OutMessage::serialize(const msg::BaseMessage& body, const size_t body_size) {
+    if (body_size < MessageHeader::EXTENDED) {
+        _data.resize(MessageHeader::SIZE + body_size);
+
+        const MessageHeader header {.body_size = static_cast<u16>(body_size)};
+        MessageHeader::serialize(header, std::span<std::byte, MessageHeader::SIZE> {_data.data(), MessageHeader::SIZE});
+    }
+    else {
+        _data.resize(EXTENDED_HEADERS_SIZE + body_size);
+        serialize_extended_header(
+            std::span<std::byte, EXTENDED_HEADERS_SIZE> {_data.data(), EXTENDED_HEADERS_SIZE}, 0, body_size, body_size);
+    }
+
+    body.SerializeToArray(_data.data() + (_data.size() - body_size), static_cast<int>(body_size));
+}
+
+bool OutMessage::serialize_compressed(const std::span<const std::byte> raw, const u8 flags) {
+    static auto& compressed_frames {metrics::Metrics::counter(
+        "spire_net_compressed_frames_total", "Frames sent with compressed bodies")};
+    static auto& saved_bytes {metrics::Metrics::counter(
+        "spire_net_compression_saved_bytes_total", "Bytes saved by compressing frame bodies")};
+
+    _data.resize(EXTENDED_HEADERS_SIZE);
+    const auto compressed_size {Compression::compress(raw, _data)};
+    if (!compressed_size) {
+        _data.clear();
+        return false;
+    }
+
+    u8 codec_flags {Compression::codec() == Codec::Lz4 ? ExtendedHeader::Lz4 : ExtendedHeader::Zstd};
+    if (Compression::codec() == Codec::Zstd && Compression::has_dictionary()) {
+        codec_flags |= ExtendedHeader::Dictionary;
+    }
+
+    serialize_extended_header(
+        std::span<std::byte, EXTENDED_HEADERS_SIZE> {_data.data(), EXTENDED_HEADERS_SIZE},
+        flags | codec_flags,
+        *compressed_size,
+        raw.size());
 
-    body.SerializeToOstream(&os);
+    compressed_frames.add();
+    saved_bytes.add(raw.size() - *compressed_size);
+    _is_compressed = true;
+    return true;
 }
 }
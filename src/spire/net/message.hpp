@@ -1,8 +1,11 @@
 #pragma once
 
+#include <spire/core/compression.hpp>
 #include <spire/core/types.hpp>
 #include <spire/msg/base_message.pb.h>
+#include <spire/net/buffer_pool.hpp>
 
+#include <memory>
 #include <span>
 #include <vector>
 
@@ -11,11 +14,42 @@ struct MessageHeader {
     const u16 body_size;
 
     static constexpr size_t SIZE = sizeof(decltype(body_size));
+    // `body_size` of a frame whose actual header follows as an `ExtendedHeader`
+    static constexpr u16 EXTENDED {0xFFFF};
 
     static void serialize(const MessageHeader& source, std::span<std::byte, SIZE> target);
     static MessageHeader deserialize(std::span<const std::byte, SIZE> source);
 };
 
+// Header of frames too large for `MessageHeader` or with compressed bodies
+struct ExtendedHeader {
+    enum Flags : u8 {
+        Lz4 = 1 << 0,
+        Zstd = 1 << 1,
+        // Compressed with the shared zstd dictionary
+        Dictionary = 1 << 2,
+        // Body is a sequence of complete frames, none of which are containers themselves
+        Container = 1 << 3,
+    };
+
+    const u8 flags;
+    const u32 body_size;
+    // Size of the body after decompression, equal to `body_size` if uncompressed
+    const u32 raw_size;
+
+    static constexpr size_t SIZE = sizeof(flags) + sizeof(body_size) + sizeof(raw_size);
+
+    bool is_compressed() const { return flags & (Lz4 | Zstd); }
+    Codec codec() const;
+    // Checks the sizes against `Settings::max_frame_size()` before anything is allocated for the body
+    bool is_valid() const;
+    // Replaces `body` with its decompressed contents if compressed, false if it does not match the header
+    bool decode(std::vector<std::byte>& body) const;
+
+    static void serialize(const ExtendedHeader& source, std::span<std::byte, SIZE> target);
+    static ExtendedHeader deserialize(std::span<const std::byte, SIZE> source);
+};
+
 struct InMessage {
     explicit InMessage(std::vector<std::byte>&& data);
     ~InMessage() = default;
@@ -32,18 +66,44 @@ private:
 };
 
 struct OutMessage {
+    enum class Delivery : u8 {
+        Reliable,
+        // May be dropped when the receiver cannot keep up
+        Unreliable
+    };
+
     explicit OutMessage(MessageHeader header);
-    explicit OutMessage(const msg::BaseMessage& body);
-    ~OutMessage() = default;
+    // Bodies above `Settings::compression_threshold()` are compressed once here, so broadcasting a shared
+    // message costs one compression regardless of the number of receivers.
+    explicit OutMessage(const msg::BaseMessage& body, Delivery delivery = Delivery::Reliable, u32 collapse_key = 0);
+    // Merges already serialized `messages` into one buffer, either as is or packed into a single container frame. Only
+    // frames not compressed yet count toward the compression threshold of the container, so that broadcast frames
+    // compressed once by their constructor are not compressed again for every receiver.
+    OutMessage(std::span<const std::shared_ptr<OutMessage>> messages, bool as_container);
+    // Takes complete frames serialized elsewhere, such as by another server process
+    explicit OutMessage(std::vector<std::byte>&& frames);
+    // Returns the buffer to `BufferPool`
+    ~OutMessage();
     OutMessage(const OutMessage&) = delete;
     OutMessage& operator=(const OutMessage&) = delete;
 
-    void serialize(const msg::BaseMessage& body);
-
     std::span<const std::byte> span() const { return std::span {_data.data(), _data.size()}; }
+    size_t size() const { return _data.size(); }
     bool empty() const { return _data.empty(); }
+    bool is_compressed() const { return _is_compressed; }
+
+    Delivery delivery() const { return _delivery; }
+    // Unreliable messages sharing a non-zero key supersede each other while queued
+    u32 collapse_key() const { return _collapse_key; }
 
 private:
-    std::vector<std::byte> _data {};
+    void serialize(const msg::BaseMessage& body, size_t body_size);
+    // Leaves `_data` empty and returns false if `raw` does not shrink
+    bool serialize_compressed(std::span<const std::byte> raw, u8 flags);
+
+    std::vector<std::byte> _data {BufferPool::acquire()};
+    Delivery _delivery {Delivery::Reliable};
+    u32 _collapse_key {0};
+    bool _is_compressed {false};
 };
 }
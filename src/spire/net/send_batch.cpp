@@ -0,0 +1,28 @@
+#include <spire/core/settings.hpp>
+#include <spire/net/send_batch.hpp>
+
+namespace spire::net {
+SendBatch::Scope::Scope(SendBatch& batch)
+    : _batch {batch}, _previous {_current} {
+    _current = &_batch;
+}
+
+SendBatch::Scope::~Scope() {
+    _current = _previous;
+    _batch.flush();
+}
+
+void SendBatch::flush() {
+    for (auto& [sink, messages] : _entries) {
+        if (messages.size() == 1) {
+            sink(std::move(messages.front()));
+            continue;
+        }
+
+        sink(std::make_shared<OutMessage>(messages, Settings::send_batch_container()));
+    }
+
+    _indices.clear();
+    _entries.clear();
+}
+}
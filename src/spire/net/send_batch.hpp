@@ -0,0 +1,63 @@
+#pragma once
+
+#include <boost/core/noncopyable.hpp>
+#include <spire/net/message.hpp>
+
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace spire::net {
+// Corks the reliable sends made on one thread while a `Scope` is alive. Messages to the same receiver are
+// merged into one buffer which is handed to the receiver once the scope ends, so a room tick queues
+// a single write per client instead of one per message.
+class SendBatch final : boost::noncopyable {
+public:
+    using Sink = std::function<void(std::shared_ptr<OutMessage>)>;
+
+    class Scope final : boost::noncopyable {
+    public:
+        explicit Scope(SendBatch& batch);
+        // Flushes the batch
+        ~Scope();
+
+    private:
+        SendBatch& _batch;
+        SendBatch* const _previous;
+    };
+
+    SendBatch() = default;
+    ~SendBatch() = default;
+
+    // Batch of the innermost scope on the calling thread, null if sends go out immediately
+    static SendBatch* current() { return _current; }
+
+    // `receiver` identifies the destination, `make_sink` is only invoked for its first message of the batch
+    template <typename MakeSink>
+    void append(const void* receiver, std::shared_ptr<OutMessage> message, MakeSink&& make_sink);
+    void flush();
+
+private:
+    struct Entry {
+        Sink sink;
+        std::vector<std::shared_ptr<OutMessage>> messages;
+    };
+
+    inline static thread_local SendBatch* _current {nullptr};
+
+    std::unordered_map<const void*, size_t> _indices {};
+    std::vector<Entry> _entries {};
+};
+
+
+template <typename MakeSink>
+void SendBatch::append(const void* receiver, std::shared_ptr<OutMessage> message, MakeSink&& make_sink) {
+    const auto [it, inserted] = _indices.try_emplace(receiver, _entries.size());
+    if (inserted) {
+        _entries.push_back(Entry {.sink = make_sink(), .messages = {}});
+    }
+
+    _entries[it->second].messages.push_back(std::move(message));
+}
+}
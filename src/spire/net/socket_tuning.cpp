@@ -0,0 +1,112 @@
+#include <netinet/tcp.h>
+#include <spdlog/spdlog.h>
+#include <spire/net/socket_tuning.hpp>
+#include <sys/socket.h>
+
+#include <string>
+
+namespace spire::net {
+// Integer option satisfying both `SettableSocketOption` and `GettableSocketOption`
+template <int Level, int Name>
+class IntegerOption {
+public:
+    IntegerOption() = default;
+    explicit IntegerOption(const int value)
+        : _value {value} {}
+
+    int value() const { return _value; }
+
+    template <typename Protocol>
+    int level(const Protocol&) const { return Level; }
+    template <typename Protocol>
+    int name(const Protocol&) const { return Name; }
+    template <typename Protocol>
+    int* data(const Protocol&) { return &_value; }
+    template <typename Protocol>
+    const int* data(const Protocol&) const { return &_value; }
+    template <typename Protocol>
+    size_t size(const Protocol&) const { return sizeof(_value); }
+    template <typename Protocol>
+    void resize(const Protocol&, size_t) {}
+
+private:
+    int _value {0};
+};
+
+using SendBufferSize = IntegerOption<SOL_SOCKET, SO_SNDBUF>;
+using ReceiveBufferSize = IntegerOption<SOL_SOCKET, SO_RCVBUF>;
+using BusyPoll = IntegerOption<SOL_SOCKET, SO_BUSY_POLL>;
+using QuickAck = IntegerOption<IPPROTO_TCP, TCP_QUICKACK>;
+using NotSentLowWatermark = IntegerOption<IPPROTO_TCP, TCP_NOTSENT_LOWAT>;
+using UserTimeout = IntegerOption<IPPROTO_TCP, TCP_USER_TIMEOUT>;
+using DeferAccept = IntegerOption<IPPROTO_TCP, TCP_DEFER_ACCEPT>;
+
+// Sets the option and reads it back, the effective value may differ from the requested one
+template <typename Option>
+static void apply(
+    boost::asio::ip::tcp::acceptor& acceptor,
+    const std::string_view listener,
+    const std::string_view name,
+    const int value) {
+    boost::system::error_code ec;
+    if (acceptor.set_option(Option {value}, ec)) {
+        spdlog::warn("Listener {} refused {}={}: {}", listener, name, value, ec.message());
+        return;
+    }
+
+    Option effective {};
+    if (acceptor.get_option(effective, ec)) {
+        spdlog::warn("Listener {} could not read back {}: {}", listener, name, ec.message());
+        return;
+    }
+
+    if (effective.value() < value) {
+        spdlog::warn("Listener {} clamped {} from {} to {}", listener, name, value, effective.value());
+        return;
+    }
+
+    spdlog::info("Listener {} set {}={}", listener, name, effective.value());
+}
+
+void tune_listener(
+    boost::asio::ip::tcp::acceptor& acceptor,
+    const SocketTuning& tuning,
+    const std::string_view listener) {
+    // Linux clamps buffer sizes to net.core.wmem_max and rmem_max, then reports them doubled for bookkeeping overhead
+    if (tuning.send_buffer_size) {
+        apply<SendBufferSize>(acceptor, listener, "SO_SNDBUF", *tuning.send_buffer_size);
+    }
+    if (tuning.receive_buffer_size) {
+        apply<ReceiveBufferSize>(acceptor, listener, "SO_RCVBUF", *tuning.receive_buffer_size);
+    }
+    if (tuning.not_sent_low_watermark) {
+        apply<NotSentLowWatermark>(acceptor, listener, "TCP_NOTSENT_LOWAT", *tuning.not_sent_low_watermark);
+    }
+    // Raising it above net.core.busy_poll requires CAP_NET_ADMIN
+    if (tuning.busy_poll) {
+        apply<BusyPoll>(acceptor, listener, "SO_BUSY_POLL", *tuning.busy_poll);
+    }
+    if (tuning.user_timeout) {
+        apply<UserTimeout>(acceptor, listener, "TCP_USER_TIMEOUT", static_cast<int>(tuning.user_timeout->count()));
+    }
+    // The kernel rounds the timeout up to a whole number of SYN-ACK retransmissions
+    if (tuning.defer_accept) {
+        apply<DeferAccept>(acceptor, listener, "TCP_DEFER_ACCEPT", static_cast<int>(tuning.defer_accept->count()));
+    }
+}
+
+boost::system::error_code tune_socket(boost::asio::ip::tcp::socket& socket, const SocketTuning& tuning) {
+    boost::system::error_code ec;
+    if (tuning.quick_ack) {
+        socket.set_option(QuickAck {1}, ec);
+    }
+
+    return ec;
+}
+
+void rearm_quick_ack(boost::asio::ip::tcp::socket& socket) {
+    // A failure leaves delayed acks on, which is not worth closing the connection over
+    boost::system::error_code ec;
+    socket.set_option(QuickAck {1}, ec);
+}
+}
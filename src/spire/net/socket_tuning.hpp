@@ -0,0 +1,15 @@
+#pragma once
+
+#include <boost/asio/ip/tcp.hpp>
+#include <spire/core/settings.hpp>
+
+namespace spire::net {
+// Applies `tuning` to a listener and reads every option back, logging options the kernel refused or clamped.
+// Options other than TCP_QUICKACK are inherited by the sockets accepted afterwards.
+void tune_listener(boost::asio::ip::tcp::acceptor& acceptor, const SocketTuning& tuning, std::string_view listener);
+
+// Applies the options that are not inherited from the listener
+boost::system::error_code tune_socket(boost::asio::ip::tcp::socket& socket, const SocketTuning& tuning);
+// Enters quick ack mode again, which the kernel leaves on its own once it sees an interactive exchange
+void rearm_quick_ack(boost::asio::ip::tcp::socket& socket);
+}
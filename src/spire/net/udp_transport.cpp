@@ -0,0 +1,203 @@
+#include <openssl/rand.h>
+#include <spdlog/spdlog.h>
+#include <spire/net/udp_transport.hpp>
+
+#include <stdexcept>
+
+namespace spire::net {
+static void random_bytes(const std::span<std::byte> bytes) {
+    if (RAND_bytes(reinterpret_cast<unsigned char*>(bytes.data()), static_cast<int>(bytes.size())) != 1)
+        throw std::runtime_error("Failed to generate datagram session secrets");
+}
+
+DatagramSession::DatagramSession(UdpTransport& transport, const u64 token, const DatagramKey& key)
+    : _transport {transport}, _token {token}, _key {key} {}
+
+void DatagramSession::init(std::function<void(std::vector<std::byte>&&)>&& on_received) {
+    _on_received = std::move(on_received);
+}
+
+void DatagramSession::close() {
+    _transport.close_session(_token);
+}
+
+bool DatagramSession::send(const DatagramChannel channel, const msg::BaseMessage& body) {
+    if (!_is_bound) return false;
+
+    const size_t body_size {body.ByteSizeLong()};
+    if (DatagramHeader::SIZE + body_size + DATAGRAM_TAG_SIZE > MAX_DATAGRAM_SIZE) return false;
+
+    std::vector<std::byte> datagram(DatagramHeader::SIZE + body_size + DATAGRAM_TAG_SIZE);
+    const DatagramHeader header {
+        .session_token = _token,
+        .channel = channel,
+        .sequence = _send_sequences[std::to_underlying(channel)].fetch_add(1, std::memory_order_relaxed) + 1,
+    };
+    DatagramHeader::serialize(header, std::span<std::byte, DatagramHeader::SIZE> {datagram.data(), DatagramHeader::SIZE});
+    body.SerializeToArray(datagram.data() + DatagramHeader::SIZE, static_cast<int>(body_size));
+    sign_datagram(datagram, _key);
+
+    _transport.send(*this, std::move(datagram));
+    return true;
+}
+
+UdpTransport::UdpTransport(
+    const boost::asio::any_io_executor& io_executor,
+    const u16 port,
+    const NativeHandle inherited)
+    : _strand {make_strand(io_executor)},
+    _socket {_strand},
+    _sent_datagrams {metrics::Metrics::counter("spire_net_sent_datagrams_total", "Datagrams sent")},
+    _received_datagrams {metrics::Metrics::counter("spire_net_received_datagrams_total", "Datagrams accepted")},
+    _stale_datagrams {metrics::Metrics::counter(
+        "spire_net_stale_datagrams_total", "Datagrams dropped for being older than the newest received")},
+    _rejected_datagrams {metrics::Metrics::counter(
+        "spire_net_rejected_datagrams_total", "Datagrams dropped for being malformed, forged or of unknown sessions")},
+    _send_errors {metrics::Metrics::counter("spire_net_datagram_send_errors_total", "Failed datagram sends")} {
+    if (inherited != -1) {
+        _socket.assign(boost::asio::ip::udp::v4(), inherited);
+        return;
+    }
+
+    _socket.open(boost::asio::ip::udp::v4());
+    _socket.bind(boost::asio::ip::udp::endpoint {boost::asio::ip::udp::v4(), port});
+}
+
+UdpTransport::~UdpTransport() {
+    stop();
+}
+
+void UdpTransport::start() {
+    if (_is_running.exchange(true)) return;
+
+    co_spawn(_strand, receive(), boost::asio::detached);
+}
+
+void UdpTransport::stop() {
+    if (!_is_running.exchange(false)) return;
+
+    if (boost::system::error_code ec; _socket.close(ec)) {
+        spdlog::warn("Error closing UDP socket");
+    }
+
+    std::lock_guard lock {_mutex};
+    _sessions.clear();
+}
+
+std::shared_ptr<DatagramSession> UdpTransport::open_session() {
+    DatagramKey key;
+    random_bytes(key);
+
+    std::lock_guard lock {_mutex};
+
+    u64 token;
+    do {
+        random_bytes(std::as_writable_bytes(std::span {&token, 1}));
+    } while (token == 0 || _sessions.contains(token));
+
+    return _sessions.emplace(token, std::make_shared<DatagramSession>(*this, token, key)).first->second;
+}
+
+u16 UdpTransport::port() const {
+    boost::system::error_code ec;
+    return _socket.local_endpoint(ec).port();
+}
+
+void UdpTransport::send(const DatagramSession& session, std::vector<std::byte>&& datagram) {
+    boost::asio::ip::udp::endpoint endpoint;
+    {
+        std::lock_guard lock {_mutex};
+        endpoint = session._endpoint;
+    }
+
+    post(_strand, [this, endpoint, datagram = std::move(datagram)] mutable {
+        if (!_is_running) return;
+
+        auto buffer {std::make_shared<std::vector<std::byte>>(std::move(datagram))};
+        _socket.async_send_to(
+            boost::asio::buffer(*buffer),
+            endpoint,
+            [this, buffer](const boost::system::error_code& ec, size_t) {
+                if (ec) {
+                    _send_errors.add();
+                    return;
+                }
+
+                _sent_datagrams.add();
+            });
+    });
+}
+
+void UdpTransport::close_session(const u64 token) {
+    std::lock_guard lock {_mutex};
+
+    _sessions.erase(token);
+}
+
+boost::asio::awaitable<void> UdpTransport::receive() {
+    std::array<std::byte, MAX_DATAGRAM_SIZE> buffer {};
+    boost::asio::ip::udp::endpoint sender;
+
+    while (_is_running) {
+        const auto [ec, size] = co_await _socket.async_receive_from(
+            boost::asio::buffer(buffer), sender, boost::asio::as_tuple(boost::asio::use_awaitable));
+
+        if (ec == boost::asio::error::operation_aborted) co_return;
+        if (ec) continue;
+
+        dispatch(std::span {buffer.data(), size}, sender);
+    }
+}
+
+void UdpTransport::dispatch(const std::span<const std::byte> datagram, const boost::asio::ip::udp::endpoint& sender) {
+    if (datagram.size() < DatagramHeader::SIZE + DATAGRAM_TAG_SIZE) {
+        _rejected_datagrams.add();
+        return;
+    }
+
+    const auto header {DatagramHeader::deserialize(datagram.first<DatagramHeader::SIZE>())};
+    if (!header) {
+        _rejected_datagrams.add();
+        return;
+    }
+
+    std::shared_ptr<DatagramSession> session;
+    {
+        std::lock_guard lock {_mutex};
+
+        const auto it {_sessions.find(header->session_token)};
+        if (it == _sessions.end()) {
+            _rejected_datagrams.add();
+            return;
+        }
+        session = it->second;
+
+        // Checked before anything of the session changes, so that forged datagrams cannot rebind the endpoint
+        if (!verify_datagram(datagram, session->_key)) {
+            _rejected_datagrams.add();
+            return;
+        }
+
+        // Newest wins, anything older than the last accepted datagram of the channel is superseded
+        auto& last_sequence {session->_receive_sequences[std::to_underlying(header->channel)]};
+        if (last_sequence && !is_newer_sequence(header->sequence, *last_sequence)) {
+            _stale_datagrams.add();
+            return;
+        }
+        last_sequence = header->sequence;
+
+        // Follows NAT rebinding, the tag authenticates the sender and the sequence rules out replayed datagrams
+        session->_endpoint = sender;
+    }
+
+    session->_is_bound = true;
+    _received_datagrams.add();
+
+    // Empty bodies only bind the endpoint
+    const auto body {
+        datagram.subspan(DatagramHeader::SIZE, datagram.size() - DatagramHeader::SIZE - DATAGRAM_TAG_SIZE)};
+    if (body.empty() || !session->_on_received) return;
+
+    session->_on_received(std::vector<std::byte> {body.begin(), body.end()});
+}
+}
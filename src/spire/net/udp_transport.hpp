@@ -0,0 +1,95 @@
+#pragma once
+
+#include <boost/asio.hpp>
+#include <boost/core/noncopyable.hpp>
+#include <spire/core/metrics.hpp>
+#include <spire/msg/base_message.pb.h>
+#include <spire/net/datagram.hpp>
+
+#include <array>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace spire::net {
+class UdpTransport;
+
+// Unreliable, sequenced channels of one authenticated client.
+// The client binds its endpoint by sending a datagram carrying the session token and signed with the session key, both
+// of which it receives over TCP.
+class DatagramSession final : boost::noncopyable {
+public:
+    DatagramSession(UdpTransport& transport, u64 token, const DatagramKey& key);
+
+    // Must be called before the token is handed out
+    void init(std::function<void(std::vector<std::byte>&&)>&& on_received);
+    void close();
+
+    // False if the remote endpoint is not bound yet or the body does not fit a datagram
+    bool send(DatagramChannel channel, const msg::BaseMessage& body);
+
+    u64 token() const { return _token; }
+    const DatagramKey& key() const { return _key; }
+    bool is_bound() const { return _is_bound; }
+
+private:
+    friend class UdpTransport;
+
+    UdpTransport& _transport;
+    const u64 _token;
+    const DatagramKey _key;
+    std::atomic<bool> _is_bound {false};
+    std::array<std::atomic<u32>, DATAGRAM_CHANNEL_COUNT> _send_sequences {};
+
+    // Guarded by the mutex of `_transport`
+    boost::asio::ip::udp::endpoint _endpoint {};
+    std::array<std::optional<u32>, DATAGRAM_CHANNEL_COUNT> _receive_sequences {};
+
+    std::function<void(std::vector<std::byte>&&)> _on_received;
+};
+
+
+class UdpTransport final : boost::noncopyable {
+public:
+    using NativeHandle = boost::asio::ip::udp::socket::native_handle_type;
+
+    // Binds `port`, unless `inherited` is a bound socket handed over by a draining server
+    UdpTransport(const boost::asio::any_io_executor& io_executor, u16 port, NativeHandle inherited = -1);
+    ~UdpTransport();
+
+    void start();
+    void stop();
+
+    // Issues a session named by a random token, its datagrams are signed with a random key
+    std::shared_ptr<DatagramSession> open_session();
+
+    bool is_running() const { return _is_running; }
+    u16 port() const;
+    // For handing the socket over to a successor
+    NativeHandle native_handle() { return _socket.native_handle(); }
+
+private:
+    friend class DatagramSession;
+
+    void send(const DatagramSession& session, std::vector<std::byte>&& datagram);
+    void close_session(u64 token);
+
+    boost::asio::awaitable<void> receive();
+    void dispatch(std::span<const std::byte> datagram, const boost::asio::ip::udp::endpoint& sender);
+
+    std::atomic<bool> _is_running {false};
+
+    boost::asio::strand<boost::asio::any_io_executor> _strand;
+    boost::asio::ip::udp::socket _socket;
+
+    std::mutex _mutex {};
+    std::unordered_map<u64, std::shared_ptr<DatagramSession>> _sessions {};
+
+    metrics::Counter& _sent_datagrams;
+    metrics::Counter& _received_datagrams;
+    metrics::Counter& _stale_datagrams;
+    metrics::Counter& _rejected_datagrams;
+    metrics::Counter& _send_errors;
+};
+}
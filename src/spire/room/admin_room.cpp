@@ -1,8 +1,11 @@
+#include <spire/handler/admin_handler.hpp>
 #include <spire/room/admin_room.hpp>
 
 namespace spire {
-AdminRoom::AdminRoom(boost::asio::any_io_executor& io_executor)
-    : Room {0, io_executor} {}
+AdminRoom::AdminRoom(boost::asio::any_io_executor& io_executor, RoomDirectory& room_directory)
+    : Room {0, "admin", io_executor} {
+    _handler_controller.add_handler(AdminHandler::make(room_directory));
+}
 
 void AdminRoom::on_client_entered(const std::shared_ptr<net::SslClient>& client) {
     client->start();
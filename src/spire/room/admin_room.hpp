@@ -5,7 +5,7 @@
 namespace spire {
 class AdminRoom final : public SslRoom {
 public:
-    explicit AdminRoom(boost::asio::any_io_executor& io_executor);
+    AdminRoom(boost::asio::any_io_executor& io_executor, RoomDirectory& room_directory);
     ~AdminRoom() override = default;
 
 private:
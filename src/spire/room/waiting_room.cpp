@@ -4,13 +4,36 @@
 #include <spire/room/waiting_room.hpp>
 
 namespace spire {
-WaitingRoom::WaitingRoom(boost::asio::any_io_executor& io_executor)
-    : Room {0, io_executor} {
+WaitingRoom::WaitingRoom(
+    boost::asio::any_io_executor& io_executor,
+    net::UdpTransport* udp_transport,
+    SessionTable* session_table)
+    : Room {0, "waiting", io_executor}, _session_table {session_table} {
     _handler_controller.add_handler(NetHandler::make());
-    _handler_controller.add_handler(AuthHandler::make());
+    _handler_controller.add_handler(AuthHandler::make(udp_transport, session_table));
 }
 
 void WaitingRoom::on_client_entered(const std::shared_ptr<net::TcpClient>& client) {
     client->start();
 }
+
+void WaitingRoom::on_client_stopped(
+    const std::shared_ptr<net::TcpClient>& client,
+    const net::TcpClient::StopCode code) {
+    if (!_session_table) return;
+
+    // Only drops and drains are worth resuming, slow consumers would only get their backlog replayed
+    if (code != net::TcpClient::StopCode::ConnectionError &&
+        code != net::TcpClient::StopCode::HeartbeatDead &&
+        code != net::TcpClient::StopCode::Draining) {
+        _session_table->close(client->id());
+        return;
+    }
+
+    client->take_unsent(
+        [session_table = _session_table, client_id = client->id()](
+            std::vector<std::shared_ptr<net::OutMessage>>&& unsent) {
+            session_table->park(client_id, std::move(unsent));
+        });
+}
 }
@@ -1,14 +1,21 @@
 #pragma once
 
 #include <spire/server/room.hpp>
+#include <spire/server/session_table.hpp>
 
 namespace spire {
 class WaitingRoom final : public TcpRoom {
 public:
-    explicit WaitingRoom(boost::asio::any_io_executor& io_executor);
+    WaitingRoom(
+        boost::asio::any_io_executor& io_executor,
+        net::UdpTransport* udp_transport,
+        SessionTable* session_table);
     ~WaitingRoom() override = default;
 
 private:
     void on_client_entered(const std::shared_ptr<net::TcpClient>& client) override;
+    void on_client_stopped(const std::shared_ptr<net::TcpClient>& client, net::TcpClient::StopCode code) override;
+
+    SessionTable* _session_table;
 };
 }
\ No newline at end of file
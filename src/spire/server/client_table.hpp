@@ -0,0 +1,198 @@
+#pragma once
+
+#include <entt/entt.hpp>
+#include <spire/core/types.hpp>
+
+#include <limits>
+#include <memory>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace spire {
+// Reference to a client of a room that is safe to store. Once the client left it no longer resolves,
+// even if its slot was reused by another client.
+struct ClientHandle {
+    static constexpr u32 INVALID_SLOT {std::numeric_limits<u32>::max()};
+
+    u32 slot {INVALID_SLOT};
+    u32 generation {0};
+
+    bool is_valid() const { return slot != INVALID_SLOT; }
+    bool operator==(const ClientHandle& other) const = default;
+};
+
+
+// Clients of a room in dense arrays, so that broadcasts iterate contiguous memory. Each client is given a handle
+// and an entity, which resolve to each other in O(1). Removal moves the last client into the gap, so the order
+// of `clients()` changes and positions must not be kept across removals; handles are to be kept instead.
+template <typename ClientType>
+class ClientTable final {
+public:
+    using Signals = typename ClientType::Signals;
+
+    ClientTable() = default;
+    ~ClientTable() = default;
+    ClientTable(const ClientTable&) = delete;
+    ClientTable& operator=(const ClientTable&) = delete;
+
+    ClientHandle add(std::shared_ptr<ClientType> client, Signals&& signals, entt::entity entity);
+    // False if `handle` is stale
+    bool remove(ClientHandle handle);
+    void reserve(size_t capacity);
+
+    // Invalid handles if not in the table
+    ClientHandle find(const ClientType& client) const;
+    ClientHandle find(entt::entity entity) const;
+
+    // Null if `handle` is stale
+    const std::shared_ptr<ClientType>* get(ClientHandle handle) const;
+    // `entt::null` if `handle` is stale
+    entt::entity entity(ClientHandle handle) const;
+
+    // Parallel arrays, index `i` of each refers to the same client
+    std::span<const std::shared_ptr<ClientType>> clients() const { return _clients; }
+    std::span<const entt::entity> entities() const { return _entities; }
+
+    size_t size() const { return _clients.size(); }
+    bool empty() const { return _clients.empty(); }
+
+private:
+    static constexpr u32 INVALID_INDEX {std::numeric_limits<u32>::max()};
+
+    struct Slot {
+        u32 index {INVALID_INDEX};
+        u32 generation {0};
+    };
+
+    // Position in the dense arrays, `INVALID_INDEX` if stale
+    u32 index(ClientHandle handle) const;
+
+    std::vector<Slot> _slots {};
+    std::vector<u32> _free_slots {};
+    // Indexed by entity identifier without version
+    std::vector<u32> _entity_slots {};
+    std::unordered_map<const ClientType*, u32> _client_slots {};
+
+    std::vector<std::shared_ptr<ClientType>> _clients {};
+    std::vector<entt::entity> _entities {};
+    std::vector<u32> _index_slots {};
+    std::vector<Signals> _signals {};
+};
+
+
+template <typename ClientType>
+ClientHandle ClientTable<ClientType>::add(
+    std::shared_ptr<ClientType> client,
+    Signals&& signals,
+    const entt::entity entity) {
+    u32 slot;
+    if (!_free_slots.empty()) {
+        slot = _free_slots.back();
+        _free_slots.pop_back();
+    }
+    else {
+        slot = static_cast<u32>(_slots.size());
+        _slots.emplace_back();
+    }
+
+    const auto entity_index {static_cast<size_t>(entt::to_entity(entity))};
+    if (entity_index >= _entity_slots.size()) {
+        _entity_slots.resize(entity_index + 1, ClientHandle::INVALID_SLOT);
+    }
+    _entity_slots[entity_index] = slot;
+    _client_slots[client.get()] = slot;
+
+    _slots[slot].index = static_cast<u32>(_clients.size());
+    _clients.push_back(std::move(client));
+    _entities.push_back(entity);
+    _index_slots.push_back(slot);
+    _signals.push_back(std::move(signals));
+
+    return ClientHandle {.slot = slot, .generation = _slots[slot].generation};
+}
+
+template <typename ClientType>
+bool ClientTable<ClientType>::remove(const ClientHandle handle) {
+    const u32 removed {index(handle)};
+    if (removed == INVALID_INDEX) return false;
+
+    _entity_slots[static_cast<size_t>(entt::to_entity(_entities[removed]))] = ClientHandle::INVALID_SLOT;
+    _client_slots.erase(_clients[removed].get());
+
+    // The last client fills the gap
+    const u32 last {static_cast<u32>(_clients.size() - 1)};
+    if (removed != last) {
+        _clients[removed] = std::move(_clients[last]);
+        _entities[removed] = _entities[last];
+        _index_slots[removed] = _index_slots[last];
+        _signals[removed] = std::move(_signals[last]);
+        _slots[_index_slots[removed]].index = removed;
+    }
+    _clients.pop_back();
+    _entities.pop_back();
+    _index_slots.pop_back();
+    _signals.pop_back();
+
+    // Bumping the generation invalidates every handle to the slot
+    _slots[handle.slot].index = INVALID_INDEX;
+    ++_slots[handle.slot].generation;
+    _free_slots.push_back(handle.slot);
+    return true;
+}
+
+template <typename ClientType>
+void ClientTable<ClientType>::reserve(const size_t capacity) {
+    _slots.reserve(capacity);
+    _free_slots.reserve(capacity);
+    _entity_slots.reserve(capacity);
+    _client_slots.reserve(capacity);
+    _clients.reserve(capacity);
+    _entities.reserve(capacity);
+    _index_slots.reserve(capacity);
+    _signals.reserve(capacity);
+}
+
+template <typename ClientType>
+ClientHandle ClientTable<ClientType>::find(const ClientType& client) const {
+    const auto it {_client_slots.find(&client)};
+    if (it == _client_slots.end()) return {};
+
+    return ClientHandle {.slot = it->second, .generation = _slots[it->second].generation};
+}
+
+template <typename ClientType>
+ClientHandle ClientTable<ClientType>::find(const entt::entity entity) const {
+    const auto entity_index {static_cast<size_t>(entt::to_entity(entity))};
+    if (entity_index >= _entity_slots.size()) return {};
+
+    const u32 slot {_entity_slots[entity_index]};
+    if (slot == ClientHandle::INVALID_SLOT) return {};
+
+    // A recycled identifier with a different version is another entity
+    const auto& [client_index, generation] = _slots[slot];
+    if (_entities[client_index] != entity) return {};
+
+    return ClientHandle {.slot = slot, .generation = generation};
+}
+
+template <typename ClientType>
+const std::shared_ptr<ClientType>* ClientTable<ClientType>::get(const ClientHandle handle) const {
+    const u32 found {index(handle)};
+    return found != INVALID_INDEX ? &_clients[found] : nullptr;
+}
+
+template <typename ClientType>
+entt::entity ClientTable<ClientType>::entity(const ClientHandle handle) const {
+    const u32 found {index(handle)};
+    return found != INVALID_INDEX ? _entities[found] : entt::null;
+}
+
+template <typename ClientType>
+u32 ClientTable<ClientType>::index(const ClientHandle handle) const {
+    if (handle.slot >= _slots.size()) return INVALID_INDEX;
+
+    const auto& [client_index, generation] = _slots[handle.slot];
+    return generation == handle.generation ? client_index : INVALID_INDEX;
+}
+}
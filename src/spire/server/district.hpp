@@ -2,6 +2,8 @@
 
 #include <spire/server/room.hpp>
 
+#include <format>
+
 namespace spire {
 template <typename RoomType>
 class District;
@@ -13,13 +15,55 @@ using SslDistrict = District<SslRoom>;
 template <typename RoomType>
 class District {
 public:
+    explicit District(std::string_view name);
+
+    // Creates `count` idle rooms reserved according to `Settings`, registered with `room_directory`
+    void spawn_rooms(u32 count, boost::asio::any_io_executor& io_executor, RoomDirectory& room_directory);
     void broadcast_message(std::shared_ptr<net::OutMessage> message);
 
+    size_t size() const { return _rooms.size(); }
+
 private:
+    const std::string _name;
+    const time_point<system_clock, seconds> _start_time {floor<seconds>(system_clock::now())};
+    // 0 is taken by the rooms outside of districts
+    u32 _next_room_id {1};
     std::unordered_map<u32, std::shared_ptr<RoomType>> _rooms {};
 };
 
 
+template <typename RoomType>
+District<RoomType>::District(const std::string_view name)
+    : _name {name} {}
+
+template <typename RoomType>
+void District<RoomType>::spawn_rooms(
+    const u32 count,
+    boost::asio::any_io_executor& io_executor,
+    RoomDirectory& room_directory) {
+    _rooms.reserve(_rooms.size() + count);
+
+    for (u32 i {0}; i < count; ++i) {
+        const u32 id {_next_room_id++};
+        auto room {std::make_shared<RoomType>(id, _name, io_executor)};
+        room->reserve(Settings::warmup_room_clients(), Settings::warmup_room_entities());
+        room->simulate_characters(Speed {Settings::character_speed()});
+
+        // Named by the start of the server, so that the logs of a run that misbehaved are not overwritten by the next
+        if (const auto directory {Settings::replay_directory()}; !directory.empty()) {
+            const auto path {directory / std::format("{}-{}-{:%Y%m%d%H%M%S}.replay", _name, id, _start_time)};
+            auto recorder {ReplayRecorder::open(path, id, _name, Settings::random_seed())};
+            if (!recorder) {
+                spdlog::warn("Could not create replay log {}", path.string());
+            }
+            room->record_replay(std::move(recorder));
+        }
+
+        room_directory.add(room);
+        _rooms.emplace(id, std::move(room));
+    }
+}
+
 template <typename RoomType>
 void District<RoomType>::broadcast_message(std::shared_ptr<net::OutMessage> message) {
     for (const auto& room : _rooms | std::views::values)
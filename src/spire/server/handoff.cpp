@@ -0,0 +1,124 @@
+#include <spdlog/spdlog.h>
+#include <spire/core/settings.hpp>
+#include <spire/server/handoff.hpp>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <array>
+#include <cstring>
+
+namespace spire {
+static constexpr size_t MAX_FDS {3};
+
+// Descriptors ride along the first bytes, the header saying how large the session payload after it is
+struct HandoffHeader {
+    u32 fd_mask;
+    u32 sessions_size;
+};
+
+std::optional<HandoffState> Handoff::take_over(const std::filesystem::path& path) {
+    boost::asio::io_context io_context {1};
+    boost::asio::local::stream_protocol::socket socket {io_context};
+
+    boost::system::error_code ec;
+    if (socket.connect(boost::asio::local::stream_protocol::endpoint {path.string()}, ec)) return std::nullopt;
+    if (!is_trusted_peer(socket)) {
+        spdlog::warn("Server at {} runs as another user, starting fresh", path.string());
+        return std::nullopt;
+    }
+
+    spdlog::info("Taking over from the server at {}", path.string());
+
+    // The predecessor replies once drained, a little later than its own timeout at worst
+    const auto timeout {duration_cast<microseconds>(Settings::drain_timeout() + 5s)};
+    const timeval receive_timeout {
+        .tv_sec = static_cast<time_t>(timeout.count() / 1'000'000),
+        .tv_usec = static_cast<suseconds_t>(timeout.count() % 1'000'000),
+    };
+    setsockopt(socket.native_handle(), SOL_SOCKET, SO_RCVTIMEO, &receive_timeout, sizeof(receive_timeout));
+
+    HandoffHeader header {};
+    iovec io {.iov_base = &header, .iov_len = sizeof(header)};
+    alignas(cmsghdr) std::array<char, CMSG_SPACE(sizeof(int) * MAX_FDS)> control {};
+    msghdr message {};
+    message.msg_iov = &io;
+    message.msg_iovlen = 1;
+    message.msg_control = control.data();
+    message.msg_controllen = control.size();
+
+    if (recvmsg(socket.native_handle(), &message, MSG_WAITALL | MSG_CMSG_CLOEXEC) != sizeof(header)) {
+        spdlog::warn("Predecessor did not hand over, starting fresh");
+        return std::nullopt;
+    }
+
+    std::array<int, MAX_FDS> fds {-1, -1, -1};
+    size_t fd_count {0};
+    for (auto* cmsg {CMSG_FIRSTHDR(&message)}; cmsg; cmsg = CMSG_NXTHDR(&message, cmsg)) {
+        if (cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS) continue;
+
+        fd_count = std::min((cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int), MAX_FDS);
+        std::memcpy(fds.data(), CMSG_DATA(cmsg), fd_count * sizeof(int));
+    }
+
+    // Descriptors are sent in mask order, skipping absent ones
+    HandoffState state {};
+    std::array<int*, MAX_FDS> targets {&state.game_fd, &state.admin_fd, &state.udp_fd};
+    size_t next_fd {0};
+    for (size_t i {0}; i < MAX_FDS; ++i) {
+        if (!(header.fd_mask & (1u << i)) || next_fd >= fd_count) continue;
+        *targets[i] = fds[next_fd++];
+    }
+
+    state.sessions.resize(header.sessions_size);
+    boost::asio::read(socket, boost::asio::buffer(state.sessions), ec);
+    if (ec) {
+        spdlog::warn("Predecessor sent incomplete sessions, dropping them");
+        state.sessions.clear();
+    }
+
+    return state;
+}
+
+bool Handoff::hand_over(boost::asio::local::stream_protocol::socket& successor, const HandoffState& state) {
+    HandoffHeader header {.fd_mask = 0, .sessions_size = static_cast<u32>(state.sessions.size())};
+    std::array<int, MAX_FDS> fds {};
+    size_t fd_count {0};
+    for (size_t i {0}; const auto fd : {state.game_fd, state.admin_fd, state.udp_fd}) {
+        if (fd != -1) {
+            header.fd_mask |= 1u << i;
+            fds[fd_count++] = fd;
+        }
+        ++i;
+    }
+
+    iovec io {.iov_base = &header, .iov_len = sizeof(header)};
+    alignas(cmsghdr) std::array<char, CMSG_SPACE(sizeof(int) * MAX_FDS)> control {};
+    msghdr message {};
+    message.msg_iov = &io;
+    message.msg_iovlen = 1;
+    if (fd_count != 0) {
+        message.msg_control = control.data();
+        message.msg_controllen = CMSG_SPACE(sizeof(int) * fd_count);
+
+        auto* cmsg {CMSG_FIRSTHDR(&message)};
+        cmsg->cmsg_level = SOL_SOCKET;
+        cmsg->cmsg_type = SCM_RIGHTS;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(int) * fd_count);
+        std::memcpy(CMSG_DATA(cmsg), fds.data(), sizeof(int) * fd_count);
+    }
+
+    if (sendmsg(successor.native_handle(), &message, MSG_NOSIGNAL) != sizeof(header)) return false;
+
+    boost::system::error_code ec;
+    boost::asio::write(successor, boost::asio::buffer(state.sessions), ec);
+    return !ec;
+}
+
+bool Handoff::is_trusted_peer(boost::asio::local::stream_protocol::socket& socket) {
+    ucred credentials {};
+    socklen_t size {sizeof(credentials)};
+    if (getsockopt(socket.native_handle(), SOL_SOCKET, SO_PEERCRED, &credentials, &size) != 0) return false;
+
+    return credentials.uid == geteuid();
+}
+}
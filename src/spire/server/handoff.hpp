@@ -0,0 +1,33 @@
+#pragma once
+
+#include <boost/asio.hpp>
+#include <spire/core/types.hpp>
+
+#include <filesystem>
+#include <optional>
+#include <vector>
+
+namespace spire {
+// What a draining server passes to its successor. The descriptors are owned by the receiver, -1 if absent.
+struct HandoffState {
+    int game_fd {-1};
+    int admin_fd {-1};
+    int udp_fd {-1};
+    // `SessionTable::serialize()`
+    std::vector<std::byte> sessions {};
+};
+
+// Zero-downtime restarts over a Unix domain socket. A starting server connects to the socket of the running one,
+// which drains and replies with its listening descriptors through SCM_RIGHTS followed by its parked sessions.
+// Connections arriving meanwhile wait in the backlog of the listeners that never close.
+class Handoff final {
+public:
+    // Blocks until the server listening at `path` drained, empty if there is none
+    static std::optional<HandoffState> take_over(const std::filesystem::path& path);
+    // Sends `state` to a successor that connected through `take_over()`
+    static bool hand_over(boost::asio::local::stream_protocol::socket& successor, const HandoffState& state);
+
+    // True if the peer of `socket` runs as the user of this process, no other process may drain or take over
+    static bool is_trusted_peer(boost::asio::local::stream_protocol::socket& socket);
+};
+}
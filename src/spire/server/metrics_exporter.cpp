@@ -0,0 +1,76 @@
+#include <spdlog/spdlog.h>
+#include <spire/core/metrics.hpp>
+#include <spire/server/metrics_exporter.hpp>
+
+#include <format>
+
+namespace spire {
+MetricsExporter::MetricsExporter(const boost::asio::any_io_executor& io_executor, const u16 port)
+    : _acceptor {
+        make_strand(io_executor),
+        boost::asio::ip::tcp::endpoint {boost::asio::ip::tcp::v4(), port}} {
+    _acceptor.set_option(boost::asio::socket_base::reuse_address(true));
+}
+
+MetricsExporter::~MetricsExporter() {
+    stop();
+}
+
+void MetricsExporter::start() {
+    if (_is_running.exchange(true)) return;
+
+    co_spawn(_acceptor.get_executor(), [this] -> boost::asio::awaitable<void> {
+        spdlog::info("Metrics exporter listening on port {}", _acceptor.local_endpoint().port());
+
+        while (_is_running) {
+            auto [ec, socket] = co_await _acceptor.async_accept(boost::asio::as_tuple(boost::asio::use_awaitable));
+            if (ec) {
+                if (_is_running) spdlog::warn("Error accepting metrics socket");
+                continue;
+            }
+
+            co_spawn(_acceptor.get_executor(), serve(std::move(socket)), boost::asio::detached);
+        }
+    }, boost::asio::detached);
+}
+
+void MetricsExporter::stop() {
+    if (!_is_running.exchange(false)) return;
+
+    if (boost::system::error_code ec; _acceptor.close(ec)) {
+        spdlog::warn("Error closing metrics acceptor");
+    }
+}
+
+boost::asio::awaitable<void> MetricsExporter::serve(boost::asio::ip::tcp::socket socket) {
+    static constexpr size_t MAX_REQUEST_SIZE {8 * 1024};
+
+    std::string request;
+    const auto [read_ec, _] = co_await async_read_until(
+        socket,
+        boost::asio::dynamic_buffer(request, MAX_REQUEST_SIZE),
+        "\r\n\r\n",
+        boost::asio::as_tuple(boost::asio::use_awaitable));
+    if (read_ec) co_return;
+
+    std::string response;
+    if (request.starts_with("GET /metrics ") || request.starts_with("GET / ")) {
+        const auto body {metrics::Metrics::export_prometheus()};
+        response = std::format(
+            "HTTP/1.1 200 OK\r\n"
+            "Content-Type: text/plain; version=0.0.4; charset=utf-8\r\n"
+            "Content-Length: {}\r\n"
+            "Connection: close\r\n"
+            "\r\n"
+            "{}",
+            body.size(), body);
+    } else {
+        response = "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+    }
+
+    co_await async_write(socket, boost::asio::buffer(response), boost::asio::as_tuple(boost::asio::use_awaitable));
+
+    boost::system::error_code ec;
+    socket.shutdown(boost::asio::ip::tcp::socket::shutdown_both, ec);
+}
+}
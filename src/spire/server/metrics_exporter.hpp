@@ -0,0 +1,24 @@
+#pragma once
+
+#include <boost/asio.hpp>
+#include <boost/core/noncopyable.hpp>
+#include <spire/core/types.hpp>
+
+namespace spire {
+// Serves `Metrics::export_prometheus()` over plain HTTP for Prometheus scrapes
+class MetricsExporter final : boost::noncopyable {
+public:
+    MetricsExporter(const boost::asio::any_io_executor& io_executor, u16 port);
+    ~MetricsExporter();
+
+    void start();
+    void stop();
+
+private:
+    boost::asio::awaitable<void> serve(boost::asio::ip::tcp::socket socket);
+
+    std::atomic<bool> _is_running {false};
+
+    boost::asio::ip::tcp::acceptor _acceptor;
+};
+}
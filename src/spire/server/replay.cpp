@@ -0,0 +1,244 @@
+#include <spdlog/spdlog.h>
+#include <spire/core/settings.hpp>
+#include <spire/server/replay.hpp>
+
+#include <array>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <thread>
+
+namespace spire {
+static constexpr std::array<char, 4> MAGIC {'S', 'P', 'R', 'P'};
+static constexpr u16 VERSION {2};
+
+template <typename T>
+static void write(std::vector<std::byte>& target, const T value) {
+    const auto offset {target.size()};
+    target.resize(offset + sizeof(T));
+    std::memcpy(target.data() + offset, &value, sizeof(T));
+}
+
+static void write_bytes(std::vector<std::byte>& target, const std::span<const std::byte> bytes) {
+    write(target, static_cast<u32>(bytes.size()));
+    target.insert(target.end(), bytes.begin(), bytes.end());
+}
+
+template <typename T>
+static bool read(std::span<const std::byte>& source, T& value) {
+    if (source.size() < sizeof(T)) return false;
+
+    std::memcpy(&value, source.data(), sizeof(T));
+    source = source.subspan(sizeof(T));
+    return true;
+}
+
+static bool read_bytes(std::span<const std::byte>& source, std::span<const std::byte>& bytes) {
+    u32 size;
+    if (!read(source, size) || source.size() < size) return false;
+
+    bytes = source.first(size);
+    source = source.subspan(size);
+    return true;
+}
+
+
+// Writes the logs of every room on one thread, each in the order its updates were handed over
+class ReplayWriter final {
+public:
+    static ReplayWriter& instance() {
+        static ReplayWriter writer;
+        return writer;
+    }
+
+    // Takes the contents of `buffer` and leaves an empty one of an earlier write in it, false if more than
+    // `Settings::replay_pending_limit()` bytes would wait to be written
+    bool submit(const std::shared_ptr<std::FILE>& file, std::vector<std::byte>& buffer);
+
+private:
+    struct Job {
+        std::shared_ptr<std::FILE> file;
+        std::vector<std::byte> buffer;
+    };
+
+    ReplayWriter()
+        : _thread {[this](const std::stop_token stop_token) { run(stop_token); }} {}
+
+    void run(std::stop_token stop_token);
+
+    std::mutex _mutex {};
+    std::condition_variable_any _condition {};
+    std::deque<Job> _jobs {};
+    size_t _pending_bytes {0};
+    // Written buffers, handed back to the recorders so that they keep their capacity
+    std::vector<std::vector<std::byte>> _free_buffers {};
+
+    // Last, so that it stops before anything it uses is destroyed
+    std::jthread _thread;
+};
+
+bool ReplayWriter::submit(const std::shared_ptr<std::FILE>& file, std::vector<std::byte>& buffer) {
+    {
+        std::lock_guard lock {_mutex};
+        if (_pending_bytes + buffer.size() > Settings::replay_pending_limit()) return false;
+
+        _pending_bytes += buffer.size();
+        _jobs.push_back(Job {.file = file, .buffer = std::move(buffer)});
+
+        buffer.clear();
+        if (!_free_buffers.empty()) {
+            buffer = std::move(_free_buffers.back());
+            _free_buffers.pop_back();
+        }
+    }
+
+    _condition.notify_one();
+    return true;
+}
+
+void ReplayWriter::run(const std::stop_token stop_token) {
+    std::unique_lock lock {_mutex};
+    while (true) {
+        // Jobs handed over before stopping are still written
+        _condition.wait(lock, stop_token, [this] { return !_jobs.empty(); });
+        if (_jobs.empty()) return;
+
+        auto job {std::move(_jobs.front())};
+        _jobs.pop_front();
+        lock.unlock();
+
+        const auto size {job.buffer.size()};
+        if (std::fwrite(job.buffer.data(), 1, size, job.file.get()) != size) {
+            spdlog::warn("Could not write a replay log");
+        }
+        job.buffer.clear();
+        // Closes the log if its recorder is gone
+        job.file.reset();
+
+        lock.lock();
+        _pending_bytes -= size;
+        _free_buffers.push_back(std::move(job.buffer));
+    }
+}
+
+
+std::unique_ptr<ReplayRecorder> ReplayRecorder::open(
+    const std::filesystem::path& path,
+    const u32 room_id,
+    const std::string_view room_name,
+    const u64 random_seed) {
+    auto* const handle {std::fopen(path.c_str(), "wb")};
+    if (!handle) return nullptr;
+
+    std::unique_ptr<ReplayRecorder> recorder {
+        new ReplayRecorder {std::shared_ptr<std::FILE> {handle, [](std::FILE* file) { std::fclose(file); }}}};
+
+    // Written along with the first update
+    write(recorder->_buffer, MAGIC);
+    write(recorder->_buffer, VERSION);
+    write(recorder->_buffer, room_id);
+    write_bytes(recorder->_buffer, std::as_bytes(std::span {room_name.data(), room_name.size()}));
+    write(recorder->_buffer, random_seed);
+
+    return recorder;
+}
+
+ReplayRecorder::ReplayRecorder(std::shared_ptr<std::FILE>&& file)
+    : _file {std::move(file)} {}
+
+ReplayRecorder::~ReplayRecorder() {
+    if (!_file || _buffer.empty()) return;
+
+    ReplayWriter::instance().submit(_file, _buffer);
+}
+
+void ReplayRecorder::record_message(const u64 client_id, const std::span<const std::byte> data) {
+    if (!_file) return;
+
+    write(_buffer, ReplayRecord::Message);
+    write(_buffer, client_id);
+    write_bytes(_buffer, data);
+}
+
+void ReplayRecorder::record_command(const ReplayRecord kind, const u64 client_id) {
+    if (!_file) return;
+
+    write(_buffer, kind);
+    write(_buffer, client_id);
+}
+
+void ReplayRecorder::record_tick(
+    const time_point<steady_clock> now,
+    const time_point<steady_clock> last_update_time,
+    const u32 task_count) {
+    if (!_file) return;
+
+    write(_buffer, ReplayRecord::Tick);
+    write(_buffer, i64 {now.time_since_epoch().count()});
+    write(_buffer, i64 {last_update_time.time_since_epoch().count()});
+    write(_buffer, task_count);
+
+    if (ReplayWriter::instance().submit(_file, _buffer)) return;
+
+    // A log with gaps could not be replayed, so it ends at the last update written
+    spdlog::warn("Stopped recording a replay log, its writer fell behind");
+    _file.reset();
+    _buffer = {};
+}
+
+
+std::optional<ReplayReader> ReplayReader::open(const std::filesystem::path& path) {
+    std::error_code ec;
+    const auto size {std::filesystem::file_size(path, ec)};
+    if (ec) return std::nullopt;
+
+    std::ifstream file {path, std::ios::binary};
+    std::vector<std::byte> data(size);
+    if (!file.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(size))) return std::nullopt;
+
+    ReplayReader reader {std::move(data)};
+
+    std::array<char, 4> magic;
+    u16 version;
+    std::span<const std::byte> name;
+    if (!read(reader._remaining, magic) || magic != MAGIC) return std::nullopt;
+    if (!read(reader._remaining, version) || version != VERSION) return std::nullopt;
+    if (!read(reader._remaining, reader._room_id) || !read_bytes(reader._remaining, name)) return std::nullopt;
+    if (!read(reader._remaining, reader._random_seed)) return std::nullopt;
+
+    reader._room_name.assign(reinterpret_cast<const char*>(name.data()), name.size());
+    return reader;
+}
+
+ReplayReader::ReplayReader(std::vector<std::byte>&& data)
+    : _data {std::move(data)}, _remaining {_data} {}
+
+bool ReplayReader::next(ReplayTick& tick) {
+    tick.events.clear();
+
+    while (true) {
+        ReplayRecord kind;
+        if (!read(_remaining, kind) || kind > ReplayRecord::Tick) return false;
+
+        if (kind == ReplayRecord::Tick) {
+            i64 now;
+            i64 last_update_time;
+            if (!read(_remaining, now) || !read(_remaining, last_update_time) || !read(_remaining, tick.task_count)) {
+                return false;
+            }
+
+            tick.now = time_point<steady_clock> {steady_clock::duration {now}};
+            tick.last_update_time = time_point<steady_clock> {steady_clock::duration {last_update_time}};
+            return true;
+        }
+
+        ReplayEvent event {.kind = kind, .client_id = 0, .data = {}};
+        if (!read(_remaining, event.client_id)) return false;
+        if (kind == ReplayRecord::Message && !read_bytes(_remaining, event.data)) return false;
+
+        tick.events.push_back(event);
+    }
+}
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <boost/core/noncopyable.hpp>
+#include <spire/core/types.hpp>
+
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace spire {
+// A replay log holds everything a room update consumes, so that a room can be re-run offline by `tools/replay`.
+// After a header come records of a kind byte and fields in native byte order. The records of one update are its
+// messages in the order handled and its commands in the order executed, closed by a `Tick` record.
+// Deferred tasks are closures, they are only counted and rooms whose state depends on them do not replay exactly.
+enum class ReplayRecord : u8 {
+    Message,
+    Enter,
+    Leave,
+    Kick,
+    Tick,
+};
+
+struct ReplayEvent {
+    ReplayRecord kind;
+    u64 client_id;
+    // Body of a message as received, empty for commands
+    std::span<const std::byte> data;
+};
+
+struct ReplayTick {
+    // `Clock` time of the update and of the one before, which give its `dt`
+    time_point<steady_clock> now;
+    time_point<steady_clock> last_update_time;
+    u32 task_count;
+    std::vector<ReplayEvent> events;
+};
+
+
+// Appends the input of the updates of one room to a log. Records are collected in memory during an update and the
+// whole update is written by a background thread shared by every room, so that rooms never wait for the disk.
+class ReplayRecorder final : boost::noncopyable {
+public:
+    // Empty if `path` could not be created
+    static std::unique_ptr<ReplayRecorder> open(
+        const std::filesystem::path& path,
+        u32 room_id,
+        std::string_view room_name,
+        u64 random_seed);
+    // Writes the records of an unfinished update as well
+    ~ReplayRecorder();
+
+    void record_message(u64 client_id, std::span<const std::byte> data);
+    void record_command(ReplayRecord kind, u64 client_id);
+    // Closes the records of an update and hands them to the writer thread
+    void record_tick(time_point<steady_clock> now, time_point<steady_clock> last_update_time, u32 task_count);
+
+    // False once recording stopped because the writer fell behind, the log then ends at the last complete update
+    bool is_recording() const { return _file != nullptr; }
+
+private:
+    explicit ReplayRecorder(std::shared_ptr<std::FILE>&& file);
+
+    std::shared_ptr<std::FILE> _file;
+    std::vector<std::byte> _buffer {};
+};
+
+
+// Reads a log written by `ReplayRecorder` into memory, events refer to it until the reader is destroyed
+class ReplayReader final {
+public:
+    // Empty if `path` could not be read or is not a replay log
+    static std::optional<ReplayReader> open(const std::filesystem::path& path);
+    // Move only, events refer to the log held by the reader they were read from
+    ReplayReader(ReplayReader&& other) noexcept = default;
+    ReplayReader& operator=(ReplayReader&& other) noexcept = default;
+
+    // False at the end of the log, which may be cut short within an update that is then skipped
+    bool next(ReplayTick& tick);
+
+    u32 room_id() const { return _room_id; }
+    std::string_view room_name() const { return _room_name; }
+    // `Settings::random_seed()` of the recording server
+    u64 random_seed() const { return _random_seed; }
+
+private:
+    explicit ReplayReader(std::vector<std::byte>&& data);
+
+    std::vector<std::byte> _data;
+    // Not read yet, within `_data`
+    std::span<const std::byte> _remaining;
+    u32 _room_id {0};
+    std::string _room_name {};
+    u64 _random_seed {0};
+};
+}
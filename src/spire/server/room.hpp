@@ -1,11 +1,34 @@
 #pragma once
 
+#include <entt/entt.hpp>
+#include <glm/geometric.hpp>
 #include <spdlog/spdlog.h>
+#include <spire/component/input_components.hpp>
+#include <spire/component/physics_components.hpp>
 #include <spire/container/concurrent_queue.hpp>
+#include <spire/container/task.hpp>
+#include <spire/core/clock.hpp>
+#include <spire/core/game_data.hpp>
+#include <spire/core/metrics.hpp>
+#include <spire/core/random.hpp>
+#include <spire/core/settings.hpp>
+#include <spire/core/tick_arena.hpp>
 #include <spire/net/client.hpp>
+#include <spire/net/send_batch.hpp>
 #include <spire/handler/handler_controller.hpp>
-
+#include <spire/server/client_table.hpp>
+#include <spire/server/replay.hpp>
+#include <spire/server/room_directory.hpp>
+#include <spire/server/tick_profiler.hpp>
+#include <spire/system/collision_system.hpp>
+#include <spire/system/input_system.hpp>
+#include <spire/system/physics_system.hpp>
+#include <spire/system/transform_history.hpp>
+
+#include <cmath>
+#include <optional>
 #include <ranges>
+#include <variant>
 
 namespace spire {
 template <typename ClientType>
@@ -13,10 +36,11 @@ class Room;
 
 using TcpRoom = Room<net::TcpClient>;
 using SslRoom = Room<net::SslClient>;
+using LoopbackRoom = Room<net::LoopbackClient>;
 
 
 template <typename ClientType>
-class Room : public std::enable_shared_from_this<Room<ClientType>>, boost::noncopyable {
+class Room : public RoomControl, public std::enable_shared_from_this<Room<ClientType>>, boost::noncopyable {
     enum class State : u8 {
         Idle,
         Active,
@@ -24,20 +48,39 @@ class Room : public std::enable_shared_from_this<Room<ClientType>>, boost::nonco
     };
 
 public:
-    Room(u32 id, boost::asio::any_io_executor& io_executor);
-    virtual ~Room();
+    Room(u32 id, std::string_view name, boost::asio::any_io_executor& io_executor);
+    ~Room() override;
 
     void start();
     void stop();
     void terminate();
+    // Preallocates for `clients` clients and `entities` entities, must be called before the room is started
+    void reserve(size_t clients, size_t entities);
+    // Logs the input of every update for `tools/replay`, must be called before the room is started
+    void record_replay(std::unique_ptr<ReplayRecorder> recorder);
+    // Gives every client entering afterwards a character moved by its `Move` commands at up to `max_speed`, for rooms
+    // simulating the world rather than only routing messages. Must be called before the room is started.
+    void simulate_characters(Speed max_speed);
+    // Restarts the random numbers of the room as if `Settings::random_seed()` was `seed`, to replay a recorded run
+    void seed_random(u64 seed) { _random = Random {seed, _id}; }
+    // Runs one update of a replay log on the calling thread, in place of the update loop of `start()`. `Clock` must
+    // be virtual and at `tick.now`, `client_of` returns the client standing in for a recorded client id.
+    template <typename ClientOf>
+    void replay(const ReplayTick& tick, ClientOf&& client_of);
 
     void add_client_deferred(std::shared_ptr<ClientType> client);
     void remove_client_deferred(std::shared_ptr<ClientType> client);
 
-    void post_task(std::function<void()>&& task);
+    void post_task(Task&& task);
     void broadcast_message_deferred(std::shared_ptr<net::OutMessage> message);
 
-    u32 id() const { return _id; }
+    void kick_client_deferred(u64 client_id) override;
+    void drain_deferred() override;
+
+    u32 id() const override { return _id; }
+    std::string_view name() const override { return _name; }
+    TickProfiler& profiler() override { return _profiler; }
+    std::shared_ptr<const RoomSnapshot> snapshot() const override { return _snapshot.load(); }
 
 private:
     virtual void on_started() {}
@@ -46,28 +89,130 @@ private:
 
     virtual void on_client_entered(const std::shared_ptr<ClientType>& /*client*/) {}
     virtual void on_client_left(const std::shared_ptr<ClientType>& /*client*/) {}
+    // Called on the thread that stopped the client, before it leaves the room
+    virtual void on_client_stopped(
+        const std::shared_ptr<ClientType>& /*client*/,
+        typename ClientType::StopCode /*code*/) {}
+
+    // Built-in deferred operations, queued without type erasure
+    struct Command {
+        enum class Type : u8 {
+            Enter,
+            Leave,
+            Broadcast,
+            Kick,
+        };
+
+        Type type;
+        std::shared_ptr<ClientType> client {};
+        std::shared_ptr<net::OutMessage> message {};
+        u64 client_id {0};
+    };
+
+    void execute(Command& command);
+    // Components of the character of an entering client
+    void spawn_character(entt::entity entity);
+    // Buffers the command for the entity of `client` if it has `Movement`
+    HandlerResult handle_move(const std::shared_ptr<ClientType>& client, const msg::Move& move);
 
     void update(time_point<steady_clock> last_update_time);
     virtual void update_internal(time_point<steady_clock> /*now*/, f32 /*dt*/) {}
 
+    metrics::Histogram& handler_duration(msg::BaseMessage::MessageCase message_case);
+    void publish_snapshot(time_point<steady_clock> now);
+
 protected:
     HandlerController<ClientType> _handler_controller {};
+    entt::registry _registry {};
+    // Every client is represented by an entity of `_registry` while in the room
+    ClientTable<ClientType> _clients {};
+    physics::TransformHistory _transform_history;
+    // Run after movement every update, `build_static` is up to subclasses whenever they change static bodies
+    physics::CollisionSystem _collision_system {};
+    // Taken at the start of every update, so that data reloaded meanwhile is not unmapped while the update uses it
+    std::shared_ptr<const GameData> _game_data {};
+    // Drawn from by the room thread only, the same for every run with the same seed and input
+    Random _random;
+    // Set by `simulate_characters`
+    std::optional<Speed> _character_speed {};
+
+    // Where the other entities were when `shooter` saw them, its round trip plus the delay its client renders
+    // them behind. Hit checks of its actions rewind their targets to it through `_transform_history`.
+    std::optional<physics::TransformHistory::Rewind> rewind_for(const ClientType& shooter) const;
 
 private:
     const u32 _id;
+    const std::string _name;
     std::atomic<State> _state {State::Idle};
+    std::atomic<bool> _is_draining {false};
+    bool _is_replaying {false};
 
     boost::asio::any_io_executor& _io_executor;
 
-    std::unordered_map<std::shared_ptr<ClientType>, typename ClientType::Signals> _clients {};
-    ConcurrentQueue<std::function<void()>> _tasks {};
+    // Commands and tasks share one queue, so that they run in the order they were posted
+    ConcurrentQueue<std::variant<Command, Task>> _tasks {};
     net::MessageQueue<ClientType> _messages {};
+
+    metrics::Histogram& _tick_duration;
+    metrics::Histogram& _messages_per_tick;
+    metrics::Histogram& _tasks_per_tick;
+    metrics::Gauge& _client_count;
+    metrics::Counter& _arena_overflow;
+    TickProfiler _profiler;
+    TickArena _arena;
+    net::SendBatch _send_batch {};
+    std::unique_ptr<ReplayRecorder> _replay_recorder {};
+
+    std::atomic<std::shared_ptr<const RoomSnapshot>> _snapshot {};
+    time_point<steady_clock> _last_snapshot_time {};
+    u64 _tick_count {0};
+    u64 _interval_ticks {0};
+    nanoseconds _interval_tick_sum {};
+    nanoseconds _interval_tick_max {};
+    // Indexed by message case
+    std::vector<metrics::Histogram*> _handler_durations {};
 };
 
 
 template <typename ClientType>
-Room<ClientType>::Room(const u32 id, boost::asio::any_io_executor& io_executor)
-    : _id {id}, _io_executor {io_executor} {}
+Room<ClientType>::Room(const u32 id, const std::string_view name, boost::asio::any_io_executor& io_executor)
+    : _transform_history {Settings::transform_history_size()},
+    _random {Settings::random_seed(), id},
+    _id {id},
+    _name {name},
+    _io_executor {io_executor},
+    _tick_duration {metrics::Metrics::histogram(
+        "spire_room_tick_duration_seconds",
+        "Time spent in a room update",
+        {{"room", _name}, {"id", std::to_string(_id)}})},
+    _messages_per_tick {metrics::Metrics::histogram(
+        "spire_room_messages_per_tick",
+        "Messages drained by a room update",
+        {{"room", _name}, {"id", std::to_string(_id)}},
+        1.0)},
+    _tasks_per_tick {metrics::Metrics::histogram(
+        "spire_room_tasks_per_tick",
+        "Tasks drained by a room update",
+        {{"room", _name}, {"id", std::to_string(_id)}},
+        1.0)},
+    _client_count {metrics::Metrics::gauge(
+        "spire_room_clients",
+        "Clients in a room",
+        {{"room", _name}, {"id", std::to_string(_id)}})},
+    _arena_overflow {metrics::Metrics::counter(
+        "spire_room_arena_overflow_bytes_total",
+        "Tick arena allocations served by the global allocator",
+        {{"room", _name}, {"id", std::to_string(_id)}})},
+    _profiler {_id, _name},
+    _arena {Settings::tick_arena_size(), Settings::tick_message_arena_size()} {
+    // Answers to the heartbeats of the client, which measure its ping
+    _handler_controller.add_handler([](const std::shared_ptr<ClientType>& client, const msg::BaseMessage& base) {
+        if (base.message_case() != msg::BaseMessage::kHeartbeat) return HandlerResult::Continue;
+
+        client->on_heartbeat();
+        return HandlerResult::Continue;
+    });
+}
 
 template <typename ClientType>
 Room<ClientType>::~Room() {
@@ -79,9 +224,12 @@ void Room<ClientType>::start() {
     if (_state == State::Terminating) return;
     if (_state.exchange(State::Active) == State::Active) return;
 
-    post(_io_executor, [self = this->shared_from_this()] {
-        self->update(steady_clock::now());
-    });
+    // Replays run every update themselves
+    if (!_is_replaying) {
+        post(_io_executor, [self = this->shared_from_this()] {
+            self->update(Clock::now());
+        });
+    }
 
     on_started();
 }
@@ -103,6 +251,69 @@ void Room<ClientType>::terminate() {
     on_terminated();
 }
 
+template <typename ClientType>
+void Room<ClientType>::reserve(const size_t clients, const size_t entities) {
+    _clients.reserve(clients);
+
+    // Histograms are otherwise registered by the first message of each case
+    const auto* descriptor {msg::BaseMessage::descriptor()};
+    for (i32 i {0}; i < descriptor->field_count(); ++i)
+        handler_duration(static_cast<msg::BaseMessage::MessageCase>(descriptor->field(i)->number()));
+
+    if (entities == 0) return;
+
+    _registry.storage<entt::entity>().reserve(entities);
+    _registry.storage<Transform>().reserve(entities);
+    _registry.storage<DynamicPhysics>().reserve(entities);
+
+    // Reserved storage is only mapped once written, so fill it once and recycle the identifiers
+    for (size_t i {0}; i < entities; ++i) {
+        const auto entity {_registry.create()};
+        _registry.emplace<Transform>(entity, glm::vec3 {}, 0.0f);
+        _registry.emplace<DynamicPhysics>(entity, glm::vec3 {}, Acceleration {0.0f});
+    }
+    _registry.clear();
+}
+
+template <typename ClientType>
+void Room<ClientType>::record_replay(std::unique_ptr<ReplayRecorder> recorder) {
+    _replay_recorder = std::move(recorder);
+}
+
+template <typename ClientType>
+template <typename ClientOf>
+void Room<ClientType>::replay(const ReplayTick& tick, ClientOf&& client_of) {
+    _is_replaying = true;
+
+    // Queued as they were when recorded, so that the update handles them in the same order
+    for (const auto& event : tick.events) {
+        switch (event.kind) {
+        case ReplayRecord::Message:
+            _messages.push(std::make_pair(
+                client_of(event.client_id),
+                std::make_unique<net::InMessage>(std::vector<std::byte> {event.data.begin(), event.data.end()})));
+            break;
+
+        case ReplayRecord::Enter:
+            add_client_deferred(client_of(event.client_id));
+            break;
+
+        case ReplayRecord::Leave:
+            remove_client_deferred(client_of(event.client_id));
+            break;
+
+        case ReplayRecord::Kick:
+            kick_client_deferred(client_of(event.client_id)->id());
+            break;
+
+        case ReplayRecord::Tick:
+            break;
+        }
+    }
+
+    update(tick.last_update_time);
+}
+
 template <typename ClientType>
 void Room<ClientType>::add_client_deferred(std::shared_ptr<ClientType> client) {
     if (!client) return;
@@ -111,80 +322,340 @@ void Room<ClientType>::add_client_deferred(std::shared_ptr<ClientType> client) {
         start();
     }
 
-    _tasks.push([this, new_client = std::move(client)] mutable {
+    _tasks.push(Command {.type = Command::Type::Enter, .client = std::move(client)});
+}
+
+template <typename ClientType>
+void Room<ClientType>::remove_client_deferred(std::shared_ptr<ClientType> client) {
+    if (!client) return;
+
+    _tasks.push(Command {.type = Command::Type::Leave, .client = std::move(client)});
+}
+
+template <typename ClientType>
+void Room<ClientType>::post_task(Task&& task) {
+    _tasks.push(std::move(task));
+}
+
+template <typename ClientType>
+void Room<ClientType>::broadcast_message_deferred(std::shared_ptr<net::OutMessage> message) {
+    _tasks.push(Command {.type = Command::Type::Broadcast, .message = std::move(message)});
+}
+
+template <typename ClientType>
+void Room<ClientType>::kick_client_deferred(const u64 client_id) {
+    _tasks.push(Command {.type = Command::Type::Kick, .client_id = client_id});
+}
+
+template <typename ClientType>
+void Room<ClientType>::drain_deferred() {
+    _is_draining = true;
+
+    _tasks.push([this] {
+        // Reconnects are spread over the window so that clients do not return all at once
+        const auto window {Settings::drain_reconnect_window()};
+        size_t index {0};
+        for (const auto& client : _clients.clients()) {
+            auto* reconnect {new msg::Reconnect};
+            reconnect->set_delay(static_cast<u32>((window * index++ / _clients.size()).count()));
+
+            msg::BaseMessage base {};
+            base.set_allocated_reconnect(reconnect);
+            client->send(std::make_unique<net::OutMessage>(base));
+        }
+
+        // Next tick, once the send batch holding the reconnect messages was flushed
+        _tasks.push([this] {
+            // Stopping a client removes it from `_clients` through a deferred task
+            for (const auto& client : _clients.clients())
+                client->drain();
+        });
+    });
+}
+
+template <typename ClientType>
+void Room<ClientType>::execute(Command& command) {
+    switch (command.type) {
+    case Command::Type::Enter: {
+        auto& new_client {command.client};
         if (new_client->state() == ClientType::State::Terminating) return;
+        if (_is_draining) {
+            new_client->stop(ClientType::StopCode::Normal);
+            return;
+        }
+
+        // Only clients that actually enter are recorded, a replay has nothing to reject
+        if (_replay_recorder) {
+            _replay_recorder->record_command(ReplayRecord::Enter, new_client->id());
+        }
 
-        _clients[new_client] = new_client->bind(
+        auto signals {new_client->bind(
             &_messages,
             [this](std::shared_ptr<ClientType> stopped_client, const typename ClientType::StopCode code) {
                 if (code != ClientType::StopCode::Normal) {
-                    spdlog::debug("Client(TODO) stopped abnormally with code {}", std::to_underlying(code));
+                    spdlog::debug(
+                        "Room {}: client {} stopped abnormally with code {}",
+                        _id,
+                        stopped_client->id(),
+                        std::to_underlying(code));
                 }
 
+                on_client_stopped(stopped_client, code);
                 remove_client_deferred(stopped_client);
-            });
+            })};
+        const auto entity {_registry.create()};
+        _clients.add(new_client, std::move(signals), entity);
+        if (_character_speed) {
+            spawn_character(entity);
+        }
 
         on_client_entered(std::move(new_client));
-    });
+        return;
+    }
+
+    case Command::Type::Leave: {
+        const auto handle {_clients.find(*command.client)};
+        const auto entity {_clients.entity(handle)};
+        if (!_clients.remove(handle)) return;
+
+        if (_replay_recorder) {
+            _replay_recorder->record_command(ReplayRecord::Leave, command.client->id());
+        }
+
+        // Handlers may still use the entity, it is destroyed once they were told
+        on_client_left(command.client);
+        _registry.destroy(entity);
+        return;
+    }
+
+    case Command::Type::Broadcast:
+        for (const auto& client : _clients.clients())
+            client->send(command.message);
+        return;
+
+    case Command::Type::Kick:
+        if (_replay_recorder) {
+            _replay_recorder->record_command(ReplayRecord::Kick, command.client_id);
+        }
+
+        for (const auto& client : _clients.clients()) {
+            if (client->id() != command.client_id) continue;
+
+            client->stop(ClientType::StopCode::Kicked);
+            return;
+        }
+        return;
+    }
 }
 
 template <typename ClientType>
-void Room<ClientType>::remove_client_deferred(std::shared_ptr<ClientType> client) {
-    if (!client) return;
+void Room<ClientType>::simulate_characters(const Speed max_speed) {
+    if (_character_speed) return;
+    _character_speed = max_speed;
 
-    _tasks.push([this, client = std::move(client)] mutable {
-        if (!_clients.erase(client)) return;
+    _handler_controller.add_handler([this](const std::shared_ptr<ClientType>& client, const msg::BaseMessage& base) {
+        if (base.message_case() != msg::BaseMessage::kMove) return HandlerResult::Continue;
 
-        on_client_left(std::move(client));
+        return handle_move(client, base.move());
     });
 }
 
 template <typename ClientType>
-void Room<ClientType>::post_task(std::function<void()>&& task) {
-    _tasks.push(std::move(task));
+void Room<ClientType>::spawn_character(const entt::entity entity) {
+    _registry.emplace<Transform>(entity, glm::vec3 {0.0f}, 0.0f);
+    _registry.emplace<DynamicPhysics>(entity, glm::vec3 {0.0f}, Acceleration {0.0f});
+    _registry.emplace<Movement>(entity, *_character_speed);
+    // Roughly human sized
+    _registry.emplace<Collider>(entity, Collider::capsule(0.4f, 0.5f));
 }
 
 template <typename ClientType>
-void Room<ClientType>::broadcast_message_deferred(std::shared_ptr<net::OutMessage> message) {
-    _tasks.push([self = this->shared_from_this(), message = std::move(message)] {
-        for (const auto& client : self->_clients | std::views::keys)
-            client->send(message);
-    });
+HandlerResult Room<ClientType>::handle_move(const std::shared_ptr<ClientType>& client, const msg::Move& move) {
+    const auto entity {_clients.entity(_clients.find(*client))};
+    if (entity == entt::null || !_registry.all_of<Movement>(entity)) return HandlerResult::Continue;
+
+    glm::vec3 direction {move.direction_x(), 0.0f, move.direction_z()};
+    const f32 length {glm::length(direction)};
+    if (!std::isfinite(length) || !std::isfinite(move.rotation())) return HandlerResult::Break;
+
+    // Longer directions would move faster than allowed
+    if (length > 1.0f) {
+        direction /= length;
+    }
+
+    _registry.get_or_emplace<InputBuffer>(entity).push(InputCommand {
+        .tick = move.tick(),
+        .direction = direction,
+        .rotation = move.rotation()});
+    return HandlerResult::Break;
+}
+
+template <typename ClientType>
+std::optional<physics::TransformHistory::Rewind> Room<ClientType>::rewind_for(const ClientType& shooter) const {
+    // Bounded, or clients could claim a lag that lets them hit whatever stood anywhere within the history
+    const auto lag {std::min<milliseconds>(
+        shooter.ping() + Settings::lag_compensation_delay(),
+        Settings::lag_compensation_limit())};
+    return _transform_history.rewind(Clock::now() - lag);
 }
 
 template <typename ClientType>
 void Room<ClientType>::update(const time_point<steady_clock> last_update_time) {
     if (_state == State::Terminating) return;
 
+    const auto update_start {steady_clock::now()};
+    _profiler.begin_tick(update_start);
+
+    // Handlers and systems allocate tick-scoped data from the arena, freed at once when the update returns
+    TickArena::Scope arena_scope {_arena};
+    _game_data = GameData::current();
+
+    // Everything sent to a client during this tick leaves as one write when the scope ends
+    std::optional<net::SendBatch::Scope> send_batch_scope {};
+    if (Settings::send_batching()) {
+        send_batch_scope.emplace(_send_batch);
+    }
+
     // TODO: IO threads are handling messages and tasks
     // -> Let work threads handle these
     std::queue<std::pair<std::shared_ptr<ClientType>, std::unique_ptr<net::InMessage>>> messages;
     _messages.swap(messages);
+    const auto message_count {static_cast<u32>(messages.size())};
+    _messages_per_tick.record(u64 {message_count});
+    auto handle_start {steady_clock::now()};
     while (!messages.empty()) {
         auto [client, message] = std::move(messages.front());
-        _handler_controller.handle(client, std::move(message));
+        if (_replay_recorder) {
+            _replay_recorder->record_message(client->id(), message->span());
+        }
+
+        const auto message_case {_handler_controller.handle(client, std::move(message))};
+        const auto handle_end {steady_clock::now()};
+        handler_duration(message_case).record(handle_end - handle_start);
+        _profiler.record_handler(message_case, handle_end - handle_start);
+        handle_start = handle_end;
+
         messages.pop();
     }
+    _profiler.end_phase(TickProfiler::Phase::Messages, handle_start);
 
-    std::queue<std::function<void()>> tasks;
+    std::queue<std::variant<Command, Task>> tasks;
     _tasks.swap(tasks);
+    const auto task_count {static_cast<u32>(tasks.size())};
+    _tasks_per_tick.record(u64 {task_count});
     while (!tasks.empty()) {
-        tasks.front()();
+        if (auto* const command {std::get_if<Command>(&tasks.front())}) {
+            execute(*command);
+        }
+        else {
+            std::get<Task>(tasks.front())();
+        }
         tasks.pop();
     }
 
+    _client_count.set(static_cast<i64>(_clients.size()));
+
+    const auto tasks_end {steady_clock::now()};
+    _profiler.end_phase(TickProfiler::Phase::Tasks, tasks_end);
+
+    // Profiling measures real time, while the simulation follows `Clock` which may be virtual
+    const auto now {Clock::now()};
+    if (_replay_recorder) {
+        _replay_recorder->record_tick(now, last_update_time, task_count);
+    }
+
     if (_clients.empty() && _state == State::Active) {
+        _profiler.end_tick(tasks_end, message_count, task_count);
+        publish_snapshot(now);
         stop();
         return;
     }
 
-    const auto now {steady_clock::now()};
+    if (now - _last_snapshot_time >= Settings::room_snapshot_interval()) {
+        publish_snapshot(now);
+    }
+
     const f32 dt {duration<f32, std::milli> {now - last_update_time}.count()};
 
+    physics::InputSystem::update(_registry);
+    physics::PhysicsSystem::update(_registry, duration<f32> {now - last_update_time}.count());
+    _collision_system.update(_registry);
     update_internal(now, dt);
+    _transform_history.record(now, Settings::transform_history_interval(), _registry);
+    send_batch_scope.reset();
+
+    const auto update_end {steady_clock::now()};
+    _profiler.end_phase(TickProfiler::Phase::Systems, update_end);
+    _profiler.end_tick(update_end, message_count, task_count);
+    _tick_duration.record(update_end - update_start);
+
+    ++_tick_count;
+    ++_interval_ticks;
+    _interval_tick_sum += update_end - update_start;
+    _interval_tick_max = std::max<nanoseconds>(_interval_tick_max, update_end - update_start);
+
+    if (_is_replaying) return;
 
     defer(_io_executor, [self = this->shared_from_this(), now] {
         self->update(now);
     });
 }
+
+template <typename ClientType>
+metrics::Histogram& Room<ClientType>::handler_duration(const msg::BaseMessage::MessageCase message_case) {
+    const auto index {static_cast<size_t>(message_case)};
+    if (index >= _handler_durations.size()) {
+        _handler_durations.resize(index + 1);
+    }
+
+    auto& histogram {_handler_durations[index]};
+    if (!histogram) {
+        const auto* field {msg::BaseMessage::descriptor()->FindFieldByNumber(message_case)};
+        histogram = &metrics::Metrics::histogram(
+            "spire_handler_duration_seconds",
+            "Time spent handling a message",
+            {{"message", field ? std::string {field->name()} : "invalid"}});
+    }
+
+    return *histogram;
+}
+
+template <typename ClientType>
+void Room<ClientType>::publish_snapshot(const time_point<steady_clock> now) {
+    auto snapshot {std::make_shared<RoomSnapshot>()};
+    snapshot->id = _id;
+    snapshot->name = _name;
+    snapshot->time = now;
+    snapshot->is_draining = _is_draining;
+
+    snapshot->ticks = _tick_count;
+    if (_interval_ticks != 0) {
+        const duration<f64> interval {now - _last_snapshot_time};
+        snapshot->ticks_per_second = static_cast<f64>(_interval_ticks) / interval.count();
+        snapshot->mean_tick = _interval_tick_sum / _interval_ticks;
+        snapshot->max_tick = _interval_tick_max;
+    }
+    snapshot->pending_messages = _messages.size();
+    snapshot->pending_tasks = _tasks.size();
+
+    const auto arena_stats {_arena.take_stats()};
+    snapshot->arena_peak_bytes = arena_stats.peak_bytes;
+    snapshot->arena_overflow_bytes = arena_stats.overflow_bytes;
+    _arena_overflow.add(arena_stats.overflow_bytes);
+
+    snapshot->clients.reserve(_clients.size());
+    for (const auto& client : _clients.clients()) {
+        snapshot->clients.push_back(ClientSnapshot {
+            .id = client->id(),
+            .ping = client->ping(),
+            .queued_bytes = client->queued_bytes()});
+    }
+
+    _snapshot.store(std::move(snapshot));
+
+    _last_snapshot_time = now;
+    _interval_ticks = 0;
+    _interval_tick_sum = {};
+    _interval_tick_max = {};
+}
 }
@@ -0,0 +1,35 @@
+#include <spire/server/room_directory.hpp>
+
+#include <format>
+
+namespace spire {
+void RoomDirectory::add(const std::shared_ptr<RoomControl>& room) {
+    std::lock_guard lock {_mutex};
+
+    _rooms.push_back(room);
+}
+
+std::vector<std::shared_ptr<RoomControl>> RoomDirectory::rooms() {
+    std::lock_guard lock {_mutex};
+
+    std::erase_if(_rooms, [](const auto& room) { return room.expired(); });
+
+    std::vector<std::shared_ptr<RoomControl>> rooms;
+    rooms.reserve(_rooms.size());
+    for (const auto& room : _rooms) {
+        if (auto locked {room.lock()}) rooms.push_back(std::move(locked));
+    }
+
+    return rooms;
+}
+
+std::vector<std::shared_ptr<RoomControl>> RoomDirectory::find(const std::string_view selector) {
+    auto rooms {this->rooms()};
+
+    std::erase_if(rooms, [selector](const auto& room) {
+        return room->name() != selector && std::format("{}:{}", room->name(), room->id()) != selector;
+    });
+
+    return rooms;
+}
+}
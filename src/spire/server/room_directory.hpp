@@ -0,0 +1,68 @@
+#pragma once
+
+#include <boost/core/noncopyable.hpp>
+#include <spire/core/types.hpp>
+#include <spire/server/tick_profiler.hpp>
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace spire {
+struct ClientSnapshot {
+    u64 id;
+    milliseconds ping;
+    size_t queued_bytes;
+};
+
+// Read-only view of a room, published periodically by the room itself
+struct RoomSnapshot {
+    u32 id;
+    std::string name;
+    steady_clock::time_point time;
+    bool is_draining;
+
+    u64 ticks;
+    f64 ticks_per_second;
+    nanoseconds mean_tick;
+    nanoseconds max_tick;
+    size_t pending_messages;
+    size_t pending_tasks;
+    // Since the previous snapshot
+    size_t arena_peak_bytes;
+    size_t arena_overflow_bytes;
+
+    std::vector<ClientSnapshot> clients;
+};
+
+// Type-erased control surface of a room, safe to use from any thread
+class RoomControl {
+public:
+    virtual ~RoomControl() = default;
+
+    virtual u32 id() const = 0;
+    virtual std::string_view name() const = 0;
+    virtual TickProfiler& profiler() = 0;
+
+    // Null until the room has run its first update
+    virtual std::shared_ptr<const RoomSnapshot> snapshot() const = 0;
+
+    virtual void kick_client_deferred(u64 client_id) = 0;
+    // Stops every client and rejects clients added afterwards
+    virtual void drain_deferred() = 0;
+};
+
+class RoomDirectory final : boost::noncopyable {
+public:
+    void add(const std::shared_ptr<RoomControl>& room);
+
+    // Live rooms, expired ones are pruned
+    std::vector<std::shared_ptr<RoomControl>> rooms();
+    // `selector` is either `name` or `name:id`
+    std::vector<std::shared_ptr<RoomControl>> find(std::string_view selector);
+
+private:
+    std::mutex _mutex {};
+    std::vector<std::weak_ptr<RoomControl>> _rooms {};
+};
+}
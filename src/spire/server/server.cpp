@@ -1,22 +1,59 @@
 #include <spdlog/spdlog.h>
 #include <boost/asio/experimental/awaitable_operators.hpp>
+#include <spire/core/log.hpp>
+#include <spire/core/metrics.hpp>
 #include <spire/core/settings.hpp>
+#include <spire/net/buffer_pool.hpp>
+#include <spire/net/socket_tuning.hpp>
 #include <spire/server/server.hpp>
 #include <spire/room/admin_room.hpp>
 #include <spire/room/waiting_room.hpp>
+#include <unistd.h>
+
+#include <algorithm>
 
 namespace spire {
+// Adopts a listener handed over by a predecessor, or binds a new one
+static void open_listener(
+    boost::asio::ip::tcp::acceptor& acceptor,
+    const int inherited,
+    const u16 port,
+    const SocketTuning& tuning,
+    const std::string_view name) {
+    if (inherited != -1) {
+        acceptor.assign(boost::asio::ip::tcp::v4(), inherited);
+        spdlog::info("Server took over {} listener on port {}", name, acceptor.local_endpoint().port());
+    }
+    else {
+        acceptor.open(boost::asio::ip::tcp::v4());
+        acceptor.set_option(boost::asio::socket_base::reuse_address(true));
+        acceptor.bind(boost::asio::ip::tcp::endpoint {boost::asio::ip::tcp::v4(), port});
+    }
+
+    net::tune_listener(acceptor, tuning, name);
+    acceptor.listen(Settings::listen_backlog());
+}
+
 Server::Server(boost::asio::any_io_executor&& io_executor)
+    : Server {
+        std::move(io_executor),
+        Settings::handoff_socket().empty() ? std::nullopt : Handoff::take_over(Settings::handoff_socket())} {}
+
+Server::Server(boost::asio::any_io_executor&& io_executor, const std::optional<HandoffState>& inherited)
     : _io_executor {std::move(io_executor)},
     _io_strand {make_strand(_io_executor)},
-    _game_acceptor {
-        make_strand(_io_executor),
-        boost::asio::ip::tcp::endpoint {boost::asio::ip::tcp::v4(), Settings::game_listen_port()}},
-    _admin_acceptor {
-        make_strand(_io_executor),
-        boost::asio::ip::tcp::endpoint {boost::asio::ip::tcp::v4(), Settings::admin_listen_port()}},
-    _waiting_room {std::make_shared<WaitingRoom>(_io_executor)},
-    _admin_room {std::make_shared<AdminRoom>(_io_executor)} {
+    _game_acceptor {make_strand(_io_executor)},
+    _admin_acceptor {make_strand(_io_executor)},
+    _handoff_acceptor {_io_strand},
+    _udp_transport {
+        Settings::udp_listen_port() != 0
+            ? std::make_unique<net::UdpTransport>(
+                _io_executor, Settings::udp_listen_port(), inherited ? inherited->udp_fd : -1)
+            : nullptr},
+    _waiting_room {std::make_shared<WaitingRoom>(_io_executor, _udp_transport.get(), &_session_table)},
+    _admin_room {std::make_shared<AdminRoom>(_io_executor, _room_directory)} {
+    _room_directory.add(_waiting_room);
+    _room_directory.add(_admin_room);
 
     _ssl_context.set_options(
         boost::asio::ssl::context::default_workarounds |
@@ -27,38 +64,88 @@ Server::Server(boost::asio::any_io_executor&& io_executor)
         boost::asio::ssl::context::no_tlsv1_2);
     _ssl_context.use_certificate_chain_file(Settings::certificate_file());
     _ssl_context.use_private_key_file(Settings::private_key_file(), boost::asio::ssl::context::pem);
+    // Admin commands drain, kick and reconfigure, so the handshake already fails without a certificate of an admin
+    _ssl_context.load_verify_file(Settings::admin_ca_file());
+    _ssl_context.set_verify_mode(boost::asio::ssl::verify_peer | boost::asio::ssl::verify_fail_if_no_peer_cert);
+
+    open_listener(
+        _game_acceptor,
+        inherited ? inherited->game_fd : -1,
+        Settings::game_listen_port(),
+        Settings::game_socket_tuning(),
+        "game");
+    open_listener(
+        _admin_acceptor,
+        inherited ? inherited->admin_fd : -1,
+        Settings::admin_listen_port(),
+        Settings::admin_socket_tuning(),
+        "admin");
+
+    if (inherited) {
+        // A datagram socket no longer wanted by this configuration
+        if (!_udp_transport && inherited->udp_fd != -1) {
+            close(inherited->udp_fd);
+        }
 
-    _game_acceptor.set_option(boost::asio::socket_base::reuse_address(true));
-    _game_acceptor.listen(Settings::listen_backlog());
+        if (!_session_table.deserialize(inherited->sessions)) {
+            spdlog::warn("Server could not take over sessions of its predecessor");
+        }
+    }
 
-    _admin_acceptor.set_option(boost::asio::socket_base::reuse_address(true));
+    if (Settings::metrics_listen_port() != 0) {
+        _metrics_exporter = std::make_unique<MetricsExporter>(_io_executor, Settings::metrics_listen_port());
+    }
 }
 
 Server::~Server() {
     stop();
 }
 
-void Server::start() {
+void Server::start(std::function<void()>&& on_drained) {
     if (_is_running.exchange(true)) return;
 
+    _on_drained = std::move(on_drained);
+    warmup();
+    listen_handoff();
+
+    if (_metrics_exporter) {
+        _metrics_exporter->start();
+    }
+
+    if (_udp_transport) {
+        _udp_transport->start();
+        spdlog::info("Server listening datagrams on port {}", Settings::udp_listen_port());
+    }
+
     // Spawn game acceptor loop
     co_spawn(_io_executor, [this] -> boost::asio::awaitable<void> {
         spdlog::info("Server listening game on port {}", Settings::game_listen_port());
 
-        while (_is_running) {
+        auto& accepted {metrics::Metrics::counter(
+            "spire_server_accepted_total", "Sockets accepted by a listener", {{"listener", "game"}})};
+        auto& accept_errors {metrics::Metrics::counter(
+            "spire_server_accept_errors_total", "Failed accepts and socket setups", {{"listener", "game"}})};
+        LogLimiter error_log {Settings::log_rate_limit()};
+
+        while (_is_running && !_is_draining) {
             auto [ec, socket] = co_await _game_acceptor.async_accept(boost::asio::as_tuple(boost::asio::use_awaitable));
+            if (ec == boost::asio::error::operation_aborted) continue;
             if (ec) {
-                spdlog::warn("Error accepting game socket");
+                accept_errors.add();
+                error_log.log(spdlog::level::warn, "Error accepting game socket: {}", ec.message());
                 continue;
             }
 
             spdlog::debug("Server accepted game socket from {}", socket.local_endpoint().address().to_string());
 
-            if (socket.set_option(boost::asio::ip::tcp::no_delay(Settings::tcp_no_delay()), ec)) {
-                spdlog::warn("Error setting socket option");
+            if (socket.set_option(boost::asio::ip::tcp::no_delay(Settings::tcp_no_delay()), ec) ||
+                net::tune_socket(socket, Settings::game_socket_tuning())) {
+                accept_errors.add();
+                error_log.log(spdlog::level::warn, "Error setting socket option");
                 continue;
             }
 
+            accepted.add();
             _waiting_room->add_client_deferred(net::TcpClient::make(std::move(socket)));
         }
     }, boost::asio::detached);
@@ -69,15 +156,29 @@ void Server::start() {
 
         spdlog::info("Server listening admin on port {}", Settings::admin_listen_port());
 
-        while (_is_running) {
+        auto& accepted {metrics::Metrics::counter(
+            "spire_server_accepted_total", "Sockets accepted by a listener", {{"listener", "admin"}})};
+        auto& accept_errors {metrics::Metrics::counter(
+            "spire_server_accept_errors_total", "Failed accepts and socket setups", {{"listener", "admin"}})};
+        LogLimiter error_log {Settings::log_rate_limit()};
+
+        while (_is_running && !_is_draining) {
             auto [ec, socket] = co_await _admin_acceptor.async_accept(boost::asio::as_tuple(boost::asio::use_awaitable));
+            if (ec == boost::asio::error::operation_aborted) continue;
             if (ec) {
-                spdlog::warn("Error accepting admin socket");
+                accept_errors.add();
+                error_log.log(spdlog::level::warn, "Error accepting admin socket: {}", ec.message());
                 continue;
             }
 
             spdlog::debug("Server accepted admin socket from {}", socket.local_endpoint().address().to_string());
 
+            if (net::tune_socket(socket, Settings::admin_socket_tuning())) {
+                accept_errors.add();
+                error_log.log(spdlog::level::warn, "Error setting socket option");
+                continue;
+            }
+
             net::SslSocket ssl_socket {std::move(socket), _ssl_context};
             boost::asio::steady_timer handshake_timer {_io_executor, 5s};
             bool handshake_successful {false};
@@ -107,8 +208,12 @@ void Server::start() {
             };
 
             co_await (handshake() || timeout());
-            if (!handshake_successful) continue;
+            if (!handshake_successful) {
+                accept_errors.add();
+                continue;
+            }
 
+            accepted.add();
             _admin_room->add_client_deferred(net::SslClient::make(std::move(ssl_socket)));
         }
     }, boost::asio::detached);
@@ -117,6 +222,14 @@ void Server::start() {
 void Server::stop() {
     if (!_is_running.exchange(false)) return;
 
+    if (_metrics_exporter) {
+        _metrics_exporter->stop();
+    }
+
+    if (_udp_transport) {
+        _udp_transport->stop();
+    }
+
     if (boost::system::error_code ec; _game_acceptor.close(ec)) {
         spdlog::warn("Error closing game acceptor");
     }
@@ -125,8 +238,142 @@ void Server::stop() {
         spdlog::warn("Error closing admin acceptor");
     }
 
+    // Closed on its strand, as a successor may be connecting concurrently
+    post(_io_strand, [this] {
+        boost::system::error_code ec;
+        _handoff_acceptor.close(ec);
+    });
+
     //TODO: Get future from terminate() and wait
     _waiting_room->terminate();
     _admin_room->terminate();
 }
+
+void Server::warmup() {
+    const auto start {steady_clock::now()};
+
+    net::BufferPool::reserve(Settings::warmup_buffers(), Settings::warmup_buffer_size());
+    _waiting_room->reserve(Settings::warmup_room_clients(), 0);
+    _district.spawn_rooms(Settings::warmup_rooms_per_district(), _io_executor, _room_directory);
+
+    spdlog::info(
+        "Server warmed up in {}ms: {} rooms, {} buffers",
+        duration_cast<milliseconds>(steady_clock::now() - start).count(),
+        _district.size(),
+        net::BufferPool::size());
+}
+
+void Server::drain() {
+    if (!_is_running || _is_draining.exchange(true)) return;
+
+    co_spawn(_io_strand, drain_internal(), boost::asio::detached);
+}
+
+void Server::listen_handoff() {
+    const auto path {Settings::handoff_socket()};
+    if (path.empty()) return;
+
+    // Replaces the socket of a predecessor or a stale one
+    std::error_code remove_ec;
+    std::filesystem::remove(path, remove_ec);
+
+    boost::system::error_code ec;
+    const boost::asio::local::stream_protocol::endpoint endpoint {path.string()};
+    if (_handoff_acceptor.open(endpoint.protocol(), ec) || _handoff_acceptor.bind(endpoint, ec)) {
+        spdlog::warn("Server could not listen for successors at {}: {}", path.string(), ec.message());
+        return;
+    }
+
+    // Nothing connects before `listen()`, so no other user gets to connect before the mode is restricted
+    std::error_code permissions_ec;
+    std::filesystem::permissions(
+        path, std::filesystem::perms::owner_read | std::filesystem::perms::owner_write, permissions_ec);
+    if (permissions_ec || _handoff_acceptor.listen(1, ec)) {
+        spdlog::warn("Server could not listen for successors at {}", path.string());
+        _handoff_acceptor.close(ec);
+        return;
+    }
+
+    co_spawn(_io_strand, [this] -> boost::asio::awaitable<void> {
+        while (true) {
+            auto [ec, socket] = co_await _handoff_acceptor.async_accept(
+                boost::asio::as_tuple(boost::asio::use_awaitable));
+            if (ec) co_return;
+
+            if (!Handoff::is_trusted_peer(socket)) {
+                spdlog::warn("Server refused a successor of another user");
+                continue;
+            }
+
+            spdlog::info("Server draining for a successor");
+            _successor.emplace(std::move(socket));
+            drain();
+            co_return;
+        }
+    }, boost::asio::detached);
+}
+
+boost::asio::awaitable<void> Server::drain_internal() {
+    spdlog::info("Server draining");
+
+    // Listeners stay open so that connections wait in their backlog for the successor instead of being refused
+    post(_game_acceptor.get_executor(), [this] {
+        boost::system::error_code ec;
+        _game_acceptor.cancel(ec);
+    });
+    post(_admin_acceptor.get_executor(), [this] {
+        boost::system::error_code ec;
+        _admin_acceptor.cancel(ec);
+    });
+
+    for (const auto& room : _room_directory.rooms())
+        room->drain_deferred();
+
+    // Drained clients park their sessions on their connection strands shortly after leaving,
+    // hence the one extra interval after the rooms emptied
+    boost::asio::steady_timer timer {_io_strand};
+    const auto deadline {steady_clock::now() + Settings::drain_timeout()};
+    bool is_empty {false};
+    while (steady_clock::now() < deadline) {
+        timer.expires_after(100ms);
+        co_await timer.async_wait(boost::asio::as_tuple(boost::asio::use_awaitable));
+
+        if (is_empty) break;
+        is_empty = !has_clients();
+    }
+
+    if (!is_empty) {
+        spdlog::warn("Server drain timed out with clients left");
+    }
+
+    if (_successor) {
+        const HandoffState state {
+            .game_fd = _game_acceptor.native_handle(),
+            .admin_fd = _admin_acceptor.native_handle(),
+            .udp_fd = _udp_transport ? _udp_transport->native_handle() : -1,
+            .sessions = _session_table.serialize(),
+        };
+
+        if (Handoff::hand_over(*_successor, state)) {
+            spdlog::info("Server handed over to its successor");
+        }
+        else {
+            spdlog::warn("Server could not hand over to its successor");
+        }
+        _successor.reset();
+    }
+
+    stop();
+
+    if (_on_drained) {
+        _on_drained();
+    }
+}
+
+bool Server::has_clients() {
+    return std::ranges::any_of(_room_directory.rooms(), [](const auto& room) {
+        const auto snapshot {room->snapshot()};
+        return snapshot && !snapshot->clients.empty();
+    });
+}
 }
@@ -1,19 +1,37 @@
 #pragma once
 
 #include <spire/server/district.hpp>
+#include <spire/server/handoff.hpp>
+#include <spire/server/metrics_exporter.hpp>
+#include <spire/server/session_table.hpp>
 #include <taskflow/taskflow.hpp>
 
 namespace spire {
 class Server final : boost::noncopyable {
 public:
+    // Takes over the listeners and sessions of a running server if one listens at `Settings::handoff_socket()`
     explicit Server(boost::asio::any_io_executor&& io_executor);
     ~Server();
 
-    void start();
+    // `on_drained` is called on an I/O thread once a drain completed, which a successor may initiate as well
+    void start(std::function<void()>&& on_drained);
     void stop();
+    // Stops accepting and asks every client to reconnect, then stops once they left or `Settings::drain_timeout()`
+    // passed. Listeners and parked sessions are handed to a successor if one is waiting.
+    void drain();
 
 private:
+    Server(boost::asio::any_io_executor&& io_executor, const std::optional<HandoffState>& inherited);
+
+    // Preallocates what the first clients would otherwise pay for, see `Settings::warmup_*`
+    void warmup();
+    void listen_handoff();
+    boost::asio::awaitable<void> drain_internal();
+    bool has_clients();
+
     std::atomic<bool> _is_running {false};
+    std::atomic<bool> _is_draining {false};
+    std::function<void()> _on_drained {};
 
     boost::asio::any_io_executor _io_executor;
     boost::asio::strand<boost::asio::any_io_executor> _io_strand;
@@ -22,8 +40,19 @@ private:
 
     boost::asio::ip::tcp::acceptor _game_acceptor;
     boost::asio::ip::tcp::acceptor _admin_acceptor;
+    boost::asio::local::stream_protocol::acceptor _handoff_acceptor;
+    // Only accessed on `_io_strand`
+    std::optional<boost::asio::local::stream_protocol::socket> _successor {};
+
+    RoomDirectory _room_directory {};
+    // Declared before the rooms which refer to them, `_udp_transport` is null if disabled
+    std::unique_ptr<net::UdpTransport> _udp_transport;
+    SessionTable _session_table {};
 
     std::shared_ptr<TcpRoom> _waiting_room;
     std::shared_ptr<SslRoom> _admin_room;
+    TcpDistrict _district {"world"};
+
+    std::unique_ptr<MetricsExporter> _metrics_exporter {};
 };
 }
\ No newline at end of file
@@ -0,0 +1,251 @@
+#include <openssl/rand.h>
+#include <spire/core/clock.hpp>
+#include <spire/core/settings.hpp>
+#include <spire/server/session_table.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <format>
+#include <stdexcept>
+
+namespace spire {
+template <typename T>
+static void write(std::vector<std::byte>& target, const T value) {
+    const auto offset {target.size()};
+    target.resize(offset + sizeof(T));
+    std::memcpy(target.data() + offset, &value, sizeof(T));
+}
+
+static void write_bytes(std::vector<std::byte>& target, const std::span<const std::byte> bytes) {
+    write(target, static_cast<u32>(bytes.size()));
+    target.insert(target.end(), bytes.begin(), bytes.end());
+}
+
+template <typename T>
+static bool read(std::span<const std::byte>& source, T& value) {
+    if (source.size() < sizeof(T)) return false;
+
+    std::memcpy(&value, source.data(), sizeof(T));
+    source = source.subspan(sizeof(T));
+    return true;
+}
+
+static bool read_bytes(std::span<const std::byte>& source, std::span<const std::byte>& bytes) {
+    u32 size;
+    if (!read(source, size) || source.size() < size) return false;
+
+    bytes = source.first(size);
+    source = source.subspan(size);
+    return true;
+}
+
+SessionTable::SessionTable()
+    : _parked_sessions {metrics::Metrics::gauge("spire_sessions_parked", "Sessions waiting to be resumed")},
+    _resumed_sessions {metrics::Metrics::counter("spire_session_resumes_total", "Sessions resumed by reconnects")},
+    _rejected_resumes {metrics::Metrics::counter(
+        "spire_session_rejected_resumes_total", "Resume attempts with unknown, expired or active sessions")},
+    _expired_sessions {metrics::Metrics::counter(
+        "spire_session_expired_total", "Parked sessions dropped at the end of their grace period")} {}
+
+std::string SessionTable::open(const u64 client_id, const SessionIdentity identity) {
+    auto token {make_token()};
+
+    std::lock_guard lock {_mutex};
+    expire(Clock::now());
+
+    // A client logging in twice keeps only its latest session
+    if (const auto it {_tokens.find(client_id)}; it != _tokens.end()) {
+        _sessions.erase(it->second);
+    }
+
+    _sessions.emplace(token, Session {.identity = identity, .client_id = client_id});
+    _tokens[client_id] = token;
+
+    return token;
+}
+
+void SessionTable::park(const u64 client_id, std::vector<std::shared_ptr<net::OutMessage>>&& unsent) {
+    std::lock_guard lock {_mutex};
+
+    const auto now {Clock::now()};
+    expire(now);
+
+    const auto token_it {_tokens.find(client_id)};
+    if (token_it == _tokens.end()) return;
+    auto token {std::move(token_it->second)};
+    _tokens.erase(token_it);
+
+    const auto session_it {_sessions.find(token)};
+    if (session_it == _sessions.end()) return;
+
+    if (Settings::session_resume_grace() == 0ms) {
+        _sessions.erase(session_it);
+        return;
+    }
+
+    auto& session {session_it->second};
+    session.unsent = std::move(unsent);
+    session.expires_at = now + Settings::session_resume_grace();
+
+    _expiries.emplace_back(*session.expires_at, std::move(token));
+    _parked_sessions.add(1);
+}
+
+void SessionTable::close(const u64 client_id) {
+    std::lock_guard lock {_mutex};
+
+    const auto it {_tokens.find(client_id)};
+    if (it == _tokens.end()) return;
+
+    _sessions.erase(it->second);
+    _tokens.erase(it);
+}
+
+std::optional<ResumedSession> SessionTable::resume(const std::string_view token, const u64 client_id) {
+    auto new_token {make_token()};
+
+    std::lock_guard lock {_mutex};
+
+    const auto now {Clock::now()};
+    expire(now);
+
+    // Sessions handed over by a predecessor may expire out of order
+    const auto it {_sessions.find(std::string {token})};
+    if (it == _sessions.end() || !it->second.expires_at || *it->second.expires_at <= now) {
+        _rejected_resumes.add();
+        return std::nullopt;
+    }
+
+    auto session {std::move(it->second)};
+    _sessions.erase(it);
+    _parked_sessions.sub(1);
+    _resumed_sessions.add();
+
+    // A client holds one session at a time, like in `open`
+    if (const auto active {_tokens.find(client_id)}; active != _tokens.end()) {
+        _sessions.erase(active->second);
+    }
+
+    // The stale entry in `_expiries` no longer matches a session and is skipped once it expires
+    _sessions.emplace(new_token, Session {.identity = session.identity, .client_id = client_id});
+    _tokens[client_id] = new_token;
+
+    return ResumedSession {
+        .identity = session.identity,
+        .unsent = std::move(session.unsent),
+        .token = std::move(new_token),
+    };
+}
+
+// Native byte order, predecessor and successor run the same build on the same host
+std::vector<std::byte> SessionTable::serialize() {
+    std::lock_guard lock {_mutex};
+
+    const auto now {Clock::now()};
+    expire(now);
+
+    std::vector<std::byte> data;
+    write(data, static_cast<u32>(std::ranges::count_if(_sessions, [](const auto& entry) {
+        return entry.second.expires_at.has_value();
+    })));
+
+    for (const auto& [token, session] : _sessions) {
+        if (!session.expires_at) continue;
+
+        write_bytes(data, std::as_bytes(std::span {token}));
+        write(data, session.identity.account_id);
+        write(data, session.identity.character_id);
+        write(data, static_cast<u32>(duration_cast<milliseconds>(*session.expires_at - now).count()));
+
+        write(data, static_cast<u32>(session.unsent.size()));
+        for (const auto& message : session.unsent) {
+            write_bytes(data, message->span());
+        }
+    }
+
+    return data;
+}
+
+bool SessionTable::deserialize(std::span<const std::byte> data) {
+    struct Entry {
+        std::string token;
+        Session session;
+    };
+
+    const auto now {Clock::now()};
+    std::vector<Entry> entries;
+
+    u32 count;
+    if (!read(data, count)) return false;
+    for (u32 i {0}; i < count; ++i) {
+        Entry entry {};
+        std::span<const std::byte> token;
+        u32 remaining;
+        u32 unsent_count;
+        if (!read_bytes(data, token) ||
+            !read(data, entry.session.identity.account_id) ||
+            !read(data, entry.session.identity.character_id) ||
+            !read(data, remaining) ||
+            !read(data, unsent_count)) {
+            return false;
+        }
+
+        entry.token.assign(reinterpret_cast<const char*>(token.data()), token.size());
+        entry.session.expires_at = now + milliseconds {remaining};
+
+        for (u32 j {0}; j < unsent_count; ++j) {
+            std::span<const std::byte> frames;
+            if (!read_bytes(data, frames)) return false;
+
+            entry.session.unsent.push_back(
+                std::make_shared<net::OutMessage>(std::vector<std::byte> {frames.begin(), frames.end()}));
+        }
+
+        entries.push_back(std::move(entry));
+    }
+
+    if (!data.empty()) return false;
+
+    std::ranges::sort(entries, {}, [](const Entry& entry) { return *entry.session.expires_at; });
+
+    std::lock_guard lock {_mutex};
+    for (auto& [token, session] : entries) {
+        const auto expires_at {*session.expires_at};
+        if (!_sessions.emplace(token, std::move(session)).second) continue;
+
+        _expiries.emplace_back(expires_at, std::move(token));
+        _parked_sessions.add(1);
+    }
+
+    return true;
+}
+
+std::string SessionTable::make_token() {
+    std::array<unsigned char, 16> bytes {};
+    if (RAND_bytes(bytes.data(), static_cast<int>(bytes.size())) != 1)
+        throw std::runtime_error("Failed to generate session token");
+
+    std::string token;
+    token.reserve(bytes.size() * 2);
+    for (const auto byte : bytes) {
+        std::format_to(std::back_inserter(token), "{:02x}", byte);
+    }
+
+    return token;
+}
+
+void SessionTable::expire(const time_point<steady_clock> now) {
+    while (!_expiries.empty() && _expiries.front().first <= now) {
+        const auto& [expires_at, token] {_expiries.front()};
+
+        if (const auto it {_sessions.find(token)}; it != _sessions.end() && it->second.expires_at == expires_at) {
+            _sessions.erase(it);
+            _parked_sessions.sub(1);
+            _expired_sessions.add();
+        }
+
+        _expiries.pop_front();
+    }
+}
+}
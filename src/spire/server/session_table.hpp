@@ -0,0 +1,76 @@
+#pragma once
+
+#include <boost/core/noncopyable.hpp>
+#include <spire/core/metrics.hpp>
+#include <spire/net/message.hpp>
+
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <unordered_map>
+
+namespace spire {
+// Who an authenticated client plays as, carried over when it resumes
+struct SessionIdentity {
+    u64 account_id;
+    u64 character_id;
+};
+
+struct ResumedSession {
+    SessionIdentity identity;
+    // Messages that were never written to the dropped connection
+    std::vector<std::shared_ptr<net::OutMessage>> unsent;
+    // Replaces the consumed token
+    std::string token;
+};
+
+// Sessions of authenticated clients, keyed by single-use resume tokens. When a connection drops the session
+// is parked for `Settings::session_resume_grace()`, so that a reconnecting client can reattach to it with
+// its token instead of logging in again. Safe to use from any thread.
+class SessionTable final : boost::noncopyable {
+public:
+    SessionTable();
+    ~SessionTable() = default;
+
+    // Returns the resume token of the session opened for `client_id`
+    std::string open(u64 client_id, SessionIdentity identity);
+    // Keeps the session of `client_id` until its grace period ends
+    void park(u64 client_id, std::vector<std::shared_ptr<net::OutMessage>>&& unsent);
+    // Forgets the session of `client_id`, for clients that left on purpose
+    void close(u64 client_id);
+    // Reattaches a parked session to `client_id`, replacing the session `client_id` had, empty if `token` is
+    // unknown, expired or its session still active
+    std::optional<ResumedSession> resume(std::string_view token, u64 client_id);
+
+    // Parked sessions with their remaining grace periods, for handing over to a successor on the same host
+    std::vector<std::byte> serialize();
+    // Parks the sessions serialized by a predecessor, false if `data` is malformed
+    bool deserialize(std::span<const std::byte> data);
+
+private:
+    struct Session {
+        SessionIdentity identity;
+        u64 client_id;
+        std::vector<std::shared_ptr<net::OutMessage>> unsent {};
+        // Set while parked
+        std::optional<time_point<steady_clock>> expires_at {};
+    };
+
+    static std::string make_token();
+    // Drops parked sessions past their grace period
+    void expire(time_point<steady_clock> now);
+
+    std::mutex _mutex {};
+    std::unordered_map<std::string, Session> _sessions {};
+    // Token of the active session of each client
+    std::unordered_map<u64, std::string> _tokens {};
+    // Parked tokens in order of expiry, as every session gets the same grace period
+    std::deque<std::pair<time_point<steady_clock>, std::string>> _expiries {};
+
+    metrics::Gauge& _parked_sessions;
+    metrics::Counter& _resumed_sessions;
+    metrics::Counter& _rejected_resumes;
+    metrics::Counter& _expired_sessions;
+};
+}
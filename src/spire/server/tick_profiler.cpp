@@ -0,0 +1,193 @@
+#include <spdlog/spdlog.h>
+#include <spire/core/log.hpp>
+#include <spire/core/settings.hpp>
+#include <spire/server/tick_profiler.hpp>
+
+#include <format>
+
+namespace spire {
+static std::string message_name(const msg::BaseMessage::MessageCase message_case) {
+    const auto* field {msg::BaseMessage::descriptor()->FindFieldByNumber(message_case)};
+    return field ? std::string {field->name()} : "invalid";
+}
+
+static f64 to_milliseconds(const nanoseconds value) {
+    return duration_cast<duration<f64, std::milli>>(value).count();
+}
+
+static f64 to_trace_microseconds(const steady_clock::time_point time) {
+    return duration_cast<duration<f64, std::micro>>(time.time_since_epoch()).count();
+}
+
+nanoseconds TickProfiler::TickRecord::phase(const Phase phase) const {
+    const auto index {std::to_underlying(phase)};
+    const auto phase_start {index == 0 ? start : phase_ends[index - 1]};
+
+    return phase_ends[index] - phase_start;
+}
+
+TickProfiler::TickProfiler(const u32 room_id, const std::string_view room_name)
+    : _room_id {room_id},
+    _room_name {room_name},
+    _is_enabled {Settings::tick_profiler_enabled()},
+    _records(Settings::tick_profiler_capacity()) {}
+
+void TickProfiler::begin_tick(const steady_clock::time_point now) {
+    ++_tick;
+
+    _is_recording = _is_enabled && !_records.empty();
+    if (!_is_recording) return;
+
+    _current = TickRecord {.tick = _tick, .start = now};
+    _current.phase_ends.fill(now);
+}
+
+void TickProfiler::end_phase(const Phase phase, const steady_clock::time_point now) {
+    if (!_is_recording) return;
+
+    // Phases skipped by an early exit collapse to zero length
+    for (auto i {std::to_underlying(phase)}; i < std::to_underlying(Phase::Count); ++i)
+        _current.phase_ends[i] = now;
+}
+
+void TickProfiler::record_handler(const msg::BaseMessage::MessageCase message_case, const nanoseconds duration) {
+    if (!_is_recording) return;
+
+    auto& handlers {_current.handlers};
+    auto* const last {handlers.data() + _current.handler_count};
+    auto* timing {std::ranges::find(handlers.data(), last, message_case, &HandlerTiming::message_case)};
+
+    if (timing == last) {
+        if (_current.handler_count < MAX_HANDLER_TIMINGS) {
+            ++_current.handler_count;
+            timing->message_case = message_case;
+        } else {
+            timing = &_current.other_handlers;
+        }
+    }
+
+    ++timing->count;
+    timing->duration += duration;
+}
+
+void TickProfiler::end_tick(const steady_clock::time_point now, const u32 messages, const u32 tasks) {
+    if (!_is_recording) return;
+    _is_recording = false;
+
+    _current.end = now;
+    _current.messages = messages;
+    _current.tasks = tasks;
+
+    {
+        std::lock_guard lock {_mutex};
+
+        _records[_next_record] = _current;
+        _next_record = (_next_record + 1) % _records.size();
+        _record_count = std::min(_record_count + 1, _records.size());
+    }
+
+    if (_current.total() >= Settings::slow_tick_threshold()) {
+        report_slow_tick(_current);
+    }
+}
+
+std::vector<TickProfiler::TickRecord> TickProfiler::records(const size_t max_count) const {
+    std::lock_guard lock {_mutex};
+
+    const size_t count {std::min(_record_count, max_count)};
+    std::vector<TickRecord> records;
+    records.reserve(count);
+
+    const size_t first {_next_record + _records.size() - count};
+    for (size_t i {0}; i < count; ++i)
+        records.push_back(_records[(first + i) % _records.size()]);
+
+    return records;
+}
+
+std::string TickProfiler::trace_json(const size_t max_ticks) const {
+    static constexpr std::array phase_names {"messages"sv, "tasks"sv, "systems"sv};
+
+    const auto records {this->records(max_ticks)};
+
+    std::string json;
+    json.reserve(256 + records.size() * 512);
+
+    json += std::format(
+        R"({{"displayTimeUnit":"ms","traceEvents":[)"
+        R"({{"name":"thread_name","ph":"M","pid":0,"tid":{},"args":{{"name":"{} {}"}}}})",
+        _room_id, _room_name, _room_id);
+
+    for (const auto& record : records) {
+        json += std::format(
+            R"(,{{"name":"tick","cat":"room","ph":"X","pid":0,"tid":{},"ts":{:.3f},"dur":{:.3f},)"
+            R"("args":{{"tick":{},"messages":{},"tasks":{}}}}})",
+            _room_id,
+            to_trace_microseconds(record.start),
+            to_trace_microseconds(record.end) - to_trace_microseconds(record.start),
+            record.tick, record.messages, record.tasks);
+
+        auto phase_start {record.start};
+        for (size_t i {0}; i < phase_names.size(); ++i) {
+            const auto phase_end {record.phase_ends[i]};
+
+            json += std::format(
+                R"(,{{"name":"{}","cat":"room","ph":"X","pid":0,"tid":{},"ts":{:.3f},"dur":{:.3f},"args":{{)",
+                phase_names[i],
+                _room_id,
+                to_trace_microseconds(phase_start),
+                to_trace_microseconds(phase_end) - to_trace_microseconds(phase_start));
+
+            if (static_cast<Phase>(i) == Phase::Messages) {
+                for (u8 j {0}; j < record.handler_count; ++j) {
+                    const auto& handler {record.handlers[j]};
+                    json += std::format(R"({}"{}":{{"count":{},"ms":{:.3f}}})",
+                        j == 0 ? "" : ",",
+                        message_name(handler.message_case),
+                        handler.count,
+                        to_milliseconds(handler.duration));
+                }
+                if (record.other_handlers.count > 0) {
+                    json += std::format(R"({}"other":{{"count":{},"ms":{:.3f}}})",
+                        record.handler_count == 0 ? "" : ",",
+                        record.other_handlers.count,
+                        to_milliseconds(record.other_handlers.duration));
+                }
+            }
+            json += "}}";
+
+            phase_start = phase_end;
+        }
+    }
+
+    json += "]}";
+    return json;
+}
+
+void TickProfiler::report_slow_tick(const TickRecord& record) const {
+    // Shared by every room, an overloaded server would otherwise log a warning per room per tick
+    static LogLimiter slow_tick_log {Settings::log_rate_limit()};
+
+    std::string handlers;
+    for (u8 i {0}; i < record.handler_count; ++i) {
+        const auto& handler {record.handlers[i]};
+        handlers += std::format("{}{} x{} {:.3f}ms",
+            i == 0 ? "" : ", ",
+            message_name(handler.message_case),
+            handler.count,
+            to_milliseconds(handler.duration));
+    }
+    if (record.other_handlers.count > 0) {
+        handlers += std::format(", other x{} {:.3f}ms",
+            record.other_handlers.count,
+            to_milliseconds(record.other_handlers.duration));
+    }
+
+    slow_tick_log.log(spdlog::level::warn,
+        "Room({} {}) tick {} took {:.3f}ms: messages {:.3f}ms ({}) [{}], tasks {:.3f}ms ({}), systems {:.3f}ms",
+        _room_name, _room_id, record.tick, to_milliseconds(record.total()),
+        to_milliseconds(record.phase(Phase::Messages)), record.messages, handlers,
+        to_milliseconds(record.phase(Phase::Tasks)), record.tasks,
+        to_milliseconds(record.phase(Phase::Systems)));
+}
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <boost/core/noncopyable.hpp>
+#include <spire/core/types.hpp>
+#include <spire/msg/base_message.pb.h>
+
+#include <array>
+#include <limits>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace spire {
+// Records per-phase timings of room updates into a fixed ring buffer.
+// Recording is done by the room update only; snapshots may be taken from any thread.
+class TickProfiler final : boost::noncopyable {
+public:
+    enum class Phase : u8 {
+        Messages,
+        Tasks,
+        Systems,
+        Count
+    };
+
+    static constexpr size_t MAX_HANDLER_TIMINGS {8};
+
+    struct HandlerTiming {
+        msg::BaseMessage::MessageCase message_case {msg::BaseMessage::MESSAGE_NOT_SET};
+        u32 count {0};
+        nanoseconds duration {};
+    };
+
+    struct TickRecord {
+        u64 tick {0};
+        steady_clock::time_point start {};
+        steady_clock::time_point end {};
+        // End of each phase, phases run back to back from `start`
+        std::array<steady_clock::time_point, std::to_underlying(Phase::Count)> phase_ends {};
+
+        u32 messages {0};
+        u32 tasks {0};
+        // Per message case, in the order first handled during the tick
+        std::array<HandlerTiming, MAX_HANDLER_TIMINGS> handlers {};
+        u8 handler_count {0};
+        // Summed over the message cases that did not fit into `handlers`, reported as "other"
+        HandlerTiming other_handlers {};
+
+        nanoseconds total() const { return end - start; }
+        nanoseconds phase(Phase phase) const;
+    };
+
+    TickProfiler(u32 room_id, std::string_view room_name);
+
+    void begin_tick(steady_clock::time_point now);
+    void end_phase(Phase phase, steady_clock::time_point now);
+    void record_handler(msg::BaseMessage::MessageCase message_case, nanoseconds duration);
+    void end_tick(steady_clock::time_point now, u32 messages, u32 tasks);
+
+    bool is_enabled() const { return _is_enabled; }
+    void set_enabled(bool enabled) { _is_enabled = enabled; }
+
+    // Copy of the latest `max_count` recorded ticks, oldest first
+    std::vector<TickRecord> records(size_t max_count = std::numeric_limits<size_t>::max()) const;
+    // Chrome trace event JSON of the recorded ticks, loadable in Perfetto or chrome://tracing
+    std::string trace_json(size_t max_ticks = std::numeric_limits<size_t>::max()) const;
+
+private:
+    void report_slow_tick(const TickRecord& record) const;
+
+    const u32 _room_id;
+    const std::string _room_name;
+    std::atomic<bool> _is_enabled;
+
+    TickRecord _current {};
+    bool _is_recording {false};
+    u64 _tick {0};
+
+    mutable std::mutex _mutex {};
+    std::vector<TickRecord> _records;
+    size_t _next_record {0};
+    size_t _record_count {0};
+};
+}
@@ -0,0 +1,193 @@
+#include <glm/common.hpp>
+#include <spire/system/broadphase.hpp>
+
+#include <algorithm>
+
+namespace spire::physics {
+void StaticBvh::build(std::vector<Item>&& items) {
+    _items = std::move(items);
+    _nodes.clear();
+    if (_items.empty()) return;
+
+    // A binary tree over leaves of up to `LEAF_SIZE` items has fewer than twice as many nodes as items
+    _nodes.reserve(2 * _items.size());
+    _nodes.emplace_back();
+    build_node(0, 0, static_cast<u32>(_items.size()));
+}
+
+void StaticBvh::build_node(const u32 node_index, const u32 first, const u32 count) {
+    Aabb bounds {_items[first].bounds};
+    glm::vec3 centers_min {(bounds.min + bounds.max) * 0.5f};
+    glm::vec3 centers_max {centers_min};
+    for (u32 i {first + 1}; i < first + count; ++i) {
+        const auto& item_bounds {_items[i].bounds};
+        bounds.min = glm::min(bounds.min, item_bounds.min);
+        bounds.max = glm::max(bounds.max, item_bounds.max);
+
+        const glm::vec3 center {(item_bounds.min + item_bounds.max) * 0.5f};
+        centers_min = glm::min(centers_min, center);
+        centers_max = glm::max(centers_max, center);
+    }
+    _nodes[node_index].bounds = bounds;
+
+    if (count <= LEAF_SIZE) {
+        _nodes[node_index].first = first;
+        _nodes[node_index].count = count;
+        return;
+    }
+
+    // Median split along the axis the centers spread most on
+    const glm::vec3 spread {centers_max - centers_min};
+    const glm::length_t axis {spread.x > spread.y ? (spread.x > spread.z ? 0 : 2) : (spread.y > spread.z ? 1 : 2)};
+    const u32 half {count / 2};
+    std::nth_element(
+        _items.begin() + first,
+        _items.begin() + first + half,
+        _items.begin() + first + count,
+        [axis](const Item& lhs, const Item& rhs) {
+            return lhs.bounds.min[axis] + lhs.bounds.max[axis] < rhs.bounds.min[axis] + rhs.bounds.max[axis];
+        });
+
+    const auto children {static_cast<u32>(_nodes.size())};
+    _nodes[node_index].first = children;
+    _nodes[node_index].count = 0;
+    _nodes.emplace_back();
+    _nodes.emplace_back();
+
+    build_node(children, first, half);
+    build_node(children + 1, first + half, count - half);
+}
+
+u32 SweepAndPrune::add(const Body& body) {
+    const Aabb tracked_bounds {body.bounds.enlarged(MARGIN)};
+    _max_width = std::max(_max_width, tracked_bounds.max.x - tracked_bounds.min.x);
+
+    u32 index;
+    if (_free.empty()) {
+        index = static_cast<u32>(_bodies.size());
+        _bodies.push_back(body);
+        _proxies.push_back(Proxy {.tracked_bounds = tracked_bounds, .position = UNSORTED, .marked_at = 0});
+    }
+    else {
+        index = _free.back();
+        _free.pop_back();
+        _bodies[index] = body;
+        _proxies[index] = Proxy {.tracked_bounds = tracked_bounds, .position = UNSORTED, .marked_at = 0};
+    }
+
+    _added.push_back(Entry {.bounds = tracked_bounds, .index = index});
+    mark(index);
+    return index;
+}
+
+void SweepAndPrune::update(const u32 index, const Aabb& bounds, const bool is_dynamic) {
+    auto& body {_bodies[index]};
+    auto& proxy {_proxies[index]};
+    body.bounds = bounds;
+
+    // Pairs of two bodies that are not dynamic are left out, so they have to be searched again as well
+    if (proxy.tracked_bounds.contains(bounds) && body.is_dynamic == is_dynamic) return;
+
+    body.is_dynamic = is_dynamic;
+    proxy.tracked_bounds = bounds.enlarged(MARGIN);
+    _max_width = std::max(_max_width, proxy.tracked_bounds.max.x - proxy.tracked_bounds.min.x);
+    mark(index);
+}
+
+void SweepAndPrune::remove(const u32 index) {
+    _bodies[index].entity = entt::null;
+    mark(index);
+}
+
+void SweepAndPrune::mark(const u32 index) {
+    auto& proxy {_proxies[index]};
+    if (proxy.marked_at == _sweep_count + 1) return;
+
+    proxy.marked_at = _sweep_count + 1;
+    _marked.push_back(index);
+}
+
+void SweepAndPrune::refresh_pairs() {
+    std::erase_if(_pairs, [this](const std::pair<u32, u32>& pair) {
+        return was_moved(pair.first) || was_moved(pair.second);
+    });
+
+    bool has_removed {false};
+    for (const auto index : _moved) {
+        const auto position {_proxies[index].position};
+        const bool is_removed {_bodies[index].entity == entt::null};
+        has_removed |= is_removed;
+        if (position == UNSORTED) continue;
+
+        if (is_removed) {
+            _sorted[position].index = UNSORTED;
+        }
+        else {
+            _sorted[position].bounds = _proxies[index].tracked_bounds;
+        }
+    }
+
+    if (has_removed) {
+        std::erase_if(_sorted, [](const Entry& entry) { return entry.index == UNSORTED; });
+    }
+
+    // Insertion sort, bodies barely move between ticks
+    for (size_t i {1}; i < _sorted.size(); ++i) {
+        if (!is_before(_sorted[i], _sorted[i - 1])) continue;
+
+        const auto entry {_sorted[i]};
+        size_t j {i};
+        for (; j > 0 && is_before(entry, _sorted[j - 1]); --j)
+            _sorted[j] = _sorted[j - 1];
+        _sorted[j] = entry;
+    }
+
+    // New bodies could be anywhere, which would make the insertion sort quadratic
+    if (!_added.empty()) {
+        std::erase_if(_added, [this](const Entry& entry) { return _bodies[entry.index].entity == entt::null; });
+        for (auto& entry : _added)
+            entry.bounds = _proxies[entry.index].tracked_bounds;
+
+        std::ranges::sort(_added, is_before);
+        const auto middle {static_cast<std::ptrdiff_t>(_sorted.size())};
+        _sorted.insert(_sorted.end(), _added.begin(), _added.end());
+        std::inplace_merge(_sorted.begin(), _sorted.begin() + middle, _sorted.end(), is_before);
+        _added.clear();
+    }
+
+    for (size_t position {0}; position < _sorted.size(); ++position)
+        _proxies[_sorted[position].index].position = static_cast<u32>(position);
+
+    for (const auto index : _moved) {
+        if (_bodies[index].entity == entt::null) {
+            _proxies[index].position = UNSORTED;
+            _free.push_back(index);
+            continue;
+        }
+
+        const auto position {_proxies[index].position};
+        const auto& bounds {_sorted[position].bounds};
+
+        // Later bodies starting within these bounds
+        for (size_t j {position + 1}; j < _sorted.size() && _sorted[j].bounds.min.x <= bounds.max.x; ++j) {
+            if (overlaps_yz(_sorted[j].bounds, bounds)) {
+                add_pair(index, _sorted[j].index);
+            }
+        }
+
+        // Earlier bodies reaching into these bounds, unless moved themselves, which found this one above
+        for (size_t j {position}; j > 0 && _sorted[j - 1].bounds.min.x >= bounds.min.x - _max_width; --j) {
+            const auto& other {_sorted[j - 1]};
+            if (other.bounds.max.x >= bounds.min.x && !was_moved(other.index) && overlaps_yz(other.bounds, bounds)) {
+                add_pair(other.index, index);
+            }
+        }
+    }
+}
+
+void SweepAndPrune::add_pair(const u32 first, const u32 second) {
+    if (!_bodies[first].is_dynamic && !_bodies[second].is_dynamic) return;
+
+    _pairs.emplace_back(first, second);
+}
+}
@@ -0,0 +1,173 @@
+#pragma once
+
+#include <entt/entt.hpp>
+#include <spire/system/narrowphase.hpp>
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace spire::physics {
+// Bounding volume hierarchy over bodies that never move, built once and only queried afterwards
+class StaticBvh final {
+public:
+    struct Item {
+        Aabb bounds;
+        entt::entity entity;
+    };
+
+    void build(std::vector<Item>&& items);
+    // Calls `on_overlap` with every item whose bounds overlap `bounds`
+    template <typename Callback>
+    void query(const Aabb& bounds, Callback&& on_overlap) const;
+
+    size_t size() const { return _items.size(); }
+
+private:
+    static constexpr u32 LEAF_SIZE {4};
+    // Median splits keep the depth at log2 of the item count
+    static constexpr size_t MAX_DEPTH {64};
+
+    struct Node {
+        Aabb bounds;
+        // Leaves hold `count` items from `first`, inner nodes have their children at `first` and `first + 1`
+        u32 first;
+        u32 count;
+    };
+
+    void build_node(u32 node_index, u32 first, u32 count);
+
+    std::vector<Node> _nodes {};
+    std::vector<Item> _items {};
+};
+
+
+// Overlapping pairs of moving bodies, kept between sweeps. Pairs are searched with bounds enlarged by `MARGIN`, and
+// only searched again for the bodies that left their enlarged bounds since, a small share of them per tick. Those
+// bounds stay sorted along x between sweeps, which makes the insertion sort close to linear.
+class SweepAndPrune final {
+public:
+    struct Body {
+        Aabb bounds;
+        entt::entity entity;
+        bool is_dynamic;
+    };
+
+    // On every side, about what a running character covers in 10 ticks. Wider bounds are left less often but pair
+    // with more bodies that are not touching.
+    static constexpr f32 MARGIN {1.0f};
+
+    // Index of `body` until removed, it is merged into the sorted bodies by the next sweep
+    u32 add(const Body& body);
+    void update(u32 index, const Aabb& bounds, bool is_dynamic);
+    // The index is reused after the next sweep
+    void remove(u32 index);
+
+    // By index, removed bodies have a null entity
+    std::span<const Body> bodies() const { return _bodies; }
+    // Enlarged bounds the pairs of a body were searched with, which contain its bounds
+    const Aabb& tracked_bounds(const u32 index) const { return _proxies[index].tracked_bounds; }
+    // Bodies added, moved out of their enlarged bounds or removed before the latest sweep, whose pairs it searched
+    std::span<const u32> moved() const { return _moved; }
+    bool was_moved(const u32 index) const { return _proxies[index].marked_at == _sweep_count; }
+
+    // Calls `on_pair` once with both bodies of every overlapping pair of which at least one is dynamic
+    template <typename Callback>
+    void sweep(Callback&& on_pair);
+
+private:
+    static constexpr u32 UNSORTED {std::numeric_limits<u32>::max()};
+
+    struct Proxy {
+        Aabb tracked_bounds;
+        // In `_sorted`, `UNSORTED` until the first sweep after being added
+        u32 position;
+        // Sweep that searches the pairs of the body next
+        u32 marked_at;
+    };
+
+    // Copies of the enlarged bounds, so that sweeping does not jump between bodies
+    struct Entry {
+        Aabb bounds;
+        u32 index;
+    };
+
+    static bool is_before(const Entry& lhs, const Entry& rhs) { return lhs.bounds.min.x < rhs.bounds.min.x; }
+    // Pairs are searched among bodies already overlapping on x. Whether those overlap on y and z is close to random,
+    // so this takes the largest gap without branching instead of mispredicting a branch per axis.
+    static bool overlaps_yz(const Aabb& lhs, const Aabb& rhs) {
+        return std::max(
+            std::max(lhs.min.y - rhs.max.y, rhs.min.y - lhs.max.y),
+            std::max(lhs.min.z - rhs.max.z, rhs.min.z - lhs.max.z)) <= 0.0f;
+    }
+
+    void mark(u32 index);
+    // Re-sorts the enlarged bounds and replaces the pairs of the bodies in `_moved`
+    void refresh_pairs();
+    void add_pair(u32 first, u32 second);
+
+    std::vector<Body> _bodies {};
+    std::vector<Proxy> _proxies {};
+    std::vector<u32> _free {};
+
+    std::vector<Entry> _sorted {};
+    std::vector<Entry> _added {};
+    // Widest enlarged bounds along x ever tracked, how far back a search has to look
+    f32 _max_width {0.0f};
+
+    std::vector<u32> _marked {};
+    std::vector<u32> _moved {};
+    u32 _sweep_count {0};
+    // Of enlarged bounds, indices of `_bodies`
+    std::vector<std::pair<u32, u32>> _pairs {};
+};
+
+template <typename Callback>
+void StaticBvh::query(const Aabb& bounds, Callback&& on_overlap) const {
+    if (_nodes.empty() || !_nodes[0].bounds.overlaps(bounds)) return;
+
+    // Children are tested before being pushed, so only nodes known to overlap are visited
+    std::array<u32, MAX_DEPTH> stack;
+    size_t stack_size {0};
+    stack[stack_size++] = 0;
+
+    while (stack_size != 0) {
+        const auto& node {_nodes[stack[--stack_size]]};
+
+        if (node.count != 0) {
+            for (u32 i {node.first}; i < node.first + node.count; ++i) {
+                if (_items[i].bounds.overlaps(bounds)) {
+                    on_overlap(_items[i]);
+                }
+            }
+            continue;
+        }
+
+        if (_nodes[node.first].bounds.overlaps(bounds)) {
+            stack[stack_size++] = node.first;
+        }
+        if (_nodes[node.first + 1].bounds.overlaps(bounds)) {
+            stack[stack_size++] = node.first + 1;
+        }
+    }
+}
+
+template <typename Callback>
+void SweepAndPrune::sweep(Callback&& on_pair) {
+    ++_sweep_count;
+    _moved.swap(_marked);
+    _marked.clear();
+    if (!_moved.empty()) {
+        refresh_pairs();
+    }
+
+    for (const auto& [first, second] : _pairs) {
+        if (_bodies[first].bounds.overlaps(_bodies[second].bounds)) {
+            on_pair(_bodies[first], _bodies[second]);
+        }
+    }
+}
+}
@@ -0,0 +1,145 @@
+#include <glm/geometric.hpp>
+#include <spire/system/collision_system.hpp>
+
+namespace spire::physics {
+void CollisionSystem::build_static(const entt::registry& registry) {
+    std::vector<StaticBvh::Item> items;
+    for (const auto [entity, transform, collider] : registry.view<Transform, Collider, StaticPhysics>().each()) {
+        items.push_back(StaticBvh::Item {.bounds = bounds(collider, transform.position), .entity = entity});
+    }
+
+    _static_bvh.build(std::move(items));
+    _is_static_changed = true;
+}
+
+void CollisionSystem::update(entt::registry& registry) {
+    _contacts.clear();
+    refresh_bodies(registry);
+
+    _sweep_and_prune.sweep([&](const SweepAndPrune::Body& first, const SweepAndPrune::Body& second) {
+        const auto penetration {collide(
+            registry.get<Collider>(first.entity),
+            registry.get<Transform>(first.entity).position,
+            registry.get<Collider>(second.entity),
+            registry.get<Transform>(second.entity).position)};
+        if (penetration) {
+            _contacts.push_back(Contact {.first = first.entity, .second = second.entity, .penetration = *penetration});
+        }
+    });
+
+    refresh_static_candidates();
+    const auto bodies {_sweep_and_prune.bodies()};
+    for (const auto& [index, item] : _static_candidates) {
+        const auto& body {bodies[index]};
+        if (!body.bounds.overlaps(item.bounds)) continue;
+
+        const auto penetration {collide(
+            registry.get<Collider>(body.entity),
+            registry.get<Transform>(body.entity).position,
+            registry.get<Collider>(item.entity),
+            registry.get<Transform>(item.entity).position)};
+        if (penetration) {
+            _contacts.push_back(Contact {.first = body.entity, .second = item.entity, .penetration = *penetration});
+        }
+    }
+
+    for (const auto& contact : _contacts)
+        resolve(registry, contact);
+}
+
+void CollisionSystem::refresh_bodies(entt::registry& registry) {
+    // Removing and updating leave the bodies where they are, only adding may move them
+    const auto bodies {_sweep_and_prune.bodies()};
+    for (u32 index {0}; index < bodies.size(); ++index) {
+        const auto entity {bodies[index].entity};
+        if (entity == entt::null) continue;
+
+        if (!registry.valid(entity)) {
+            _sweep_and_prune.remove(index);
+            continue;
+        }
+
+        if (!registry.all_of<Transform, Collider>(entity) || registry.all_of<StaticPhysics>(entity)) {
+            registry.remove<Proxy>(entity);
+            _sweep_and_prune.remove(index);
+            continue;
+        }
+
+        _sweep_and_prune.update(
+            index,
+            bounds(registry.get<Collider>(entity), registry.get<Transform>(entity).position),
+            registry.all_of<DynamicPhysics>(entity));
+    }
+
+    // Collected first, as adding `Proxy` while iterating a view excluding it would skip bodies
+    _added.clear();
+    for (const auto entity : registry.view<Transform, Collider>(entt::exclude<StaticPhysics, Proxy>))
+        _added.push_back(entity);
+
+    for (const auto entity : _added) {
+        registry.emplace<Proxy>(entity);
+        _sweep_and_prune.add(SweepAndPrune::Body {
+            .bounds = bounds(registry.get<Collider>(entity), registry.get<Transform>(entity).position),
+            .entity = entity,
+            .is_dynamic = registry.all_of<DynamicPhysics>(entity)});
+    }
+}
+
+void CollisionSystem::refresh_static_candidates() {
+    if (_is_static_changed) {
+        _static_candidates.clear();
+    }
+    else {
+        std::erase_if(_static_candidates, [this](const StaticCandidate& candidate) {
+            return _sweep_and_prune.was_moved(candidate.body);
+        });
+    }
+
+    const auto search {[this](const u32 index) {
+        const auto& body {_sweep_and_prune.bodies()[index]};
+        if (body.entity == entt::null || !body.is_dynamic) return;
+
+        _static_bvh.query(_sweep_and_prune.tracked_bounds(index), [&](const StaticBvh::Item& item) {
+            _static_candidates.push_back(StaticCandidate {.body = index, .item = item});
+        });
+    }};
+
+    if (_is_static_changed) {
+        for (u32 index {0}; index < _sweep_and_prune.bodies().size(); ++index)
+            search(index);
+        _is_static_changed = false;
+        return;
+    }
+
+    for (const auto index : _sweep_and_prune.moved())
+        search(index);
+}
+
+void CollisionSystem::resolve(entt::registry& registry, const Contact& contact) const {
+    auto* const first {registry.try_get<DynamicPhysics>(contact.first)};
+    auto* const second {registry.try_get<DynamicPhysics>(contact.second)};
+    const auto& [normal, depth] = contact.penetration;
+
+    // Dynamic bodies hitting each other move apart by half the depth each
+    const f32 share {first && second ? 0.5f : 1.0f};
+
+    if (first) {
+        registry.get<Transform>(contact.first).position -= normal * (depth * share);
+
+        // Stop moving into the other body, sliding along it is kept
+        const f32 approach {glm::dot(first->velocity, normal)};
+        if (approach > 0.0f) {
+            first->velocity -= normal * approach;
+        }
+    }
+
+    if (second) {
+        registry.get<Transform>(contact.second).position += normal * (depth * share);
+
+        const f32 approach {glm::dot(second->velocity, -normal)};
+        if (approach > 0.0f) {
+            second->velocity += normal * approach;
+        }
+    }
+}
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <entt/entt.hpp>
+#include <spire/system/broadphase.hpp>
+
+#include <span>
+#include <vector>
+
+namespace spire::physics {
+struct Contact {
+    entt::entity first;
+    entt::entity second;
+    Penetration penetration;
+};
+
+// Collision detection and resolution of the bodies of one room. Bodies need a `Transform` and a `Collider`.
+// Bodies with `StaticPhysics` are indexed once into a BVH, the others are swept and pruned every update.
+// Dynamic bodies are pushed out of whatever they hit, kinematic bodies push but are never pushed.
+// Both searches use the enlarged bounds of `SweepAndPrune`, so that a body only searches again once it left them.
+class CollisionSystem final {
+public:
+    // Indexes every static body, to be called again whenever static bodies are added, moved or removed
+    void build_static(const entt::registry& registry);
+    void update(entt::registry& registry);
+
+    // Contacts found by the latest update, before they were resolved
+    std::span<const Contact> contacts() const { return _contacts; }
+
+private:
+    // Marks bodies known to `_sweep_and_prune`
+    struct Proxy {};
+
+    // Static body overlapping the enlarged bounds of a dynamic body when that last searched the BVH
+    struct StaticCandidate {
+        u32 body;
+        StaticBvh::Item item;
+    };
+
+    void refresh_bodies(entt::registry& registry);
+    // Searches the BVH for the bodies the latest sweep searched pairs for, or for every body if it was rebuilt
+    void refresh_static_candidates();
+    void resolve(entt::registry& registry, const Contact& contact) const;
+
+    StaticBvh _static_bvh {};
+    bool _is_static_changed {false};
+    SweepAndPrune _sweep_and_prune {};
+    std::vector<StaticCandidate> _static_candidates {};
+    std::vector<Contact> _contacts {};
+    std::vector<entt::entity> _added {};
+};
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <entt/entt.hpp>
+#include <spire/component/input_components.hpp>
+#include <spire/component/physics_components.hpp>
+
+
+namespace spire::physics {
+class InputSystem final {
+public:
+    // Applies the commands clients sent since the last update, before the physics step moves their entities
+    static void update(entt::registry& registry);
+};
+
+inline void InputSystem::update(entt::registry& registry) {
+    registry.view<InputBuffer, Transform, DynamicPhysics, Movement>().each(
+        [](auto& input, auto& transform, auto& dynamic, const auto& movement) {
+            input.apply([&](const InputCommand& command) {
+                dynamic.velocity = command.direction * movement.max_speed.value();
+                transform.rotation = command.rotation;
+            });
+        });
+}
+}
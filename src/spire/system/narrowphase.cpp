@@ -0,0 +1,173 @@
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+#include <spire/system/narrowphase.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace spire::physics {
+static constexpr f32 EPSILON {1e-6f};
+
+static std::optional<Penetration> collide_spheres(
+    const glm::vec3& first_center,
+    const meter first_radius,
+    const glm::vec3& second_center,
+    const meter second_radius) {
+    const glm::vec3 delta {second_center - first_center};
+    const f32 distance_squared {glm::dot(delta, delta)};
+    const meter radii {first_radius + second_radius};
+    if (distance_squared >= radii * radii) return std::nullopt;
+
+    // Concentric spheres are separated upwards
+    const meter distance {std::sqrt(distance_squared)};
+    return Penetration {
+        .normal = distance > EPSILON ? delta / distance : glm::vec3 {0.0f, 1.0f, 0.0f},
+        .depth = radii - distance};
+}
+
+static std::optional<Penetration> collide_sphere_box(
+    const glm::vec3& center,
+    const meter radius,
+    const glm::vec3& box_center,
+    const glm::vec3& half_extents) {
+    const glm::vec3 closest {glm::clamp(center, box_center - half_extents, box_center + half_extents)};
+    const glm::vec3 delta {closest - center};
+    const f32 distance_squared {glm::dot(delta, delta)};
+
+    if (distance_squared > EPSILON) {
+        if (distance_squared >= radius * radius) return std::nullopt;
+
+        const meter distance {std::sqrt(distance_squared)};
+        return Penetration {.normal = delta / distance, .depth = radius - distance};
+    }
+
+    // The center is inside the box, the sphere leaves through the nearest face
+    const glm::vec3 local {center - box_center};
+    const glm::vec3 gaps {half_extents - glm::abs(local)};
+    const glm::length_t axis {gaps.x < gaps.y ? (gaps.x < gaps.z ? 0 : 2) : (gaps.y < gaps.z ? 1 : 2)};
+
+    glm::vec3 normal {0.0f};
+    normal[axis] = local[axis] >= 0.0f ? -1.0f : 1.0f;
+    return Penetration {.normal = normal, .depth = gaps[axis] + radius};
+}
+
+static std::optional<Penetration> collide_boxes(
+    const glm::vec3& first_center,
+    const glm::vec3& first_half_extents,
+    const glm::vec3& second_center,
+    const glm::vec3& second_half_extents) {
+    const glm::vec3 delta {second_center - first_center};
+    const glm::vec3 overlaps {first_half_extents + second_half_extents - glm::abs(delta)};
+    if (overlaps.x <= 0.0f || overlaps.y <= 0.0f || overlaps.z <= 0.0f) return std::nullopt;
+
+    // Separated along the axis of least overlap
+    const glm::length_t axis {
+        overlaps.x < overlaps.y ? (overlaps.x < overlaps.z ? 0 : 2) : (overlaps.y < overlaps.z ? 1 : 2)};
+
+    glm::vec3 normal {0.0f};
+    normal[axis] = delta[axis] >= 0.0f ? 1.0f : -1.0f;
+    return Penetration {.normal = normal, .depth = overlaps[axis]};
+}
+
+// Point of the upright segment of a capsule closest to height `y`, which is where a sphere of its radius
+// stands in for the capsule
+static glm::vec3 capsule_point(const Collider& capsule, const glm::vec3& position, const f32 y) {
+    return glm::vec3 {
+        position.x,
+        glm::clamp(y, position.y - capsule.half_height, position.y + capsule.half_height),
+        position.z};
+}
+
+// `first` does not come after `second` in the order of `Collider::Shape`
+static std::optional<Penetration> collide_ordered(
+    const Collider& first,
+    const glm::vec3& first_position,
+    const Collider& second,
+    const glm::vec3& second_position) {
+    using Shape = Collider::Shape;
+
+    switch (first.shape) {
+    case Shape::Sphere:
+        switch (second.shape) {
+        case Shape::Sphere:
+            return collide_spheres(first_position, first.radius, second_position, second.radius);
+        case Shape::Capsule:
+            return collide_spheres(
+                first_position,
+                first.radius,
+                capsule_point(second, second_position, first_position.y),
+                second.radius);
+        case Shape::Box:
+            return collide_sphere_box(first_position, first.radius, second_position, second.half_extents);
+        }
+        break;
+
+    case Shape::Capsule:
+        switch (second.shape) {
+        case Shape::Capsule: {
+            // Parallel segments are closest anywhere in their common height range, or at their nearest ends
+            const f32 low {std::max(first_position.y - first.half_height, second_position.y - second.half_height)};
+            const f32 high {std::min(first_position.y + first.half_height, second_position.y + second.half_height)};
+            const f32 first_y {low <= high ? (low + high) / 2.0f : second_position.y};
+            const auto first_point {capsule_point(first, first_position, first_y)};
+
+            return collide_spheres(
+                first_point,
+                first.radius,
+                capsule_point(second, second_position, first_point.y),
+                second.radius);
+        }
+        case Shape::Box:
+            return collide_sphere_box(
+                capsule_point(first, first_position, second_position.y),
+                first.radius,
+                second_position,
+                second.half_extents);
+        default:
+            break;
+        }
+        break;
+
+    case Shape::Box:
+        if (second.shape == Shape::Box)
+            return collide_boxes(first_position, first.half_extents, second_position, second.half_extents);
+        break;
+    }
+
+    return std::nullopt;
+}
+
+Aabb bounds(const Collider& collider, const glm::vec3& position) {
+    glm::vec3 half_size;
+    switch (collider.shape) {
+    case Collider::Shape::Sphere:
+        half_size = glm::vec3 {collider.radius};
+        break;
+    case Collider::Shape::Capsule:
+        half_size = glm::vec3 {collider.radius, collider.half_height + collider.radius, collider.radius};
+        break;
+    case Collider::Shape::Box:
+        half_size = collider.half_extents;
+        break;
+    }
+
+    return Aabb {.min = position - half_size, .max = position + half_size};
+}
+
+std::optional<Penetration> collide(
+    const Collider& first,
+    const glm::vec3& first_position,
+    const Collider& second,
+    const glm::vec3& second_position) {
+    if (std::to_underlying(first.shape) <= std::to_underlying(second.shape))
+        return collide_ordered(first, first_position, second, second_position);
+
+    auto penetration {collide_ordered(second, second_position, first, first_position)};
+    if (penetration) {
+        penetration->normal = -penetration->normal;
+    }
+
+    return penetration;
+}
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <glm/vec3.hpp>
+#include <spire/component/physics_components.hpp>
+
+#include <optional>
+
+namespace spire::physics {
+struct Aabb {
+    glm::vec3 min;
+    glm::vec3 max;
+
+    bool overlaps(const Aabb& other) const {
+        return min.x <= other.max.x && max.x >= other.min.x &&
+            min.y <= other.max.y && max.y >= other.min.y &&
+            min.z <= other.max.z && max.z >= other.min.z;
+    }
+
+    bool contains(const Aabb& other) const {
+        return min.x <= other.min.x && max.x >= other.max.x &&
+            min.y <= other.min.y && max.y >= other.max.y &&
+            min.z <= other.min.z && max.z >= other.max.z;
+    }
+
+    Aabb enlarged(const f32 margin) const {
+        return Aabb {.min = min - glm::vec3 {margin}, .max = max + glm::vec3 {margin}};
+    }
+};
+
+struct Penetration {
+    // Unit vector from the first collider towards the second
+    glm::vec3 normal;
+    // Distance to move them apart along `normal` until they only touch
+    meter depth;
+};
+
+Aabb bounds(const Collider& collider, const glm::vec3& position);
+// Empty if the colliders do not overlap
+std::optional<Penetration> collide(
+    const Collider& first,
+    const glm::vec3& first_position,
+    const Collider& second,
+    const glm::vec3& second_position);
+}
@@ -0,0 +1,103 @@
+#include <spire/system/nav_grid.hpp>
+
+#include <cmath>
+#include <fstream>
+#include <iterator>
+
+namespace spire::nav {
+NavGrid::NavGrid(
+    const u32 width,
+    const u32 depth,
+    const glm::vec3 origin,
+    const meter cell_size,
+    std::vector<u8>&& walkable)
+    : _width {width},
+    _depth {depth},
+    _origin {origin},
+    _cell_size {cell_size},
+    _walkable {std::move(walkable)},
+    _regions(_walkable.size(), INVALID_CELL) {
+    // Diagonal steps need both adjacent cells walkable, so regions connected along the axes are all there is.
+    // Labelled once here, so that searches for unreachable goals fail at once instead of exploring a whole region.
+    std::vector<u32> stack;
+    u32 region {0};
+    for (u32 first {0}; first < size(); ++first) {
+        if (!_walkable[first] || _regions[first] != INVALID_CELL) continue;
+
+        _regions[first] = region;
+        stack.push_back(first);
+        while (!stack.empty()) {
+            const u32 cell {stack.back()};
+            stack.pop_back();
+
+            const u32 x {cell % _width};
+            const auto label = [&](const u32 next) {
+                if (!_walkable[next] || _regions[next] != INVALID_CELL) return;
+
+                _regions[next] = region;
+                stack.push_back(next);
+            };
+            if (x > 0) label(cell - 1);
+            if (x + 1 < _width) label(cell + 1);
+            if (cell >= _width) label(cell - _width);
+            if (cell + _width < size()) label(cell + _width);
+        }
+        ++region;
+    }
+}
+
+std::optional<NavGrid> NavGrid::parse(std::string_view text, const glm::vec3 origin, const meter cell_size) {
+    std::vector<u8> walkable;
+    u32 width {0};
+    u32 depth {0};
+
+    while (!text.empty()) {
+        const auto end {text.find('\n')};
+        auto row {text.substr(0, end)};
+        text.remove_prefix(end == std::string_view::npos ? text.size() : end + 1);
+
+        if (row.ends_with('\r')) {
+            row.remove_suffix(1);
+        }
+        if (row.empty()) continue;
+
+        if (depth == 0) {
+            width = static_cast<u32>(row.size());
+        }
+        else if (row.size() != width) {
+            return std::nullopt;
+        }
+
+        for (const char c : row)
+            walkable.push_back(c == '#' ? 0 : 1);
+        ++depth;
+    }
+
+    if (depth == 0) return std::nullopt;
+
+    return NavGrid {width, depth, origin, cell_size, std::move(walkable)};
+}
+
+std::optional<NavGrid> NavGrid::load(const std::filesystem::path& path, const glm::vec3 origin, const meter cell_size) {
+    std::ifstream file {path};
+    if (!file) return std::nullopt;
+
+    const std::string text {std::istreambuf_iterator<char> {file}, std::istreambuf_iterator<char> {}};
+    return parse(text, origin, cell_size);
+}
+
+u32 NavGrid::cell(const glm::vec3& position) const {
+    const f32 x {std::floor((position.x - _origin.x) / _cell_size)};
+    const f32 z {std::floor((position.z - _origin.z) / _cell_size)};
+    if (x < 0.0f || z < 0.0f || x >= static_cast<f32>(_width) || z >= static_cast<f32>(_depth)) return INVALID_CELL;
+
+    return static_cast<u32>(x) + static_cast<u32>(z) * _width;
+}
+
+glm::vec3 NavGrid::center(const u32 cell) const {
+    return glm::vec3 {
+        _origin.x + (static_cast<f32>(cell % _width) + 0.5f) * _cell_size,
+        _origin.y,
+        _origin.z + (static_cast<f32>(cell / _width) + 0.5f) * _cell_size};
+}
+}
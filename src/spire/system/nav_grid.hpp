@@ -0,0 +1,48 @@
+#pragma once
+
+#include <glm/vec3.hpp>
+#include <spire/core/units.hpp>
+
+#include <filesystem>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace spire::nav {
+using Path = std::vector<glm::vec3>;
+
+
+// Walkable cells of a room on the xz plane. Cell `x + z * width` spans `cell_size` from `origin + (x, 0, z) * cell_size`.
+class NavGrid final {
+public:
+    static constexpr u32 INVALID_CELL {~u32 {0}};
+
+    NavGrid(u32 width, u32 depth, glm::vec3 origin, meter cell_size, std::vector<u8>&& walkable);
+
+    // One line per row along z, one character per cell along x, '#' marks blocked cells.
+    // Empty if rows differ in length or there are none.
+    static std::optional<NavGrid> parse(std::string_view text, glm::vec3 origin, meter cell_size);
+    static std::optional<NavGrid> load(const std::filesystem::path& path, glm::vec3 origin, meter cell_size);
+
+    // `INVALID_CELL` outside the grid
+    u32 cell(const glm::vec3& position) const;
+    glm::vec3 center(u32 cell) const;
+    bool is_walkable(const u32 cell) const { return cell < _walkable.size() && _walkable[cell] != 0; }
+    // Cells of different regions have no path between them, blocked cells are in none
+    bool is_connected(const u32 from, const u32 to) const {
+        return is_walkable(from) && is_walkable(to) && _regions[from] == _regions[to];
+    }
+
+    u32 width() const { return _width; }
+    u32 depth() const { return _depth; }
+    u32 size() const { return static_cast<u32>(_walkable.size()); }
+
+private:
+    u32 _width;
+    u32 _depth;
+    glm::vec3 _origin;
+    meter _cell_size;
+    std::vector<u8> _walkable;
+    std::vector<u32> _regions;
+};
+}
@@ -0,0 +1,226 @@
+#include <spire/core/settings.hpp>
+#include <spire/system/path_service.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <numbers>
+#include <queue>
+
+namespace spire::nav {
+static constexpr std::array<std::pair<i32, i32>, 8> NEIGHBOURS {{
+    {1, 0}, {-1, 0}, {0, 1}, {0, -1}, {1, 1}, {1, -1}, {-1, 1}, {-1, -1}}};
+
+// Shortest distance with diagonal steps and no obstacles
+static f32 octile_distance(const i32 dx, const i32 dz) {
+    const auto x {static_cast<f32>(std::abs(dx))};
+    const auto z {static_cast<f32>(std::abs(dz))};
+    return x + z + (std::numbers::sqrt2_v<f32> - 2.0f) * std::min(x, z);
+}
+
+PathService::PathService(
+    std::shared_ptr<const NavGrid> grid,
+    tf::Executor& executor,
+    Deliver&& deliver,
+    const std::string_view room)
+    : _pending_grid {std::move(grid)},
+    _executor {executor},
+    _deliver {std::move(deliver)},
+    _searches {metrics::Metrics::counter(
+        "spire_path_searches_total", "Path queries that continued a search", {{"room", std::string {room}}})},
+    _cache_hits {metrics::Metrics::counter(
+        "spire_path_cache_hits_total",
+        "Path queries answered by the search of an earlier query",
+        {{"room", std::string {room}}})},
+    _failures {metrics::Metrics::counter(
+        "spire_path_failures_total",
+        "Path queries without a path, including searches that gave up",
+        {{"room", std::string {room}}})},
+    _batch_sizes {metrics::Metrics::histogram(
+        "spire_path_batch_size", "Path queries per batch", {{"room", std::string {room}}}, 1.0)} {}
+
+void PathService::find_path(const glm::vec3& from, const glm::vec3& to, Callback&& on_found) {
+    _queries.push(Query {.from = from, .to = to, .on_found = std::move(on_found)});
+    schedule();
+}
+
+void PathService::set_grid(std::shared_ptr<const NavGrid> grid) {
+    std::lock_guard lock {_grid_mutex};
+
+    _pending_grid = std::move(grid);
+}
+
+void PathService::schedule() {
+    if (_is_scheduled.exchange(true)) return;
+
+    _executor.silent_async([self = shared_from_this()] {
+        self->process();
+    });
+}
+
+void PathService::process() {
+    {
+        std::lock_guard lock {_grid_mutex};
+
+        if (_pending_grid != _grid) {
+            _grid = _pending_grid;
+            _goal_searches.clear();
+        }
+    }
+
+    std::queue<Query> queries;
+    _queries.swap(queries);
+    _batch_sizes.record(u64 {queries.size()});
+    ++_batch;
+
+    while (!queries.empty()) {
+        auto& [from, to, on_found] = queries.front();
+
+        auto path {_grid ? solve(_grid->cell(from), _grid->cell(to)) : std::nullopt};
+        _deliver([on_found = std::move(on_found), path = std::move(path)] mutable {
+            on_found(std::move(path));
+        });
+
+        queries.pop();
+    }
+
+    // Queries pushed after the swap saw a batch scheduled and left it to this one
+    _is_scheduled = false;
+    if (!_queries.empty()) {
+        schedule();
+    }
+}
+
+std::optional<Path> PathService::solve(const u32 start, const u32 goal) {
+    if (!_grid->is_connected(start, goal)) {
+        _failures.add();
+        return std::nullopt;
+    }
+
+    auto& search {goal_search(goal)};
+    if (search.is_closed[start]) {
+        _cache_hits.add();
+        return to_waypoints(search, start);
+    }
+
+    _searches.add();
+    if (!this->search(search, start)) {
+        _failures.add();
+        return std::nullopt;
+    }
+
+    return to_waypoints(search, start);
+}
+
+PathService::GoalSearch& PathService::goal_search(const u32 goal) {
+    GoalSearch* least_recent {nullptr};
+    for (const auto& search : _goal_searches) {
+        if (search->goal == goal) {
+            search->last_batch = _batch;
+            return *search;
+        }
+
+        if (!least_recent || search->last_batch < least_recent->last_batch) {
+            least_recent = search.get();
+        }
+    }
+
+    // The least recently used search is reset for the new goal, keeping its memory
+    auto* search {least_recent};
+    if (_goal_searches.size() < std::max(Settings::path_cached_goals(), u32 {1})) {
+        search = _goal_searches.emplace_back(std::make_unique<GoalSearch>()).get();
+    }
+
+    search->goal = goal;
+    search->target = goal;
+    search->last_batch = _batch;
+    search->costs.assign(_grid->size(), std::numeric_limits<f32>::infinity());
+    search->parents.resize(_grid->size());
+    search->is_closed.assign(_grid->size(), 0);
+    search->open.clear();
+
+    search->costs[goal] = 0.0f;
+    search->parents[goal] = NavGrid::INVALID_CELL;
+    search->open.push_back(OpenCell {.estimate = 0.0f, .cost = 0.0f, .cell = goal});
+    return *search;
+}
+
+bool PathService::search(GoalSearch& search, const u32 start) {
+    const auto& grid {*_grid};
+    auto& [goal, target, last_batch, costs, parents, is_closed, open] = search;
+
+    const auto start_x {static_cast<i32>(start % grid.width())};
+    const auto start_z {static_cast<i32>(start / grid.width())};
+    if (target != start) {
+        target = start;
+        for (auto& [estimate, cost, cell] : open) {
+            cost = costs[cell];
+            estimate = cost + octile_distance(
+                static_cast<i32>(cell % grid.width()) - start_x,
+                static_cast<i32>(cell / grid.width()) - start_z);
+        }
+        std::ranges::make_heap(open, std::greater {});
+    }
+
+    u32 expanded {0};
+    while (!open.empty()) {
+        std::ranges::pop_heap(open, std::greater {});
+        const u32 current {open.back().cell};
+        open.pop_back();
+
+        // Cells are pushed again when a cheaper way to them is found instead of updating the heap
+        if (is_closed[current]) continue;
+        is_closed[current] = 1;
+
+        // Expanded before returning, later queries continue from its neighbours
+        const auto x {static_cast<i32>(current % grid.width())};
+        const auto z {static_cast<i32>(current / grid.width())};
+        for (const auto& [dx, dz] : NEIGHBOURS) {
+            const i32 nx {x + dx};
+            const i32 nz {z + dz};
+            if (nx < 0 || nz < 0 || nx >= static_cast<i32>(grid.width()) || nz >= static_cast<i32>(grid.depth())) continue;
+
+            const auto next {static_cast<u32>(nx) + static_cast<u32>(nz) * grid.width()};
+            if (!grid.is_walkable(next) || is_closed[next]) continue;
+
+            const bool is_diagonal {dx != 0 && dz != 0};
+            if (is_diagonal &&
+                (!grid.is_walkable(static_cast<u32>(nx) + static_cast<u32>(z) * grid.width()) ||
+                    !grid.is_walkable(static_cast<u32>(x) + static_cast<u32>(nz) * grid.width()))) continue;
+
+            const f32 cost {costs[current] + (is_diagonal ? std::numbers::sqrt2_v<f32> : 1.0f)};
+            if (costs[next] <= cost) continue;
+
+            costs[next] = cost;
+            parents[next] = current;
+            open.push_back(OpenCell {
+                .estimate = cost + octile_distance(nx - start_x, nz - start_z),
+                .cost = cost,
+                .cell = next});
+            std::ranges::push_heap(open, std::greater {});
+        }
+
+        if (current == start) return true;
+        if (++expanded >= Settings::path_search_limit()) return false;
+    }
+
+    return false;
+}
+
+Path PathService::to_waypoints(const GoalSearch& search, const u32 start) const {
+    Path path;
+
+    // Parents lead to the goal, the start itself is where the query came from
+    u32 previous {start};
+    for (u32 cell {search.parents[start]}; cell != NavGrid::INVALID_CELL; cell = search.parents[cell]) {
+        const u32 next {search.parents[cell]};
+        if (next == NavGrid::INVALID_CELL || cell - previous != next - cell) {
+            path.push_back(_grid->center(cell));
+        }
+        previous = cell;
+    }
+
+    return path;
+}
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <spire/container/concurrent_queue.hpp>
+#include <spire/container/task.hpp>
+#include <spire/core/metrics.hpp>
+#include <spire/system/nav_grid.hpp>
+#include <taskflow/taskflow.hpp>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace spire::nav {
+// Path queries of one room, searched off the room thread. Queries are queued and searched in batches on a work
+// executor, one batch at a time, and each result is handed back to the room through `deliver` to run as a task.
+// Searches run backwards from the goal and are kept for the most recent goals, so that monsters chasing the same
+// target share one search: every cell it closed already knows its shortest path to the goal, and queries from
+// elsewhere resume it towards their start.
+class PathService final : public std::enable_shared_from_this<PathService> {
+public:
+    // Empty if there is no path, or the search gave up after `Settings::path_search_limit()` cells
+    using Callback = std::function<void(std::optional<Path>&&)>;
+    // Posts to the task queue of the room, e.g. through `Room::post_task`
+    using Deliver = std::function<void(Task&&)>;
+
+    PathService(std::shared_ptr<const NavGrid> grid, tf::Executor& executor, Deliver&& deliver, std::string_view room);
+    PathService(const PathService&) = delete;
+    PathService& operator=(const PathService&) = delete;
+
+    void find_path(const glm::vec3& from, const glm::vec3& to, Callback&& on_found);
+    // Takes effect with the next batch, dropping the searches on the previous grid
+    void set_grid(std::shared_ptr<const NavGrid> grid);
+
+private:
+    struct Query {
+        glm::vec3 from;
+        glm::vec3 to;
+        Callback on_found;
+    };
+
+    // Ordered by estimated length, ties by progress so far. On open terrain many paths are equally short, and
+    // preferring cells closest to the start follows one of them instead of expanding all.
+    struct OpenCell {
+        f32 estimate;
+        f32 cost;
+        u32 cell;
+
+        bool operator>(const OpenCell& other) const {
+            return estimate > other.estimate || (estimate == other.estimate && cost < other.cost);
+        }
+    };
+
+    // Search from one goal, indexed by cell. Closed cells have their shortest path to the goal through `parents`.
+    struct GoalSearch {
+        u32 goal {NavGrid::INVALID_CELL};
+        // Start the open cells are ordered towards
+        u32 target {NavGrid::INVALID_CELL};
+        u64 last_batch {0};
+        std::vector<f32> costs {};
+        std::vector<u32> parents {};
+        std::vector<u8> is_closed {};
+        std::vector<OpenCell> open {};
+    };
+
+    void schedule();
+    void process();
+    std::optional<Path> solve(u32 start, u32 goal);
+    GoalSearch& goal_search(u32 goal);
+    // A* from the goal towards `start`, continued from where earlier queries left it. Any consistent heuristic keeps
+    // closed cells exact, so the open cells are only reordered when the start changes.
+    bool search(GoalSearch& search, u32 start);
+    // Waypoints where the direction changes, after `start`
+    Path to_waypoints(const GoalSearch& search, u32 start) const;
+
+    std::shared_ptr<const NavGrid> _pending_grid;
+    std::mutex _grid_mutex {};
+    tf::Executor& _executor;
+    Deliver _deliver;
+
+    ConcurrentQueue<Query> _queries {};
+    std::atomic<bool> _is_scheduled {false};
+
+    // Only accessed by the batch in progress
+    std::shared_ptr<const NavGrid> _grid {};
+    std::vector<std::unique_ptr<GoalSearch>> _goal_searches {};
+    u64 _batch {0};
+
+    metrics::Counter& _searches;
+    metrics::Counter& _cache_hits;
+    metrics::Counter& _failures;
+    metrics::Histogram& _batch_sizes;
+};
+}
@@ -0,0 +1,108 @@
+#include <spire/system/transform_history.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+namespace spire::physics {
+static constexpr u32 INVALID_SLOT {~u32 {0}};
+
+TransformHistory::TransformHistory(const u32 capacity)
+    : _capacity {std::max(capacity, u32 {2})}, _times(_capacity) {}
+
+void TransformHistory::record(
+    const time_point<steady_clock> time,
+    const milliseconds interval,
+    const entt::registry& registry) {
+    if (_sample_count != 0 && time - _times[(_sample_count - 1) % _capacity] < interval) return;
+
+    const u64 current {_sample_count++};
+    _times[current % _capacity] = time;
+
+    for (const auto [entity, transform] : registry.view<Transform>(entt::exclude<StaticPhysics>).each()) {
+        const auto index {static_cast<size_t>(entt::to_entity(entity))};
+        if (index >= _entity_slots.size()) {
+            _entity_slots.resize(index + 1, INVALID_SLOT);
+        }
+
+        // A slot of another version of the identifier belongs to a destroyed entity, it is freed below
+        u32 slot {_entity_slots[index]};
+        if (slot == INVALID_SLOT || _slots[slot].entity != entity) {
+            if (!_free_slots.empty()) {
+                slot = _free_slots.back();
+                _free_slots.pop_back();
+            }
+            else {
+                slot = static_cast<u32>(_slots.size());
+                _slots.emplace_back();
+                _samples.resize(_samples.size() + _capacity);
+            }
+
+            _slots[slot] = Slot {.entity = entity, .first_sample = current, .last_sample = current};
+            _entity_slots[index] = slot;
+        }
+
+        _slots[slot].last_sample = current;
+        sample(slot, current) = transform;
+    }
+
+    // Entities destroyed or made static since the previous sample
+    for (u32 slot {0}; slot < _slots.size(); ++slot) {
+        auto& [entity, first_sample, last_sample] = _slots[slot];
+        if (entity == entt::null || last_sample == current) continue;
+
+        auto& entity_slot {_entity_slots[static_cast<size_t>(entt::to_entity(entity))]};
+        if (entity_slot == slot) {
+            entity_slot = INVALID_SLOT;
+        }
+        entity = entt::null;
+        _free_slots.push_back(slot);
+    }
+}
+
+std::optional<TransformHistory::Rewind> TransformHistory::rewind(const time_point<steady_clock> time) const {
+    if (_sample_count == 0) return std::nullopt;
+
+    const u64 newest {_sample_count - 1};
+    const u64 oldest {_sample_count > _capacity ? _sample_count - _capacity : 0};
+    const auto time_of = [this](const u64 sample) { return _times[sample % _capacity]; };
+
+    if (time >= time_of(newest)) return Rewind {.older = newest, .newer = newest, .alpha = 0.0f};
+    if (time <= time_of(oldest)) return Rewind {.older = oldest, .newer = oldest, .alpha = 0.0f};
+
+    // Samples taken at or before `time` from `older` down, after it from `newer` up
+    u64 older {oldest};
+    u64 newer {newest};
+    while (newer - older > 1) {
+        const u64 middle {older + (newer - older) / 2};
+        if (time_of(middle) <= time) {
+            older = middle;
+        }
+        else {
+            newer = middle;
+        }
+    }
+
+    const duration<f32> offset {time - time_of(older)};
+    const duration<f32> span {time_of(newer) - time_of(older)};
+    return Rewind {.older = older, .newer = newer, .alpha = offset / span};
+}
+
+std::optional<Transform> TransformHistory::transform(const entt::entity entity, const Rewind& rewind) const {
+    const auto index {static_cast<size_t>(entt::to_entity(entity))};
+    if (index >= _entity_slots.size()) return std::nullopt;
+
+    const u32 slot {_entity_slots[index]};
+    if (slot == INVALID_SLOT || _slots[slot].entity != entity) return std::nullopt;
+
+    // Entities sampled later than the time rewound to are seen where they first were
+    const auto& older {sample(slot, std::max(rewind.older, _slots[slot].first_sample))};
+    const auto& newer {sample(slot, std::max(rewind.newer, _slots[slot].first_sample))};
+
+    // Along the shorter way around
+    const radian turn {std::remainder(newer.rotation - older.rotation, 2.0f * std::numbers::pi_v<f32>)};
+    return Transform {
+        .position = older.position + (newer.position - older.position) * rewind.alpha,
+        .rotation = older.rotation + turn * rewind.alpha};
+}
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <entt/entt.hpp>
+#include <spire/component/physics_components.hpp>
+#include <spire/core/types.hpp>
+
+#include <optional>
+#include <vector>
+
+namespace spire::physics {
+// Past transforms of the moving entities of a room, so that hit checks can see targets where a client saw them.
+// Every entity without `StaticPhysics` keeps its latest `capacity` samples, all taken at the same times. Memory is
+// bounded per entity, and rewinding many entities to one time searches the sample times only once.
+class TransformHistory final {
+public:
+    // Position between two samples, the same for every entity rewound to one time
+    struct Rewind {
+        u64 older;
+        u64 newer;
+        f32 alpha;
+    };
+
+    explicit TransformHistory(u32 capacity);
+
+    // Samples every moving entity if `interval` passed since the previous sample
+    void record(time_point<steady_clock> time, milliseconds interval, const entt::registry& registry);
+
+    // Clamped to the samples kept, empty before the first sample. Valid until the next sample is taken.
+    std::optional<Rewind> rewind(time_point<steady_clock> time) const;
+    // Empty if `entity` was not sampled, then it did not move and its current transform applies
+    std::optional<Transform> transform(entt::entity entity, const Rewind& rewind) const;
+
+private:
+    struct Slot {
+        entt::entity entity {entt::null};
+        // Number of the first sample taken of the entity
+        u64 first_sample {0};
+        u64 last_sample {0};
+    };
+
+    const Transform& sample(u32 slot, u64 sample) const { return _samples[slot * _capacity + sample % _capacity]; }
+    Transform& sample(const u32 slot, const u64 sample) { return _samples[slot * _capacity + sample % _capacity]; }
+
+    const u32 _capacity;
+    u64 _sample_count {0};
+    std::vector<time_point<steady_clock>> _times;
+
+    std::vector<Slot> _slots {};
+    std::vector<u32> _free_slots {};
+    // Indexed by entity identifier without version
+    std::vector<u32> _entity_slots {};
+    // `_capacity` samples per slot
+    std::vector<Transform> _samples {};
+};
+}
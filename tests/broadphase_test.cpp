@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+#include <spire/system/broadphase.hpp>
+
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+using namespace spire;
+
+using Pairs = std::set<std::pair<u32, u32>>;
+
+static Pairs sweep(physics::SweepAndPrune& sweep_and_prune) {
+    const auto bodies {sweep_and_prune.bodies()};
+    Pairs pairs {};
+    sweep_and_prune.sweep([&](const physics::SweepAndPrune::Body& first, const physics::SweepAndPrune::Body& second) {
+        const auto lhs {static_cast<u32>(&first - bodies.data())};
+        const auto rhs {static_cast<u32>(&second - bodies.data())};
+        EXPECT_TRUE(pairs.emplace(std::min(lhs, rhs), std::max(lhs, rhs)).second) << "Reported twice";
+    });
+    return pairs;
+}
+
+static Pairs brute_force(const physics::SweepAndPrune& sweep_and_prune, const std::vector<u32>& indices) {
+    const auto bodies {sweep_and_prune.bodies()};
+    Pairs pairs {};
+    for (size_t i {0}; i < indices.size(); ++i) {
+        for (size_t j {i + 1}; j < indices.size(); ++j) {
+            const auto& first {bodies[indices[i]]};
+            const auto& second {bodies[indices[j]]};
+            if ((first.is_dynamic || second.is_dynamic) && first.bounds.overlaps(second.bounds)) {
+                pairs.emplace(std::min(indices[i], indices[j]), std::max(indices[i], indices[j]));
+            }
+        }
+    }
+    return pairs;
+}
+
+TEST(SweepAndPruneTest, MatchesBruteForceWhileBodiesComeMoveAndGo) {
+    std::minstd_rand random {42};
+    std::uniform_real_distribution position {-20.0f, 20.0f};
+    std::uniform_real_distribution step {-0.5f, 0.5f};
+
+    physics::SweepAndPrune sweep_and_prune {};
+    std::vector<u32> indices {};
+    for (u32 tick {0}; tick < 300; ++tick) {
+        for (const auto index : indices) {
+            const glm::vec3 offset {step(random), step(random), step(random)};
+            const auto& bounds {sweep_and_prune.bodies()[index].bounds};
+            sweep_and_prune.update(index, {.min = bounds.min + offset, .max = bounds.max + offset}, random() % 8 != 0);
+        }
+
+        for (size_t i {0}; i < 5; ++i) {
+            const glm::vec3 center {position(random), position(random) / 4.0f, position(random)};
+            indices.push_back(sweep_and_prune.add(physics::SweepAndPrune::Body {
+                .bounds = physics::bounds(Collider::sphere(0.5f), center),
+                .entity = entt::entity {tick},
+                .is_dynamic = random() % 3 != 0,
+            }));
+        }
+
+        for (size_t i {0}; i < 3; ++i) {
+            const auto removed {indices.begin() + static_cast<std::ptrdiff_t>(random() % indices.size())};
+            sweep_and_prune.remove(*removed);
+            indices.erase(removed);
+        }
+
+        ASSERT_EQ(sweep(sweep_and_prune), brute_force(sweep_and_prune, indices)) << "Tick " << tick;
+    }
+}
+
+TEST(SweepAndPruneTest, OnlySearchesBodiesThatLeftTheirBounds) {
+    physics::SweepAndPrune sweep_and_prune {};
+    const auto still {sweep_and_prune.add({
+        .bounds = physics::bounds(Collider::sphere(0.5f), {0.0f, 0.0f, 0.0f}),
+        .entity = entt::entity {1},
+        .is_dynamic = true,
+    })};
+    const auto moving {sweep_and_prune.add({
+        .bounds = physics::bounds(Collider::sphere(0.5f), {10.0f, 0.0f, 0.0f}),
+        .entity = entt::entity {2},
+        .is_dynamic = true,
+    })};
+    sweep(sweep_and_prune);
+
+    sweep_and_prune.update(moving, physics::bounds(Collider::sphere(0.5f), {10.1f, 0.0f, 0.0f}), true);
+    sweep(sweep_and_prune);
+    EXPECT_TRUE(sweep_and_prune.moved().empty());
+
+    sweep_and_prune.update(moving, physics::bounds(Collider::sphere(0.5f), {0.5f, 0.0f, 0.0f}), true);
+    EXPECT_EQ(sweep(sweep_and_prune), (Pairs {{still, moving}}));
+    EXPECT_TRUE(sweep_and_prune.was_moved(moving));
+    EXPECT_FALSE(sweep_and_prune.was_moved(still));
+}
+
+TEST(StaticBvhTest, MatchesBruteForce) {
+    std::minstd_rand random {42};
+    std::uniform_real_distribution position {-100.0f, 100.0f};
+
+    std::vector<physics::StaticBvh::Item> items {};
+    for (u32 i {0}; i < 1000; ++i) {
+        const glm::vec3 center {position(random), position(random), position(random)};
+        items.push_back({.bounds = physics::bounds(Collider::box(glm::vec3 {1.0f}), center), .entity = entt::entity {i}});
+    }
+
+    physics::StaticBvh bvh {};
+    bvh.build(std::vector {items});
+
+    for (size_t i {0}; i < 200; ++i) {
+        const glm::vec3 center {position(random), position(random), position(random)};
+        const auto bounds {physics::bounds(Collider::sphere(10.0f), center)};
+
+        std::set<entt::entity> expected {};
+        for (const auto& item : items) {
+            if (item.bounds.overlaps(bounds)) expected.insert(item.entity);
+        }
+
+        std::set<entt::entity> found {};
+        bvh.query(bounds, [&](const physics::StaticBvh::Item& item) { found.insert(item.entity); });
+        ASSERT_EQ(found, expected);
+    }
+}
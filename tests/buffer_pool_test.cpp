@@ -0,0 +1,51 @@
+#include <gtest/gtest.h>
+#include <spire/net/buffer_pool.hpp>
+
+#include <thread>
+#include <vector>
+
+using namespace spire;
+
+class BufferPoolTest : public testing::Test {
+protected:
+    static constexpr size_t COUNT {64};
+    static constexpr size_t CAPACITY {1024};
+
+    static void SetUpTestSuite() { net::BufferPool::reserve(COUNT, CAPACITY); }
+};
+
+TEST_F(BufferPoolTest, AcquiresEmptyBuffersOfThePooledCapacity) {
+    auto buffer {net::BufferPool::acquire()};
+    EXPECT_TRUE(buffer.empty());
+    EXPECT_GE(buffer.capacity(), CAPACITY);
+
+    net::BufferPool::release(std::move(buffer));
+}
+
+TEST_F(BufferPoolTest, ClearsReleasedBuffers) {
+    auto buffer {net::BufferPool::acquire()};
+    buffer.resize(CAPACITY / 2, std::byte {0xFF});
+    net::BufferPool::release(std::move(buffer));
+
+    for (size_t i {0}; i < COUNT; ++i) {
+        EXPECT_TRUE(net::BufferPool::acquire().empty());
+    }
+}
+
+TEST_F(BufferPoolTest, ReturnsBuffersReleasedOnAnotherThread) {
+    // More than the pool holds, which drains the shared list and the cache of this thread
+    std::vector<std::vector<std::byte>> buffers {};
+    for (size_t i {0}; i < COUNT + COUNT / 2; ++i) {
+        buffers.push_back(net::BufferPool::acquire());
+    }
+    EXPECT_EQ(net::BufferPool::size(), 0);
+
+    std::jthread {[&] {
+        for (auto& buffer : buffers) {
+            net::BufferPool::release(std::move(buffer));
+        }
+    }}.join();
+
+    // The exited thread spilled its cache, keeping no more than the reserved count
+    EXPECT_EQ(net::BufferPool::size(), COUNT);
+}
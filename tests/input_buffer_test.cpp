@@ -0,0 +1,63 @@
+#include <gtest/gtest.h>
+#include <spire/component/input_components.hpp>
+
+#include <vector>
+
+using namespace spire;
+
+static std::vector<u32> apply(InputBuffer& buffer) {
+    std::vector<u32> ticks {};
+    buffer.apply([&](const InputCommand& command) { ticks.push_back(command.tick); });
+    return ticks;
+}
+
+class InputBufferTest : public testing::TestWithParam<u32> {};
+
+TEST_P(InputBufferTest, AppliesInTickOrder) {
+    const u32 start {GetParam()};
+    InputBuffer buffer {};
+
+    EXPECT_TRUE(buffer.push({.tick = start, .direction = {}, .rotation = {}}));
+    EXPECT_TRUE(buffer.push({.tick = start + 2, .direction = {}, .rotation = {}}));
+    EXPECT_TRUE(buffer.push({.tick = start + 1, .direction = {}, .rotation = {}}));
+
+    EXPECT_EQ(apply(buffer), (std::vector<u32> {start, start + 1, start + 2}));
+    EXPECT_EQ(buffer.last_applied_tick(), start + 2);
+}
+
+TEST_P(InputBufferTest, DropsDuplicatesAndStaleCommands) {
+    const u32 start {GetParam()};
+    InputBuffer buffer {};
+
+    EXPECT_TRUE(buffer.push({.tick = start, .direction = {}, .rotation = {}}));
+    EXPECT_FALSE(buffer.push({.tick = start, .direction = {}, .rotation = {}}));
+    apply(buffer);
+
+    EXPECT_FALSE(buffer.push({.tick = start, .direction = {}, .rotation = {}}));
+    EXPECT_FALSE(buffer.push({.tick = start - 1, .direction = {}, .rotation = {}}));
+    EXPECT_TRUE(apply(buffer).empty());
+}
+
+TEST_P(InputBufferTest, KeepsAcceptingAcrossTheRing) {
+    const u32 start {GetParam()};
+    InputBuffer buffer {};
+
+    for (u32 offset {0}; offset < 4 * InputBuffer::CAPACITY; ++offset) {
+        ASSERT_TRUE(buffer.push({.tick = start + offset, .direction = {}, .rotation = {}}));
+        ASSERT_EQ(apply(buffer), std::vector<u32> {start + offset});
+    }
+}
+
+TEST_P(InputBufferTest, SkipsAheadAfterAGap) {
+    const u32 start {GetParam()};
+    InputBuffer buffer {};
+
+    EXPECT_TRUE(buffer.push({.tick = start, .direction = {}, .rotation = {}}));
+    EXPECT_TRUE(buffer.push({.tick = start + 1, .direction = {}, .rotation = {}}));
+    EXPECT_TRUE(buffer.push({.tick = start + 1000, .direction = {}, .rotation = {}}));
+
+    EXPECT_EQ(apply(buffer), std::vector<u32> {start + 1000});
+}
+
+// Clients may start counting anywhere, including 0 and right before the counter wraps
+INSTANTIATE_TEST_SUITE_P(Start, InputBufferTest, testing::Values(0u, 5u, 0xFFFF'FFF0u));
@@ -0,0 +1,28 @@
+#include <gtest/gtest.h>
+#include <spire/core/log.hpp>
+
+#include <thread>
+
+using namespace spire;
+
+TEST(LogLimiterTest, DropsMessagesBeyondTheRate) {
+    LogLimiter limiter {3};
+
+    for (size_t i {0}; i < 3; ++i) {
+        EXPECT_EQ(limiter.acquire(), std::optional<u64> {0});
+    }
+    EXPECT_EQ(limiter.acquire(), std::nullopt);
+    EXPECT_EQ(limiter.acquire(), std::nullopt);
+}
+
+TEST(LogLimiterTest, ReportsDropsWithTheNextMessage) {
+    LogLimiter limiter {1};
+
+    EXPECT_EQ(limiter.acquire(), std::optional<u64> {0});
+    EXPECT_EQ(limiter.acquire(), std::nullopt);
+    EXPECT_EQ(limiter.acquire(), std::nullopt);
+
+    std::this_thread::sleep_for(1100ms);
+    EXPECT_EQ(limiter.acquire(), std::optional<u64> {2});
+    EXPECT_EQ(limiter.acquire(), std::nullopt);
+}
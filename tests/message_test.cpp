@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+#include <spire/core/compression.hpp>
+#include <spire/core/settings.hpp>
+#include <spire/net/message.hpp>
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace spire;
+
+static msg::BaseMessage make_login(const size_t token_size) {
+    auto* login {new msg::Login};
+    login->set_token(std::string(token_size, 'x'));
+    login->set_account_id(1);
+    login->set_character_id(2);
+
+    msg::BaseMessage base {};
+    base.set_allocated_login(login);
+    return base;
+}
+
+static net::ExtendedHeader read_extended_header(const net::OutMessage& message) {
+    const auto span {message.span()};
+    const auto header {net::MessageHeader::deserialize(span.first<net::MessageHeader::SIZE>())};
+    EXPECT_EQ(header.body_size, net::MessageHeader::EXTENDED);
+
+    return net::ExtendedHeader::deserialize(span.subspan<net::MessageHeader::SIZE, net::ExtendedHeader::SIZE>());
+}
+
+class MessageTest : public testing::Test {
+protected:
+    void TearDown() override { Compression::configure(Codec::None, 0); }
+};
+
+TEST_F(MessageTest, RoundTripsHeaders) {
+    std::array<std::byte, net::MessageHeader::SIZE> buffer {};
+    net::MessageHeader::serialize(net::MessageHeader {.body_size = 0x1234}, buffer);
+    EXPECT_EQ(net::MessageHeader::deserialize(buffer).body_size, 0x1234);
+
+    std::array<std::byte, net::ExtendedHeader::SIZE> extended_buffer {};
+    const net::ExtendedHeader extended {.flags = net::ExtendedHeader::Zstd, .body_size = 70'000, .raw_size = 90'000};
+    net::ExtendedHeader::serialize(extended, extended_buffer);
+
+    const auto read {net::ExtendedHeader::deserialize(extended_buffer)};
+    EXPECT_EQ(read.flags, extended.flags);
+    EXPECT_EQ(read.body_size, extended.body_size);
+    EXPECT_EQ(read.raw_size, extended.raw_size);
+}
+
+TEST_F(MessageTest, SerializesSmallBodiesAfterAPlainHeader) {
+    const auto base {make_login(16)};
+    const net::OutMessage message {base};
+
+    const auto header {net::MessageHeader::deserialize(message.span().first<net::MessageHeader::SIZE>())};
+    ASSERT_EQ(header.body_size, base.ByteSizeLong());
+    ASSERT_EQ(message.size(), net::MessageHeader::SIZE + header.body_size);
+    EXPECT_FALSE(message.is_compressed());
+
+    msg::BaseMessage parsed {};
+    ASSERT_TRUE(parsed.ParseFromArray(message.span().data() + net::MessageHeader::SIZE, header.body_size));
+    EXPECT_EQ(parsed.login().token(), base.login().token());
+}
+
+TEST_F(MessageTest, CompressesBodiesAboveTheThreshold) {
+    Compression::configure(Codec::Lz4, 1);
+    const auto base {make_login(4 * Settings::compression_threshold())};
+    const net::OutMessage message {base};
+    ASSERT_TRUE(message.is_compressed());
+
+    const auto header {read_extended_header(message)};
+    ASSERT_TRUE(header.is_valid());
+    EXPECT_EQ(header.codec(), Codec::Lz4);
+    EXPECT_EQ(header.raw_size, base.ByteSizeLong());
+
+    const auto body {message.span().subspan(net::MessageHeader::SIZE + net::ExtendedHeader::SIZE)};
+    std::vector<std::byte> decoded {body.begin(), body.end()};
+    ASSERT_TRUE(header.decode(decoded));
+
+    msg::BaseMessage parsed {};
+    ASSERT_TRUE(parsed.ParseFromArray(decoded.data(), static_cast<int>(decoded.size())));
+    EXPECT_EQ(parsed.login().token(), base.login().token());
+}
+
+TEST_F(MessageTest, ConcatenatesFramesOutsideOfContainers) {
+    std::vector<std::shared_ptr<net::OutMessage>> messages {};
+    for (size_t i {0}; i < 3; ++i) {
+        messages.push_back(std::make_shared<net::OutMessage>(make_login(8)));
+    }
+
+    const net::OutMessage batch {messages, false};
+    ASSERT_EQ(batch.size(), 3 * messages.front()->size());
+    EXPECT_TRUE(std::ranges::equal(batch.span().first(messages.front()->size()), messages.front()->span()));
+}
+
+TEST_F(MessageTest, PacksFramesIntoContainers) {
+    std::vector<std::shared_ptr<net::OutMessage>> messages {};
+    for (size_t i {0}; i < 3; ++i) {
+        messages.push_back(std::make_shared<net::OutMessage>(make_login(8)));
+    }
+
+    const net::OutMessage container {messages, true};
+    const auto header {read_extended_header(container)};
+    EXPECT_TRUE(header.flags & net::ExtendedHeader::Container);
+    EXPECT_FALSE(header.is_compressed());
+    EXPECT_EQ(header.body_size, 3 * messages.front()->size());
+}
+
+TEST_F(MessageTest, DoesNotRecompressCompressedFrames) {
+    Compression::configure(Codec::Lz4, 1);
+    std::vector<std::shared_ptr<net::OutMessage>> messages {};
+    for (size_t i {0}; i < 3; ++i) {
+        messages.push_back(std::make_shared<net::OutMessage>(make_login(4 * Settings::compression_threshold())));
+        ASSERT_TRUE(messages.back()->is_compressed());
+    }
+
+    const net::OutMessage container {messages, true};
+    const auto header {read_extended_header(container)};
+    EXPECT_TRUE(header.flags & net::ExtendedHeader::Container);
+    EXPECT_FALSE(header.is_compressed());
+}
@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+#include <spire/core/random.hpp>
+
+#include <array>
+#include <vector>
+
+using namespace spire;
+
+TEST(RandomTest, RepeatsSequencesOfOneSeed) {
+    Random first {42};
+    Random second {42};
+
+    for (size_t i {0}; i < 1000; ++i) {
+        ASSERT_EQ(first(), second());
+    }
+}
+
+TEST(RandomTest, SeparatesStreamsOfOneSeed) {
+    Random first {42, 1};
+    Random second {42, 2};
+
+    size_t equal_count {0};
+    for (size_t i {0}; i < 1000; ++i) {
+        if (first() == second()) ++equal_count;
+    }
+    EXPECT_EQ(equal_count, 0);
+}
+
+TEST(RandomTest, StaysWithinBounds) {
+    Random random {7};
+    std::array<size_t, 6> counts {};
+
+    for (size_t i {0}; i < 60'000; ++i) {
+        const auto value {random.below(counts.size())};
+        ASSERT_LT(value, counts.size());
+        ++counts[value];
+
+        const auto uniform {random.uniform()};
+        ASSERT_GE(uniform, 0.0f);
+        ASSERT_LT(uniform, 1.0f);
+    }
+
+    // Each face within 5% of the expected 10000
+    for (const auto count : counts) {
+        EXPECT_NEAR(static_cast<f64>(count), 10'000.0, 500.0);
+    }
+}
+
+TEST(RandomTest, FillsBatchesWithinBounds) {
+    Random random {7};
+    RandomBatch batch {random};
+    std::vector<u32> values(1000);
+
+    batch.fill_below(values, 10);
+    for (const auto value : values) {
+        ASSERT_LT(value, 10);
+    }
+
+    std::vector<f32> uniforms(1000);
+    batch.fill_uniform(uniforms);
+    for (const auto value : uniforms) {
+        ASSERT_GE(value, 0.0f);
+        ASSERT_LT(value, 1.0f);
+    }
+}
@@ -0,0 +1,51 @@
+#include <gtest/gtest.h>
+#include <spire/server/session_table.hpp>
+
+using namespace spire;
+
+static constexpr SessionIdentity IDENTITY {.account_id = 1, .character_id = 2};
+
+TEST(SessionTableTest, ResumesParkedSessionsOnce) {
+    SessionTable sessions {};
+    const auto token {sessions.open(1, IDENTITY)};
+
+    // Still active until its connection drops
+    EXPECT_FALSE(sessions.resume(token, 2));
+
+    sessions.park(1, {});
+    const auto resumed {sessions.resume(token, 2)};
+    ASSERT_TRUE(resumed);
+    EXPECT_EQ(resumed->identity.character_id, IDENTITY.character_id);
+    EXPECT_NE(resumed->token, token);
+
+    EXPECT_FALSE(sessions.resume(token, 3));
+}
+
+TEST(SessionTableTest, ResumingReplacesTheSessionOfTheClient) {
+    SessionTable sessions {};
+    const auto parked {sessions.open(1, IDENTITY)};
+    sessions.park(1, {});
+    const auto replaced {sessions.open(2, SessionIdentity {.account_id = 3, .character_id = 4})};
+
+    const auto resumed {sessions.resume(parked, 2)};
+    ASSERT_TRUE(resumed);
+
+    // Client 2 drops again, only its resumed session can be resumed
+    sessions.park(2, {});
+    EXPECT_FALSE(sessions.resume(replaced, 3));
+    EXPECT_TRUE(sessions.resume(resumed->token, 3));
+}
+
+TEST(SessionTableTest, HandsParkedSessionsOver) {
+    SessionTable predecessor {};
+    const auto token {predecessor.open(1, IDENTITY)};
+    predecessor.park(1, {});
+
+    SessionTable successor {};
+    ASSERT_TRUE(successor.deserialize(predecessor.serialize()));
+
+    const auto resumed {successor.resume(token, 2)};
+    ASSERT_TRUE(resumed);
+    EXPECT_EQ(resumed->identity.account_id, IDENTITY.account_id);
+    EXPECT_EQ(resumed->identity.character_id, IDENTITY.character_id);
+}
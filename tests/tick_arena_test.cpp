@@ -0,0 +1,53 @@
+#include <gtest/gtest.h>
+#include <spire/core/tick_arena.hpp>
+#include <spire/msg/base_message.pb.h>
+
+#include <optional>
+#include <string>
+
+using namespace spire;
+
+TEST(TickArenaTest, UsesTheArenaOnlyWithinAScope) {
+    TickArena arena {1024, 1024};
+    EXPECT_EQ(TickArena::current_resource(), std::pmr::get_default_resource());
+    {
+        TickArena::Scope scope {arena};
+        EXPECT_EQ(TickArena::current(), &arena);
+        EXPECT_EQ(TickArena::current_resource(), arena.resource());
+    }
+    EXPECT_EQ(TickArena::current(), nullptr);
+}
+
+TEST(TickArenaTest, PromotedContainersOutliveTheTick) {
+    TickArena arena {1024, 1024};
+    // Move constructed, so that it keeps the allocator of the promoted copy
+    std::optional<std::pmr::vector<std::pmr::string>> promoted {};
+    {
+        TickArena::Scope scope {arena};
+        std::pmr::vector<std::pmr::string> names {TickArena::current_resource()};
+        names.emplace_back("a name long enough to not be stored inline");
+        promoted.emplace(TickArena::promote(names));
+    }
+
+    EXPECT_EQ(promoted->get_allocator().resource(), std::pmr::new_delete_resource());
+    EXPECT_EQ(promoted->front().get_allocator().resource(), std::pmr::new_delete_resource());
+
+    // Reuses the memory of the previous tick
+    TickArena::Scope scope {arena};
+    std::pmr::string overwrite(64, 'x', TickArena::current_resource());
+    EXPECT_EQ(promoted->front(), "a name long enough to not be stored inline");
+}
+
+TEST(TickArenaTest, PromotedMessagesOutliveTheTick) {
+    TickArena arena {1024, 1024};
+    std::unique_ptr<msg::BaseMessage> promoted {};
+    {
+        TickArena::Scope scope {arena};
+        auto* const message {google::protobuf::Arena::Create<msg::BaseMessage>(&arena.messages())};
+        message->mutable_move()->set_tick(42);
+        promoted = TickArena::promote(*message);
+    }
+
+    EXPECT_EQ(promoted->GetArena(), nullptr);
+    EXPECT_EQ(promoted->move().tick(), 42);
+}
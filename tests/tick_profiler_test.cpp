@@ -0,0 +1,28 @@
+#include <gtest/gtest.h>
+#include <spire/server/tick_profiler.hpp>
+
+using namespace spire;
+
+TEST(TickProfilerTest, SumsMessageCasesBeyondTheLimitIntoOther) {
+    TickProfiler profiler {1, "test"};
+    profiler.set_enabled(true);
+
+    const auto now {steady_clock::now()};
+    profiler.begin_tick(now);
+    for (u32 i {1}; i <= TickProfiler::MAX_HANDLER_TIMINGS + 2; ++i) {
+        profiler.record_handler(static_cast<msg::BaseMessage::MessageCase>(i), 1ms);
+    }
+    profiler.record_handler(static_cast<msg::BaseMessage::MessageCase>(TickProfiler::MAX_HANDLER_TIMINGS), 1ms);
+    profiler.end_tick(now, TickProfiler::MAX_HANDLER_TIMINGS + 3, 0);
+
+    const auto records {profiler.records()};
+    ASSERT_EQ(records.size(), 1);
+
+    const auto& record {records.front()};
+    ASSERT_EQ(record.handler_count, TickProfiler::MAX_HANDLER_TIMINGS);
+    const auto& last {record.handlers.back()};
+    EXPECT_EQ(last.message_case, static_cast<msg::BaseMessage::MessageCase>(TickProfiler::MAX_HANDLER_TIMINGS));
+    EXPECT_EQ(last.count, 2);
+    EXPECT_EQ(record.other_handlers.count, 2);
+    EXPECT_EQ(record.other_handlers.duration, 2ms);
+}
@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+#include <spire/net/udp_transport.hpp>
+
+#include <functional>
+#include <vector>
+
+using namespace spire;
+
+class UdpTransportTest : public testing::Test {
+protected:
+    void SetUp() override {
+        _transport.start();
+        _session = _transport.open_session();
+        _session->init([this](std::vector<std::byte>&& data) {
+            msg::BaseMessage base {};
+            ASSERT_TRUE(base.ParseFromArray(data.data(), static_cast<int>(data.size())));
+            _delivered.push_back(base.move().tick());
+        });
+    }
+
+    void TearDown() override {
+        _session->close();
+        _transport.stop();
+        _io_context.poll();
+    }
+
+    // Movement update whose tick equals its sequence
+    std::vector<std::byte> make_datagram(const u32 sequence, const u64 token, const net::DatagramKey& key) const {
+        msg::BaseMessage base {};
+        base.mutable_move()->set_tick(sequence);
+
+        std::vector<std::byte> datagram(net::DatagramHeader::SIZE + base.ByteSizeLong() + net::DATAGRAM_TAG_SIZE);
+        net::DatagramHeader::serialize(
+            net::DatagramHeader {
+                .session_token = token,
+                .channel = net::DatagramChannel::Movement,
+                .sequence = sequence,
+            },
+            std::span<std::byte, net::DatagramHeader::SIZE> {datagram.data(), net::DatagramHeader::SIZE});
+        base.SerializeToArray(datagram.data() + net::DatagramHeader::SIZE, static_cast<int>(base.ByteSizeLong()));
+        net::sign_datagram(datagram, key);
+        return datagram;
+    }
+
+    std::vector<std::byte> make_datagram(const u32 sequence) const {
+        return make_datagram(sequence, _session->token(), _session->key());
+    }
+
+    void send(const std::vector<std::byte>& datagram) { _socket.send_to(boost::asio::buffer(datagram), _endpoint); }
+
+    // Runs the transport until `tick` is delivered, false if it is not within the deadline
+    bool run_until_delivered(const u32 tick) {
+        const auto deadline {steady_clock::now() + 5s};
+        while (_delivered.empty() || _delivered.back() != tick) {
+            if (steady_clock::now() >= deadline) return false;
+            _io_context.run_one_until(deadline);
+        }
+        return true;
+    }
+
+    boost::asio::io_context _io_context {1};
+    net::UdpTransport _transport {_io_context.get_executor(), 0};
+    std::shared_ptr<net::DatagramSession> _session {};
+    std::vector<u32> _delivered {};
+
+    boost::asio::ip::udp::socket _socket {_io_context, {boost::asio::ip::udp::v4(), 0}};
+    const boost::asio::ip::udp::endpoint _endpoint {boost::asio::ip::address_v4::loopback(), _transport.port()};
+};
+
+TEST_F(UdpTransportTest, DropsUpdatesOlderThanDeliveredOnes) {
+    // Lost and swapped on the way, as a congested link would
+    for (const u32 sequence : {1u, 3u, 2u, 4u, 7u, 5u, 6u, 9u, 8u, 10u}) {
+        send(make_datagram(sequence));
+    }
+
+    ASSERT_TRUE(run_until_delivered(10));
+    EXPECT_EQ(_delivered, (std::vector<u32> {1, 3, 4, 7, 9, 10}));
+    EXPECT_TRUE(_session->is_bound());
+}
+
+TEST_F(UdpTransportTest, DeliversAcrossSequenceWraparound) {
+    for (const u32 sequence : {0xFFFF'FFFEu, 0xFFFF'FFFFu, 0u, 1u}) {
+        send(make_datagram(sequence));
+    }
+
+    ASSERT_TRUE(run_until_delivered(1));
+    EXPECT_EQ(_delivered, (std::vector<u32> {0xFFFF'FFFE, 0xFFFF'FFFF, 0, 1}));
+}
+
+TEST_F(UdpTransportTest, IgnoresDatagramsWithoutTheSessionKey) {
+    net::DatagramKey forged_key {};
+    forged_key.fill(std::byte {0x5A});
+
+    // Neither binds the endpoint nor advances the sequence, so the genuine update after it still arrives
+    send(make_datagram(100, _session->token(), forged_key));
+    send(make_datagram(1));
+
+    ASSERT_TRUE(run_until_delivered(1));
+    EXPECT_EQ(_delivered, std::vector<u32> {1});
+}
+
+TEST_F(UdpTransportTest, IgnoresUnknownTokens) {
+    send(make_datagram(1, _session->token() + 1, _session->key()));
+    send(make_datagram(2));
+
+    ASSERT_TRUE(run_until_delivered(2));
+    EXPECT_EQ(_delivered, std::vector<u32> {2});
+}
@@ -0,0 +1,210 @@
+#include <spire/core/game_data.hpp>
+#include <spire/core/types.hpp>
+#include <yaml-cpp/yaml.h>
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <vector>
+
+using namespace spire;
+
+struct Options {
+    std::filesystem::path input {};
+    std::filesystem::path output {};
+    u32 revision {0};
+};
+
+struct PackedTable {
+    DataTable table;
+    u32 record_size;
+    u64 count;
+    std::vector<std::byte> records;
+};
+
+static void print_usage() {
+    std::cerr << std::format(
+        "Usage: pack_data --input=<file> --output=<file> [options]\n"
+        "  --input=<file>             YAML with a sequence per table, omitted fields are 0\n"
+        "                               monsters: id, health, mana, stamina, speed, experience, strength, magic,\n"
+        "                                 agility, endurance, constitution\n"
+        "                               world_portals: id, target_world_id, target_room_id\n"
+        "                               room_portals: id, target_room_id\n"
+        "  --output=<file>            Packed data, set as `game_data_file` in settings.yaml\n"
+        "  --revision=<n>             Revision of the content, reported when loaded (default 0)\n");
+}
+
+static std::optional<Options> parse_options(const int argc, const char* argv[]) {
+    Options options {};
+
+    for (int i {1}; i < argc; ++i) {
+        const std::string_view argument {argv[i]};
+        const auto separator {argument.find('=')};
+        if (!argument.starts_with("--") || separator == std::string_view::npos) return std::nullopt;
+
+        const auto key {argument.substr(2, separator - 2)};
+        const auto value {argument.substr(separator + 1)};
+
+        bool ok {true};
+        if (key == "input") options.input = value;
+        else if (key == "output") options.output = value;
+        else if (key == "revision") {
+            const auto [end, ec] = std::from_chars(value.data(), value.data() + value.size(), options.revision);
+            ok = ec == std::errc {} && end == value.data() + value.size();
+        }
+        else ok = false;
+
+        if (!ok) return std::nullopt;
+    }
+
+    if (options.input.empty() || options.output.empty()) return std::nullopt;
+
+    return options;
+}
+
+static MonsterData parse_monster(const YAML::Node& node) {
+    return MonsterData {
+        .id = node["id"].as<u64>(),
+        .stats = CoreStats {
+            .strength = node["strength"].as<u32>(0),
+            .magic = node["magic"].as<u32>(0),
+            .agility = node["agility"].as<u32>(0),
+            .endurance = node["endurance"].as<u32>(0),
+            .constitution = node["constitution"].as<u32>(0)},
+        .health = node["health"].as<u32>(0),
+        .mana = node["mana"].as<u32>(0),
+        .stamina = node["stamina"].as<u32>(0),
+        .speed = node["speed"].as<f32>(0.0f),
+        .experience = node["experience"].as<u32>(0)};
+}
+
+static WorldPortal parse_world_portal(const YAML::Node& node) {
+    return WorldPortal {
+        .id = node["id"].as<u32>(),
+        .target_world_id = node["target_world_id"].as<u32>(0),
+        .target_room_id = node["target_room_id"].as<u32>(0)};
+}
+
+static RoomPortal parse_room_portal(const YAML::Node& node) {
+    return RoomPortal {.id = node["id"].as<u32>(), .target_room_id = node["target_room_id"].as<u32>(0)};
+}
+
+// Sorted by id for the lookups of `GameData`, false if an id is taken twice
+template <typename Record, typename Parse>
+static bool pack_table(
+    const char* name,
+    const YAML::Node& root,
+    const Parse& parse,
+    std::vector<PackedTable>& tables) {
+    const auto node {root[name]};
+    if (!node) return true;
+
+    std::vector<Record> records;
+    for (const auto& record : node)
+        records.push_back(parse(record));
+
+    std::ranges::sort(records, {}, &Record::id);
+    if (const auto it {std::ranges::adjacent_find(records, {}, &Record::id)}; it != records.end()) {
+        std::cerr << std::format("Duplicate id {} in {}\n", u64 {it->id}, name);
+        return false;
+    }
+
+    PackedTable table {
+        .table = DataTableOf<Record>::value,
+        .record_size = sizeof(Record),
+        .count = records.size(),
+        .records = std::vector<std::byte>(records.size() * sizeof(Record))};
+    std::memcpy(table.records.data(), records.data(), table.records.size());
+    tables.push_back(std::move(table));
+    return true;
+}
+
+static std::vector<std::byte> pack(const std::vector<PackedTable>& tables, const u32 revision) {
+    const auto align = [](const size_t offset) {
+        return (offset + GameDataHeader::TABLE_ALIGNMENT - 1) / GameDataHeader::TABLE_ALIGNMENT
+            * GameDataHeader::TABLE_ALIGNMENT;
+    };
+
+    size_t size {sizeof(GameDataHeader) + tables.size() * sizeof(GameDataTable)};
+    std::vector<GameDataTable> directory;
+    for (const auto& table : tables) {
+        size = align(size);
+        directory.push_back(GameDataTable {
+            .table = table.table,
+            .record_size = table.record_size,
+            .count = table.count,
+            .offset = size});
+        size += table.records.size();
+    }
+
+    const GameDataHeader header {
+        .magic = GameDataHeader::MAGIC,
+        .format_version = GameDataHeader::FORMAT_VERSION,
+        .table_count = static_cast<u16>(tables.size()),
+        .revision = revision,
+        .reserved = 0};
+
+    // Zeroed, so that the padding between tables is the same for every build of the same input
+    std::vector<std::byte> data(size);
+    std::memcpy(data.data(), &header, sizeof(header));
+    std::memcpy(data.data() + sizeof(header), directory.data(), directory.size() * sizeof(GameDataTable));
+    for (size_t i {0}; i < tables.size(); ++i)
+        std::ranges::copy(tables[i].records, data.begin() + static_cast<std::ptrdiff_t>(directory[i].offset));
+
+    return data;
+}
+
+int main(const int argc, const char* argv[]) {
+    const auto options {parse_options(argc, argv)};
+    if (!options) {
+        print_usage();
+        return EXIT_FAILURE;
+    }
+
+    std::vector<PackedTable> tables;
+    try {
+        const auto root {YAML::LoadFile(options->input.string())};
+
+        const bool ok {
+            pack_table<MonsterData>("monsters", root, parse_monster, tables)
+            && pack_table<WorldPortal>("world_portals", root, parse_world_portal, tables)
+            && pack_table<RoomPortal>("room_portals", root, parse_room_portal, tables)};
+        if (!ok) return EXIT_FAILURE;
+    }
+    catch (const YAML::Exception& e) {
+        std::cerr << std::format("Could not read {}: {}\n", options->input.string(), e.what());
+        return EXIT_FAILURE;
+    }
+
+    const auto data {pack(tables, options->revision)};
+
+    // Renamed over the output, as a server may have the previous file mapped
+    auto temporary {options->output};
+    temporary += ".tmp";
+    {
+        std::ofstream file {temporary, std::ios::binary};
+        file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+        if (!file) {
+            std::cerr << std::format("Could not write {}\n", temporary.string());
+            return EXIT_FAILURE;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(temporary, options->output, ec);
+    if (ec) {
+        std::cerr << std::format("Could not replace {}: {}\n", options->output.string(), ec.message());
+        return EXIT_FAILURE;
+    }
+
+    std::cout << std::format("Packed {} tables into {} bytes\n", tables.size(), data.size());
+    for (const auto& table : tables)
+        std::cout << std::format("  table {}: {} records\n", std::to_underlying(table.table), table.count);
+
+    return EXIT_SUCCESS;
+}
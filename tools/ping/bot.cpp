@@ -0,0 +1,230 @@
+#include <jwt-cpp/jwt.h>
+
+#include <numbers>
+
+#include "bot.hpp"
+
+namespace spire::bot {
+std::string_view to_string(const DisconnectReason reason) {
+    switch (reason) {
+    case DisconnectReason::ConnectError: return "connect_error";
+    case DisconnectReason::ServerClosed: return "server_closed";
+    case DisconnectReason::Draining: return "draining";
+    case DisconnectReason::ReceiveError: return "receive_error";
+    case DisconnectReason::SendError: return "send_error";
+    case DisconnectReason::SlowConsumer: return "slow_consumer";
+    case DisconnectReason::InvalidMessage: return "invalid_message";
+    default: return "unknown";
+    }
+}
+
+Bot::Bot(const boost::asio::any_io_executor& executor, const Options& options, Stats& stats, const u64 account_id)
+    : _strand {make_strand(executor)},
+    _options {options},
+    _stats {stats},
+    _account_id {account_id},
+    _random {static_cast<std::minstd_rand::result_type>(account_id)} {}
+
+void Bot::start() {
+    co_spawn(_strand, [self = shared_from_this()] {
+        return self->run();
+    }, boost::asio::detached);
+}
+
+void Bot::stop() {
+    post(_strand, [self = shared_from_this()] {
+        if (!self->_is_running) return;
+
+        self->_is_running = false;
+        --self->_stats.active;
+        self->_connection->close(net::Connection<net::TcpSocket>::CloseCode::Normal);
+    });
+}
+
+boost::asio::awaitable<void> Bot::run() {
+    boost::asio::ip::tcp::resolver resolver {_strand};
+    const auto [resolve_ec, endpoints] = co_await resolver.async_resolve(
+        _options.host, std::to_string(_options.port), boost::asio::as_tuple(boost::asio::use_awaitable));
+    if (resolve_ec) {
+        ++_stats.disconnects[std::to_underlying(DisconnectReason::ConnectError)];
+        co_return;
+    }
+
+    net::TcpSocket socket {_strand};
+    if (const auto [ec, _] = co_await async_connect(
+        socket, endpoints, boost::asio::as_tuple(boost::asio::use_awaitable)); ec) {
+        ++_stats.disconnects[std::to_underlying(DisconnectReason::ConnectError)];
+        co_return;
+    }
+
+    boost::system::error_code ec;
+    socket.set_option(boost::asio::ip::tcp::no_delay(true), ec);
+
+    _connection = std::make_unique<net::Connection<net::TcpSocket>>(std::move(socket));
+    _connection->init(
+        [weak_self = weak_from_this()](const net::Connection<net::TcpSocket>::CloseCode code) {
+            if (const auto self {weak_self.lock()}) self->on_closed(code);
+        },
+        [weak_self = weak_from_this()](std::vector<std::byte>&& data) {
+            if (const auto self {weak_self.lock()}) self->on_received(std::move(data));
+        });
+    _connection->open();
+
+    _is_running = true;
+    ++_stats.connected;
+    ++_stats.active;
+
+    login();
+
+    co_spawn(_strand, repeat(_options.ping_rate, &Bot::ping), boost::asio::detached);
+    co_spawn(_strand, repeat(_options.move_rate, &Bot::move), boost::asio::detached);
+    co_spawn(_strand, repeat(_options.heartbeat_rate, &Bot::heartbeat), boost::asio::detached);
+}
+
+boost::asio::awaitable<void> Bot::repeat(const f64 rate, void (Bot::*action)()) {
+    if (rate <= 0.0) co_return;
+
+    const auto self {shared_from_this()};
+    const auto period {duration_cast<steady_clock::duration>(duration<f64> {1.0 / rate})};
+    boost::asio::steady_timer timer {_strand};
+
+    // Spread the first action over one period so bots do not fire in lockstep
+    timer.expires_after(duration_cast<steady_clock::duration>(
+        period * std::uniform_real_distribution {0.0, 1.0}(_random)));
+
+    while (_is_running) {
+        if (const auto [ec] = co_await timer.async_wait(boost::asio::as_tuple(boost::asio::use_awaitable)); ec) {
+            co_return;
+        }
+        if (!_is_running) co_return;
+
+        (this->*action)();
+        timer.expires_at(timer.expiry() + period);
+    }
+}
+
+void Bot::login() {
+    const auto character_id {_account_id};
+    const auto token {jwt::create()
+        .set_type("JWT")
+        .set_issued_at(system_clock::now())
+        .set_payload_claim("account_id", jwt::claim {std::to_string(_account_id)})
+        .set_payload_claim("character_id", jwt::claim {std::to_string(character_id)})
+        .sign(jwt::algorithm::hs256 {_options.auth_key})};
+
+    auto* login {new msg::Login};
+    login->set_token(token);
+    login->set_account_id(_account_id);
+    login->set_character_id(character_id);
+
+    msg::BaseMessage base {};
+    base.set_allocated_login(login);
+    send(base);
+}
+
+void Bot::ping() {
+    _pending_pings.push_back(steady_clock::now());
+    _stats.pings.add();
+
+    msg::BaseMessage base {};
+    base.set_allocated_ping(new msg::Ping);
+    send(base);
+}
+
+void Bot::move() {
+    std::uniform_real_distribution direction {-1.0f, 1.0f};
+
+    auto* move {new msg::Move};
+    move->set_tick(++_tick);
+    move->set_direction_x(direction(_random));
+    move->set_direction_z(direction(_random));
+    move->set_rotation(direction(_random) * std::numbers::pi_v<f32>);
+    _stats.moves.add();
+
+    msg::BaseMessage base {};
+    base.set_allocated_move(move);
+    send(base);
+}
+
+void Bot::heartbeat() {
+    _stats.heartbeats.add();
+
+    msg::BaseMessage base {};
+    base.set_allocated_heartbeat(new msg::Heartbeat);
+    send(base);
+}
+
+void Bot::send(const msg::BaseMessage& base) {
+    if (!_is_running) return;
+
+    _connection->send(std::make_unique<net::OutMessage>(base));
+}
+
+void Bot::on_received(std::vector<std::byte>&& data) {
+    msg::BaseMessage base {};
+    if (!base.ParseFromArray(data.data(), static_cast<int>(data.size()))) {
+        disconnect(DisconnectReason::InvalidMessage);
+        return;
+    }
+
+    switch (base.message_case()) {
+    case msg::BaseMessage::kPing:
+        // The server answers pings in order, so the oldest pending ping is the one answered
+        if (_pending_pings.empty()) break;
+
+        _stats.rtt.record(steady_clock::now() - _pending_pings.front());
+        _stats.pongs.add();
+        _pending_pings.pop_front();
+        break;
+
+    case msg::BaseMessage::kHeartbeat:
+        heartbeat();
+        break;
+
+    // Sent by a draining server before it closes the connection
+    case msg::BaseMessage::kReconnect:
+        _is_reconnect_requested = true;
+        break;
+
+    default:
+        break;
+    }
+}
+
+void Bot::on_closed(const net::Connection<net::TcpSocket>::CloseCode code) {
+    post(_strand, [self = shared_from_this(), code] {
+        if (!self->_is_running) return;
+
+        switch (code) {
+        // The server closes a drained connection like any other, only the reconnect before tells them apart
+        case net::Connection<net::TcpSocket>::CloseCode::Normal:
+        case net::Connection<net::TcpSocket>::CloseCode::Draining:
+            self->disconnect(
+                self->_is_reconnect_requested ? DisconnectReason::Draining : DisconnectReason::ServerClosed);
+            break;
+
+        case net::Connection<net::TcpSocket>::CloseCode::ReceiveError:
+            self->disconnect(DisconnectReason::ReceiveError);
+            break;
+
+        case net::Connection<net::TcpSocket>::CloseCode::SendError:
+            self->disconnect(DisconnectReason::SendError);
+            break;
+
+        case net::Connection<net::TcpSocket>::CloseCode::SlowConsumer:
+            self->disconnect(DisconnectReason::SlowConsumer);
+            break;
+        }
+    });
+}
+
+void Bot::disconnect(const DisconnectReason reason) {
+    if (!_is_running) return;
+    _is_running = false;
+
+    ++_stats.disconnects[std::to_underlying(reason)];
+    --_stats.active;
+
+    _connection->close(net::Connection<net::TcpSocket>::CloseCode::Normal);
+}
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <spire/core/metrics.hpp>
+#include <spire/net/connection.hpp>
+
+#include <deque>
+#include <random>
+
+namespace spire::bot {
+struct Options {
+    std::string host {"127.0.0.1"};
+    u16 port {0};
+    u32 clients {100};
+    u32 threads {4};
+    // Clients connected per second
+    f64 ramp_rate {500.0};
+    seconds duration {60s};
+    seconds report_interval {5s};
+
+    // Messages per second per client, 0 to disable
+    f64 ping_rate {1.0};
+    f64 move_rate {10.0};
+    f64 heartbeat_rate {0.2};
+
+    std::string auth_key {};
+    u64 first_account_id {1};
+};
+
+enum class DisconnectReason : u8 {
+    ConnectError,
+    ServerClosed,
+    // Closed by a server draining for a restart
+    Draining,
+    ReceiveError,
+    SendError,
+    SlowConsumer,
+    InvalidMessage,
+    Count
+};
+
+std::string_view to_string(DisconnectReason reason);
+
+struct Stats {
+    std::atomic<u64> connected {0};
+    std::atomic<u64> active {0};
+    std::array<std::atomic<u64>, std::to_underlying(DisconnectReason::Count)> disconnects {};
+
+    metrics::Histogram rtt {};
+    metrics::Counter pings {};
+    metrics::Counter pongs {};
+    metrics::Counter moves {};
+    metrics::Counter heartbeats {};
+};
+
+
+// Simulated client driving login, heartbeats, pings and movement over one connection.
+// Everything of a bot runs on its own strand.
+class Bot final : public std::enable_shared_from_this<Bot>, boost::noncopyable {
+public:
+    Bot(const boost::asio::any_io_executor& executor, const Options& options, Stats& stats, u64 account_id);
+
+    void start();
+    void stop();
+
+private:
+    boost::asio::awaitable<void> run();
+    boost::asio::awaitable<void> repeat(f64 rate, void (Bot::*action)());
+
+    void login();
+    void ping();
+    void move();
+    void heartbeat();
+    void send(const msg::BaseMessage& base);
+
+    void on_received(std::vector<std::byte>&& data);
+    void on_closed(net::Connection<net::TcpSocket>::CloseCode code);
+    void disconnect(DisconnectReason reason);
+
+    boost::asio::strand<boost::asio::any_io_executor> _strand;
+    const Options& _options;
+    Stats& _stats;
+    const u64 _account_id;
+
+    std::unique_ptr<net::Connection<net::TcpSocket>> _connection {};
+    bool _is_running {false};
+    // The server asked to reconnect, so its close is a drain
+    bool _is_reconnect_requested {false};
+
+    std::deque<steady_clock::time_point> _pending_pings {};
+    u32 _tick {0};
+    std::minstd_rand _random;
+};
+}
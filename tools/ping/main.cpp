@@ -1,8 +1,36 @@
 #include <spire/net/connection.hpp>
 
+#include <charconv>
+#include <format>
+#include <fstream>
+#include <future>
+#include <iostream>
+
+#include "bot.hpp"
+
 using namespace spire;
 
-bool ping_internal(net::TcpSocket& socket) {
+static void print_usage() {
+    std::cerr << std::format(
+        "Usage: ping <host> <port>\n"
+        "  Sends one ping and exits successfully if the server answers within 5 seconds\n"
+        "Usage: ping --port=<port> [options]\n"
+        "  Simulates clients logging in, moving, pinging and sending heartbeats, reporting RTT and throughput\n"
+        "  --host=<host>              Server host (default 127.0.0.1)\n"
+        "  --port=<port>              Server game port (default $SPIRE_GAME_LISTEN_PORT)\n"
+        "  --clients=<n>              Simulated clients (default 100)\n"
+        "  --threads=<n>              IO threads (default 4)\n"
+        "  --ramp=<n>                 Clients connected per second (default 500)\n"
+        "  --duration=<seconds>       Run time after the ramp-up (default 60)\n"
+        "  --report=<seconds>         Report interval (default 5)\n"
+        "  --ping-rate=<hz>           Pings per second per client (default 1)\n"
+        "  --move-rate=<hz>           Moves per second per client (default 10)\n"
+        "  --heartbeat-rate=<hz>      Heartbeats per second per client (default 0.2)\n"
+        "  --auth-key-file=<path>     JWT signing key (default $SPIRE_AUTH_KEY_FILE)\n"
+        "  --first-account-id=<id>    Account id of the first client (default 1)\n");
+}
+
+static bool ping_internal(net::TcpSocket& socket) {
     boost::system::error_code ec;
 
     // Send Ping
@@ -11,32 +39,32 @@ bool ping_internal(net::TcpSocket& socket) {
         base.set_allocated_ping(new msg::Ping);
         const net::OutMessage message {base};
 
-        boost::asio::write(socket, message.span(), ec);
+        boost::asio::write(socket, boost::asio::buffer(message.span().data(), message.size()), ec);
         if (ec) return false;
     }
 
     // Receive Pong
     {
         std::array<std::byte, sizeof(net::MessageHeader)> header_buffer {};
-        boost::asio::read(socket, std::span {header_buffer}, ec);
+        boost::asio::read(socket, boost::asio::buffer(header_buffer), ec);
         if (ec) return false;
 
         auto [body_size] {net::MessageHeader::deserialize(header_buffer)};
         if (body_size == 0) return false;
 
         std::vector<std::byte> body_buffer(body_size);
-        boost::asio::read(socket, std::span {body_buffer}, ec);
+        boost::asio::read(socket, boost::asio::buffer(body_buffer), ec);
         if (ec) return false;
 
         msg::BaseMessage base {};
-        if (!base.ParseFromArray(body_buffer.data(), body_buffer.size())) return false;
+        if (!base.ParseFromArray(body_buffer.data(), static_cast<int>(body_buffer.size()))) return false;
         if (!base.has_ping()) return false;
     }
 
     return true;
 }
 
-bool ping(const std::string_view host, const u16 port) {
+static bool ping(const std::string_view host, const u16 port) {
     boost::asio::io_context io_ctx {1};
     boost::asio::ip::tcp::resolver resolver {io_ctx};
     net::TcpSocket socket {io_ctx};
@@ -53,11 +81,8 @@ bool ping(const std::string_view host, const u16 port) {
     return result;
 }
 
-int main(const int argc, const char* argv[]) {
-    if (argc != 3) EXIT_FAILURE;
-    const std::string_view host {argv[1]};
-    const u16 port {static_cast<u16>(std::stoi(argv[2]))};
-
+// Single ping as a health check, the blocking socket has no timeout of its own
+static int check(const std::string_view host, const u16 port) {
     std::packaged_task<bool()> task {[&] {
         return ping(host, port);
     }};
@@ -70,4 +95,200 @@ int main(const int argc, const char* argv[]) {
     }
     thread.join();
     return future.get() ? EXIT_SUCCESS : EXIT_FAILURE;
-}
\ No newline at end of file
+}
+
+template <typename T>
+static bool parse_value(const std::string_view text, T& value) {
+    const auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+    return ec == std::errc {} && end == text.data() + text.size();
+}
+
+static std::optional<bot::Options> parse_options(const int argc, const char* argv[]) {
+    bot::Options options {};
+    std::string auth_key_file {std::getenv("SPIRE_AUTH_KEY_FILE") ? std::getenv("SPIRE_AUTH_KEY_FILE") : ""};
+    if (const char* port {std::getenv("SPIRE_GAME_LISTEN_PORT")}) {
+        parse_value(port, options.port);
+    }
+
+    for (int i {1}; i < argc; ++i) {
+        const std::string_view argument {argv[i]};
+        const auto separator {argument.find('=')};
+        if (!argument.starts_with("--") || separator == std::string_view::npos) return std::nullopt;
+
+        const auto key {argument.substr(2, separator - 2)};
+        const auto value {argument.substr(separator + 1)};
+
+        u32 seconds_value {};
+        bool ok {true};
+        if (key == "host") options.host = value;
+        else if (key == "port") ok = parse_value(value, options.port);
+        else if (key == "clients") ok = parse_value(value, options.clients);
+        else if (key == "threads") ok = parse_value(value, options.threads);
+        else if (key == "ramp") ok = parse_value(value, options.ramp_rate);
+        else if (key == "duration") {
+            ok = parse_value(value, seconds_value);
+            options.duration = seconds {seconds_value};
+        }
+        else if (key == "report") {
+            ok = parse_value(value, seconds_value);
+            options.report_interval = seconds {seconds_value};
+        }
+        else if (key == "ping-rate") ok = parse_value(value, options.ping_rate);
+        else if (key == "move-rate") ok = parse_value(value, options.move_rate);
+        else if (key == "heartbeat-rate") ok = parse_value(value, options.heartbeat_rate);
+        else if (key == "auth-key-file") auth_key_file = value;
+        else if (key == "first-account-id") ok = parse_value(value, options.first_account_id);
+        else ok = false;
+
+        if (!ok) return std::nullopt;
+    }
+
+    if (options.port == 0 || options.threads == 0 || options.ramp_rate <= 0.0 || auth_key_file.empty())
+        return std::nullopt;
+
+    std::ifstream file {auth_key_file};
+    if (!std::getline(file, options.auth_key)) return std::nullopt;
+
+    return options;
+}
+
+static void report(
+    const bot::Stats& stats,
+    const metrics::Histogram::Snapshot& rtt,
+    const u64 pings,
+    const u64 moves,
+    const u64 received_frames,
+    const u64 sent_bytes,
+    const u64 received_bytes,
+    const f64 elapsed) {
+    std::cout << std::format(
+        "active {:>6} | out {:>9.1f} msg/s {:>9.1f} KiB/s | in {:>9.1f} msg/s {:>9.1f} KiB/s | "
+        "pings {:>8.1f}/s moves {:>8.1f}/s | rtt p50 {:.3f}ms p90 {:.3f}ms p99 {:.3f}ms p99.9 {:.3f}ms max {:.3f}ms\n",
+        stats.active.load(),
+        static_cast<f64>(pings + moves) / elapsed,
+        static_cast<f64>(sent_bytes) / 1024.0 / elapsed,
+        static_cast<f64>(received_frames) / elapsed,
+        static_cast<f64>(received_bytes) / 1024.0 / elapsed,
+        static_cast<f64>(pings) / elapsed,
+        static_cast<f64>(moves) / elapsed,
+        static_cast<f64>(rtt.quantile(0.5)) / 1e6,
+        static_cast<f64>(rtt.quantile(0.9)) / 1e6,
+        static_cast<f64>(rtt.quantile(0.99)) / 1e6,
+        static_cast<f64>(rtt.quantile(0.999)) / 1e6,
+        static_cast<f64>(rtt.quantile(1.0)) / 1e6);
+}
+
+// Difference of two cumulative histogram snapshots
+static metrics::Histogram::Snapshot since(
+    const metrics::Histogram::Snapshot& current,
+    const metrics::Histogram::Snapshot& previous) {
+    metrics::Histogram::Snapshot snapshot {current};
+    for (size_t i {0}; i < snapshot.buckets.size(); ++i)
+        snapshot.buckets[i] -= previous.buckets[i];
+
+    snapshot.count -= previous.count;
+    snapshot.sum -= previous.sum;
+    return snapshot;
+}
+
+int main(const int argc, const char* argv[]) {
+    if (argc == 3 && !std::string_view {argv[1]}.starts_with("--")) {
+        u16 port {};
+        if (!parse_value(std::string_view {argv[2]}, port)) {
+            print_usage();
+            return EXIT_FAILURE;
+        }
+
+        return check(argv[1], port);
+    }
+
+    const auto options {parse_options(argc, argv)};
+    if (!options) {
+        print_usage();
+        return EXIT_FAILURE;
+    }
+
+    boost::asio::thread_pool threads {options->threads};
+    bot::Stats stats {};
+    std::vector<std::shared_ptr<bot::Bot>> bots;
+    bots.reserve(options->clients);
+
+    const auto start_time {steady_clock::now()};
+    const auto ramp_period {duration_cast<steady_clock::duration>(duration<f64> {1.0 / options->ramp_rate})};
+    const auto end_time {start_time + ramp_period * options->clients + options->duration};
+
+    auto& connection_metrics {net::connection_metrics()};
+    auto last_report_time {start_time};
+    auto last_rtt {stats.rtt.snapshot()};
+    u64 last_pings {0}, last_moves {0}, last_received_frames {0}, last_sent_bytes {0}, last_received_bytes {0};
+
+    auto next_bot_time {start_time};
+    while (steady_clock::now() < end_time) {
+        const auto now {steady_clock::now()};
+
+        while (bots.size() < options->clients && next_bot_time <= now) {
+            const auto& bot {bots.emplace_back(std::make_shared<bot::Bot>(
+                threads.get_executor(), *options, stats, options->first_account_id + bots.size()))};
+            bot->start();
+            next_bot_time += ramp_period;
+        }
+
+        if (now - last_report_time >= options->report_interval) {
+            const auto rtt {stats.rtt.snapshot()};
+            const auto pings {stats.pings.value()};
+            const auto moves {stats.moves.value()};
+            const auto received_frames {connection_metrics.received_frames.value()};
+            const auto sent_bytes {connection_metrics.sent_bytes.value()};
+            const auto received_bytes {connection_metrics.received_bytes.value()};
+
+            report(stats,
+                since(rtt, last_rtt),
+                pings - last_pings,
+                moves - last_moves,
+                received_frames - last_received_frames,
+                sent_bytes - last_sent_bytes,
+                received_bytes - last_received_bytes,
+                duration<f64> {now - last_report_time}.count());
+
+            last_report_time = now;
+            last_rtt = rtt;
+            last_pings = pings;
+            last_moves = moves;
+            last_received_frames = received_frames;
+            last_sent_bytes = sent_bytes;
+            last_received_bytes = received_bytes;
+        }
+
+        std::this_thread::sleep_until(std::min({
+            end_time,
+            last_report_time + options->report_interval,
+            bots.size() < options->clients ? next_bot_time : end_time}));
+    }
+
+    for (const auto& bot : bots)
+        bot->stop();
+
+    threads.stop();
+    threads.join();
+
+    const duration<f64> elapsed {steady_clock::now() - start_time};
+    std::cout << std::format("\nTotal over {:.1f}s\n", elapsed.count());
+    report(stats,
+        stats.rtt.snapshot(),
+        stats.pings.value(),
+        stats.moves.value(),
+        connection_metrics.received_frames.value(),
+        connection_metrics.sent_bytes.value(),
+        connection_metrics.received_bytes.value(),
+        elapsed.count());
+
+    std::cout << std::format("connected {} of {}, pongs {} of {} pings, heartbeats {}\n",
+        stats.connected.load(), options->clients, stats.pongs.value(), stats.pings.value(), stats.heartbeats.value());
+    for (size_t i {0}; i < stats.disconnects.size(); ++i) {
+        if (const auto count {stats.disconnects[i].load()}; count != 0) {
+            std::cout << std::format("disconnect {}: {}\n", to_string(static_cast<bot::DisconnectReason>(i)), count);
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
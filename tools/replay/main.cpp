@@ -0,0 +1,157 @@
+#include <spire/core/clock.hpp>
+#include <spire/core/settings.hpp>
+#include <spire/server/replay.hpp>
+#include <spire/server/room.hpp>
+
+#include <algorithm>
+#include <charconv>
+#include <filesystem>
+#include <format>
+#include <iostream>
+#include <optional>
+#include <ranges>
+#include <unordered_map>
+#include <vector>
+
+using namespace spire;
+
+struct Options {
+    std::filesystem::path log {};
+    u32 repeat {1};
+};
+
+struct Stats {
+    u64 ticks {0};
+    u64 messages {0};
+    // Between the first and the last update of the log
+    nanoseconds recorded {};
+    nanoseconds total {};
+    nanoseconds max_tick {};
+};
+
+static void print_usage() {
+    std::cerr << std::format(
+        "Usage: replay --log=<file> [options]\n"
+        "  --log=<file>               Replay log of a room, recorded into `replay_directory` of settings.yaml\n"
+        "  --repeat=<n>               Passes over the log, each with a new room (default 1)\n");
+}
+
+static std::optional<Options> parse_options(const int argc, const char* argv[]) {
+    Options options {};
+
+    for (int i {1}; i < argc; ++i) {
+        const std::string_view argument {argv[i]};
+        const auto separator {argument.find('=')};
+        if (!argument.starts_with("--") || separator == std::string_view::npos) return std::nullopt;
+
+        const auto key {argument.substr(2, separator - 2)};
+        const auto value {argument.substr(separator + 1)};
+
+        bool ok {true};
+        if (key == "log") options.log = value;
+        else if (key == "repeat") {
+            const auto [end, ec] = std::from_chars(value.data(), value.data() + value.size(), options.repeat);
+            ok = ec == std::errc {} && end == value.data() + value.size();
+        }
+        else ok = false;
+
+        if (!ok) return std::nullopt;
+    }
+
+    if (options.log.empty() || options.repeat == 0) return std::nullopt;
+
+    return options;
+}
+
+// Runs every update of the log back to back under virtual time, as fast as the room goes. The room is the base
+// `Room`, rooms of a game replay their own handlers and systems once constructed here instead.
+static Stats replay(ReplayReader& reader) {
+    boost::asio::io_context io_context {1};
+    boost::asio::any_io_executor executor {io_context.get_executor()};
+    const auto room {std::make_shared<LoopbackRoom>(reader.room_id(), reader.room_name(), executor)};
+    room->seed_random(reader.random_seed());
+    // Logs are recorded by district rooms, which simulate the characters of their clients
+    room->simulate_characters(Speed {Settings::character_speed()});
+
+    // Never started, so whatever the room sends them is dropped
+    std::unordered_map<u64, std::shared_ptr<net::LoopbackClient>> clients;
+    std::vector<net::LoopbackStream> remotes;
+    const auto client_of = [&](const u64 client_id) {
+        auto& client {clients[client_id]};
+        if (!client) {
+            auto [stream, remote] {net::LoopbackStream::make_pair(executor)};
+            client = net::LoopbackClient::make(std::move(stream));
+            remotes.push_back(std::move(remote));
+        }
+        return client;
+    };
+
+    Stats stats {};
+    ReplayTick tick {};
+    std::optional<time_point<steady_clock>> first_time {};
+    while (reader.next(tick)) {
+        if (!first_time) {
+            first_time = tick.now;
+            Clock::use_virtual_time(tick.now);
+        }
+        Clock::advance(tick.now - Clock::now());
+
+        const auto start {steady_clock::now()};
+        room->replay(tick, client_of);
+        const nanoseconds elapsed {steady_clock::now() - start};
+
+        ++stats.ticks;
+        stats.messages += std::ranges::count(tick.events, ReplayRecord::Message, &ReplayEvent::kind);
+        stats.recorded = tick.now - *first_time;
+        stats.total += elapsed;
+        stats.max_tick = std::max(stats.max_tick, elapsed);
+    }
+
+    // Stopped while the room can still be told, a client cannot stop itself once it is being destroyed
+    for (const auto& client : clients | std::views::values)
+        client->stop(net::LoopbackClient::StopCode::Normal);
+    room->terminate();
+    Clock::use_real_time();
+
+    return stats;
+}
+
+int main(const int argc, const char* argv[]) {
+    const auto options {parse_options(argc, argv)};
+    if (!options) {
+        print_usage();
+        return EXIT_FAILURE;
+    }
+
+    for (u32 pass {0}; pass < options->repeat; ++pass) {
+        auto reader {ReplayReader::open(options->log)};
+        if (!reader) {
+            std::cerr << std::format("{} is not a replay log\n", options->log.string());
+            return EXIT_FAILURE;
+        }
+
+        const auto stats {replay(*reader)};
+        if (stats.ticks == 0) {
+            std::cerr << std::format("{} holds no complete update\n", options->log.string());
+            return EXIT_FAILURE;
+        }
+
+        const duration<f64, std::milli> total {stats.total};
+        const duration<f64, std::milli> recorded {stats.recorded};
+        std::cout << std::format(
+            "{} {} | {} updates {} messages | {:.1f}ms for {:.1f}ms recorded ({:.1f}x) | "
+            "{:.0f} updates/s | tick mean {:.3f}ms max {:.3f}ms\n",
+            reader->room_name(),
+            reader->room_id(),
+            stats.ticks,
+            stats.messages,
+            total.count(),
+            recorded.count(),
+            recorded / total,
+            static_cast<f64>(stats.ticks) / duration<f64> {stats.total}.count(),
+            total.count() / static_cast<f64>(stats.ticks),
+            duration<f64, std::milli> {stats.max_tick}.count());
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,103 @@
+#include <spire/core/types.hpp>
+#include <zdict.h>
+
+#include <charconv>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <optional>
+#include <vector>
+
+using namespace spire;
+
+struct Options {
+    std::filesystem::path samples {};
+    std::filesystem::path output {};
+    size_t size {64 * 1024};
+};
+
+static void print_usage() {
+    std::cerr << std::format(
+        "Usage: train_dictionary --samples=<directory> --output=<file> [options]\n"
+        "  --samples=<directory>      Serialized message bodies, one per file\n"
+        "  --output=<file>            Dictionary to write, set as `compression_dictionary` in settings.yaml\n"
+        "  --size=<bytes>             Maximum dictionary size (default 65536)\n");
+}
+
+static std::optional<Options> parse_options(const int argc, const char* argv[]) {
+    Options options {};
+
+    for (int i {1}; i < argc; ++i) {
+        const std::string_view argument {argv[i]};
+        const auto separator {argument.find('=')};
+        if (!argument.starts_with("--") || separator == std::string_view::npos) return std::nullopt;
+
+        const auto key {argument.substr(2, separator - 2)};
+        const auto value {argument.substr(separator + 1)};
+
+        bool ok {true};
+        if (key == "samples") options.samples = value;
+        else if (key == "output") options.output = value;
+        else if (key == "size") {
+            const auto [end, ec] = std::from_chars(value.data(), value.data() + value.size(), options.size);
+            ok = ec == std::errc {} && end == value.data() + value.size();
+        }
+        else ok = false;
+
+        if (!ok) return std::nullopt;
+    }
+
+    if (options.samples.empty() || options.output.empty() || options.size == 0) return std::nullopt;
+
+    return options;
+}
+
+int main(const int argc, const char* argv[]) {
+    const auto options {parse_options(argc, argv)};
+    if (!options) {
+        print_usage();
+        return EXIT_FAILURE;
+    }
+
+    // zstd expects every sample concatenated into one buffer
+    std::vector<char> samples;
+    std::vector<size_t> sample_sizes;
+    for (const auto& entry : std::filesystem::directory_iterator {options->samples}) {
+        if (!entry.is_regular_file()) continue;
+
+        std::ifstream file {entry.path(), std::ios::binary};
+        const auto offset {samples.size()};
+        samples.insert(samples.end(), std::istreambuf_iterator<char> {file}, std::istreambuf_iterator<char> {});
+        if (samples.size() != offset) {
+            sample_sizes.push_back(samples.size() - offset);
+        }
+    }
+
+    if (sample_sizes.empty()) {
+        std::cerr << std::format("No samples found in {}\n", options->samples.string());
+        return EXIT_FAILURE;
+    }
+
+    std::vector<char> dictionary(options->size);
+    const size_t size {ZDICT_trainFromBuffer(
+        dictionary.data(), dictionary.size(),
+        samples.data(), sample_sizes.data(), static_cast<unsigned>(sample_sizes.size()))};
+    if (ZDICT_isError(size)) {
+        std::cerr << std::format("Training failed: {}\n", ZDICT_getErrorName(size));
+        return EXIT_FAILURE;
+    }
+
+    std::ofstream file {options->output, std::ios::binary};
+    file.write(dictionary.data(), static_cast<std::streamsize>(size));
+    if (!file) {
+        std::cerr << std::format("Could not write {}\n", options->output.string());
+        return EXIT_FAILURE;
+    }
+
+    std::cout << std::format(
+        "Trained a {} byte dictionary from {} samples ({} bytes)\n", size, sample_sizes.size(), samples.size());
+
+    return EXIT_SUCCESS;
+}